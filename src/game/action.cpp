@@ -21,3 +21,12 @@ bool Action::update(float dt)
 {
     return false;
 }
+
+/**
+ * Set m to the move that the action makes in the rules of the game, and
+ * return true. Only the players' actions are moves, so this returns false.
+ */
+bool Action::getMove(Move &m) const
+{
+    return false;
+}
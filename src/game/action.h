@@ -8,9 +8,12 @@
 #ifndef ACTION_H
 #define ACTION_H
 
+struct Move;
+
 /**
  * The Action classes perform actions like moving a player from one cell to
- * another at the request of the user.
+ * another at the request of the user. A few actions are created every turn,
+ * so the concrete action classes are allocated from pools (see pool.h).
  */
 class Action {
 public:
@@ -24,6 +27,13 @@ public:
      * Update the game state. False is returned if the action is complete.
      */
     virtual bool update(float dt);
+
+    /**
+     * Set m to the move that the action makes in the rules of the game,
+     * and return true. False is returned if the action is not a move, as
+     * for the actions of items.
+     */
+    virtual bool getMove(Move &m) const;
 };
 
 #endif //ACTION_H
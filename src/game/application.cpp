@@ -7,6 +7,8 @@
 
 #include "application.h"
 #include "keyevent.h"
+#include "renderstate.h"
+#include "levelofdetail.h"
 
 #include "SDL/SDL.h"
 #include <GL/gl.h>
@@ -14,31 +16,6 @@
 #include <string>
 #include <iostream>
 
-/**
- * Default constructor for the application error class. Takes a string
- * error message as a parameter.
- */
-app_error::app_error(std::string err)
-{
-    msg = err;
-}
-
-/**
- * Destructor.
- */
-app_error::~app_error() throw()
-{
-    //nothing to destruct
-}
-
-/**
- * Returns the value of the error message.
- */
-std::string app_error::what()
-{
-    return msg;
-}
-
 /**
  * Default constructor. Initialises variables to default values.
  */
@@ -49,6 +26,7 @@ Application::Application()
     w = 800;
     h = 600;
     root = NULL;
+    scaler.setScreenSize(w, h);
 }
 
 /**
@@ -90,6 +68,7 @@ void Application::run() throw(app_error)
 
         // update dt with the time spent on the last frame
         float dt = (SDL_GetTicks() - now) / 1000.0;
+        scaler.update(dt);
 
         // if dt < DT, we must delay before starting the next frame
         if (dt < DT) {
@@ -120,6 +99,16 @@ void Application::setFPSLimit(float fps)
     maxfps = fps;
 }
 
+/**
+ * Set the time in seconds that a frame should take. If frames take longer,
+ * the maze is rendered at a lower resolution and stretched over the
+ * screen. If it is 0 (the default), the resolution is not scaled.
+ */
+void Application::setTargetFrameTime(float t)
+{
+    scaler.setTargetFrameTime(t);
+}
+
 /**
  * Set the root window. This will be the first window rendered and
  * the first to receive events. NULL may be passed. If the window is
@@ -204,8 +193,11 @@ void Application::dispatchButtonEvent(SDL_Event event)
  */
 void Application::step(float t, float dt) throw(app_error)
 {
-    // flush the event queue
-    SDL_Event event;
+    // flush the event queue. The mouse motion events are combined into
+    // one, with the latest position and button state, which is dispatched
+    // before the next button event or at the end.
+    SDL_Event event, motion;
+    bool moved = false;
     while(SDL_PollEvent(&event)) {  //see if there are any SDL events
         switch(event.type) {
         case SDL_QUIT:
@@ -216,14 +208,34 @@ void Application::step(float t, float dt) throw(app_error)
             dispatchKeyEvent(event);
             break;
         case SDL_MOUSEMOTION:
-            dispatchMouseEvent(event);  //the mouse moved
+            //the mouse moved
+            if (moved) {
+                motion.motion.state = event.motion.state;
+                motion.motion.x = event.motion.x;
+                motion.motion.y = event.motion.y;
+                motion.motion.xrel += event.motion.xrel;
+                motion.motion.yrel += event.motion.yrel;
+            } else {
+                motion = event;
+                moved = true;
+            }
             break;
         case SDL_MOUSEBUTTONDOWN:
         case SDL_MOUSEBUTTONUP:
+            if (moved) {
+                dispatchMouseEvent(motion);
+                moved = false;
+            }
             dispatchButtonEvent(event);   //a mouse button was pressed
             break;
         }
     }
+    if (moved) {
+        dispatchMouseEvent(motion);
+    }
+
+    RenderState::getInstance().startFrame();
+    LevelOfDetail::getInstance().startFrame();
 
     //clear the color and depth buffer
     glClearColor(0.32, 0.65, 0.89, 0.0);
@@ -235,7 +247,11 @@ void Application::step(float t, float dt) throw(app_error)
 
     // render the root window
     if (root) {
+        // the maze may be rendered at a lower resolution, but the user
+        // interface is always at full resolution
+        scaler.begin();
         root->render(RENDER_PASS_1, dt);
+        scaler.end();
         root->render(RENDER_PASS_2, dt);
     }
 
@@ -290,9 +306,9 @@ void Application::startup() throw(app_error)
     glLightfv(GL_LIGHT0, GL_AMBIENT, ambientLight);
     float lightcol[] = {0.0, 0.0, 0.0, 1.0};
     glLightfv(GL_LIGHT0, GL_DIFFUSE, lightcol);
-    glEnable(GL_LIGHT0);
+    RenderState::getInstance().enable(GL_LIGHT0);
 
-    glEnable(GL_COLOR_MATERIAL);
+    RenderState::getInstance().enable(GL_COLOR_MATERIAL);
     glColorMaterial(GL_FRONT, GL_AMBIENT_AND_DIFFUSE);
 
     glHint(GL_PERSPECTIVE_CORRECTION_HINT, GL_NICEST);
@@ -302,5 +318,6 @@ void Application::startup() throw(app_error)
  */
 void Application::shutdown()
 {
+    scaler.release();
     SDL_Quit();
 }
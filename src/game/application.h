@@ -11,40 +11,14 @@
 #define APPLICATION_H
 
 #include "window.h"
+#include "resolutionscaler.h"
+#include "apperror.h"
 
 #include <stdexcept>
 #include <string>
 
 #include "SDL/SDL.h"
 
-/**
- * A fatal error has occured in the application.
- */
-class app_error : public std::exception
-{
-public:
-    /**
-     * Constructor. The error message will be printed to stderr.
-     */
-    app_error(std::string err);
-
-    /**
-     * Destructor.
-     */
-    virtual ~app_error() throw();
-
-    /**
-     * Returns the error message.
-     */
-    virtual std::string what();
-
-private:
-    /**
-     * The error message.
-     */
-    std::string msg;
-};
-
 /**
  * The Application is in charge of initializing the libraries and setting up
  * windows. It receives events from the windowing system and sends them to the
@@ -82,6 +56,14 @@ public:
      */
     void setFPSLimit(float fps);
 
+    /**
+     * Set the time in seconds that a frame should take. If frames take
+     * longer, the maze is rendered at a lower resolution and stretched
+     * over the screen. If it is 0 (the default), the resolution is not
+     * scaled.
+     */
+    void setTargetFrameTime(float t);
+
     /**
      * Set the root window. This will be the first window rendered and
      * the first to receive events. NULL may be passed. If the window is
@@ -123,6 +105,11 @@ private:
      */
     Window *root;
 
+    /**
+     * Scales the resolution of the first render pass.
+     */
+    ResolutionScaler scaler;
+
     /**
      * Initialize all libraries.
      */
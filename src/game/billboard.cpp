@@ -6,6 +6,7 @@
  ************************************************************************/
 
 #include "billboard.h"
+#include "renderstate.h"
 
 #include <GL/gl.h>
 
@@ -54,17 +55,18 @@ void BillBoard::render(float dt)
     up = up * h;
     right = right * h * tex->getAspectRatio();
 
-    glEnable(GL_TEXTURE_2D);
-    glDisable(GL_LIGHTING);
+    RenderState &state = RenderState::getInstance();
+    state.enable(GL_TEXTURE_2D);
+    state.disable(GL_LIGHTING);
 
     //Bind the texture
     tex->bind();
 
     //this will only draw visible pixels
-    glEnable(GL_ALPHA_TEST);
-    glAlphaFunc(GL_GREATER, 0);
+    state.enable(GL_ALPHA_TEST);
+    state.alphaFunc(GL_GREATER, 0);
 
-    glColor4f(1,1,1,1);
+    state.color(1,1,1,1);
 
     //Draw particles
     glBegin(GL_POLYGON);
@@ -91,9 +93,9 @@ void BillBoard::render(float dt)
     glEnd();
 
     //return everything to the way it was
-    glEnable(GL_LIGHTING);
-    glDisable(GL_TEXTURE_2D);
-    glDisable(GL_ALPHA_TEST);
+    state.enable(GL_LIGHTING);
+    state.disable(GL_TEXTURE_2D);
+    state.disable(GL_ALPHA_TEST);
 
     glPopMatrix();
 }
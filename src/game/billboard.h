@@ -10,8 +10,9 @@
 
 #include "entity.h"
 #include "texture.h"
+#include "pool.h"
 
-class BillBoard : public Entity
+class BillBoard : public Entity, public Pooled<BillBoard>
 {
 public:
     /**
@@ -6,8 +6,7 @@
  ************************************************************************/
 
 #include "button.h"
-
-#include <GL/gl.h>
+#include "uibatch.h"
 
 #include <iostream>
 
@@ -99,34 +98,16 @@ bool Button::getEnabled()
 void Button::draw(float dt)
 {
     //only draw it if it is enabled
+    float c;
     if (!getEnabled()) {
-        glColor3f(0, 0, 0);
+        c = 0;
     } else if (getToggle() || isInside(getMousePosition())) {
-        glColor3f(0.5, 0.5, 0.5);
+        c = 0.5;
     } else {
-        glColor3f(1, 1, 1);
-    }
-
-    //enable texturing
-    glEnable(GL_TEXTURE_2D);
-    if (tex) {
-        tex->bind();
-        glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+        c = 1;
     }
 
-    //enable blending
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    //draw the vertices
-    glBegin(GL_QUADS);
-    glTexCoord2f(0, 1); glVertex2f(0, 0);
-    glTexCoord2f(1, 1); glVertex2f(getSize().x, 0);
-    glTexCoord2f(1, 0); glVertex2f(getSize().x, getSize().y);
-    glTexCoord2f(0, 0); glVertex2f(0, getSize().y);
-    glEnd();
-
-    glDisable(GL_BLEND);
+    UIBatch::getInstance().addQuad(tex, vector4(0, 0), getSize(), c, c, c);
 }
 
 /**
@@ -96,17 +96,28 @@ void Camera::set_focus (vector4 value)
     focus = value;
 }
 /**
- * Position the camera
+ * Get the camera's position, from its focus and its angles and distance
+ * to the focus.
  */
-void Camera::positionCamera() 
-{   
-    //calculate the camera's position
+vector4 Camera::getPosition()
+{
     vector4 pos = focus;
 
     pos.y += r*sin(theta);
     pos.x += r*cos(theta)*sin(phi);
     pos.z += r*cos(theta)*cos(phi);
 
+    return pos;
+}
+
+/**
+ * Position the camera
+ */
+void Camera::positionCamera() 
+{   
+    //calculate the camera's position
+    vector4 pos = getPosition();
+
     gluLookAt(pos.x, pos.y, pos.z,
               focus.x, focus.y, focus.z,
               0.0, 1.0, 0.0);
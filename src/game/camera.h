@@ -103,6 +103,12 @@ public:
     void MoveUp();
     void MoveDown();
 
+    /**
+     * Get the camera's position, from its focus and its angles and distance
+     * to the focus.
+     */
+    vector4 getPosition();
+
     /**
      * Position the camera
      */
@@ -6,6 +6,8 @@
  ************************************************************************/
 
 #include "cell.h"
+#include "cellset.h"
+#include "terrain.h"
 #include "vector4.h"
 #include "entity.h"
 
@@ -15,8 +17,6 @@
 #include <vector>
 #include <iostream>
 
-#define MAX_WALL_HEIGHT 3  //the maximum wall height
-
 /**
  * Constructor. Initialises the possible states of the cell.
  */
@@ -26,22 +26,24 @@ Cell::Cell()
     color[1] = 1;
     color[2] = 1;
     isWall = false;
-    selectable = false;
-    highlighted = false;
+    selectableSet = NULL;
+    highlightedSet = NULL;
+    zobrist = NULL;
     visible = true;
     bHasPlayer = false;
     tex = NULL;
+    terrain = NULL;
+    chunk = -1;
     wallHeight = 0;
     calcMesh();
 }
 
 /**
- * Destructor of the cell. Deletes the main mesh object and the mesh object
- * storing the cell's outline. All the entities the cell has are also deleted.
+ * Destructor of the cell. Deletes the mesh object storing the cell's
+ * outline. All the entities the cell has are also deleted.
  */
 Cell::~Cell()
 {
-    delete mesh;
     delete outlineMesh;
 
     //free entities
@@ -52,117 +54,37 @@ Cell::~Cell()
 }
 
 /**
- * Calculates and stores in a mesh object the geometry of the cell. This is for
- * rendering and collision detection.
+ * Calculates and stores in a mesh object the outline of the cell. This is
+ * for collision detection. The cell itself is drawn by the Terrain.
  */
 void Cell::calcMesh()
 {
-    // Don't even bother trying to work out what's going on here. Just be
-    // reassured that it works. If there's a bug, you'll be better off
-    // rewriting the function.
-
     outlineMesh = new Mesh(6);
     for(int i = 0; i < 6; i++)
     {
         (*outlineMesh)(5-i) = vector4(cos(i*M_PI/3.0), 0, sin(i*M_PI/3.0));
         outlineMesh->setNormal(5-i, vector4(0, 1, 0));
     }
-
-    mesh = new Mesh(48);
-    int around = 1;
-    for(int i = 0; i < 12; i++)
-    {
-        int vertex = 0;
-        if(i%3 == 1)
-            vertex = around++;
-        else if(i%3 == 2)
-            vertex = around;
-        (*mesh)(11-i) = vector4(cos(vertex*M_PI/3.0), 0, sin(vertex*M_PI/3.0));
-        mesh->setNormal(11-i, vector4(0, 1, 0));
-    }
-
-    for(int i = 0; i < 6; i++)
-    {
-        (*mesh)(12+6*i) = vector4(cos(i*M_PI/3.0), 0, sin(i*M_PI/3.0));
-        (*mesh)(12+6*i+2) = vector4(cos(i*M_PI/3.0), -5, sin(i*M_PI/3.0));
-        (*mesh)(12+6*i+1) = vector4(cos((i+1)*M_PI/3.0), 0, sin((i+1)*M_PI/3.0));
-
-        (*mesh)(12+6*i+3) = vector4(cos(i*M_PI/3.0), -5, sin(i*M_PI/3.0));
-        (*mesh)(12+6*i+4) = vector4(cos((i+1)*M_PI/3.0), 0, sin((i+1)*M_PI/3.0));
-        (*mesh)(12+6*i+5) = vector4(cos((i+1)*M_PI/3.0), -5, sin((i+1)*M_PI/3.0));
-
-        mesh->setNormal(12+6*i, (*mesh)(12+6*i));
-        mesh->setNormal(12+6*i+1, (*mesh)(12+6*i+4));
-        mesh->setNormal(12+6*i+2, (*mesh)(12+6*i));
-        mesh->setNormal(12+6*i+3, (*mesh)(12+6*i));
-        mesh->setNormal(12+6*i+4, (*mesh)(12+6*i+4));
-        mesh->setNormal(12+6*i+5, (*mesh)(12+6*i+4));
-    }
-
-    for (int i=0; i<48; i++) {
-        vector4 p = (*mesh)(i);
-        mesh->setTexCoord(i, vector4(p.x, p.z));
-    }
-
-    mesh->makeDisplayList(GL_TRIANGLES);
 }
 
 /**
- * Renders the cell. float dt is the change in time during
- * the last frame and is used for animation. All the entities
- * on the cell are also rendered.
+ * Renders the entities on the cell. float dt is the change in time during
+ * the last frame and is used for animation. The cell itself is drawn by the
+ * Terrain.
  */
 void Cell::render(float dt)
 {
-    if (!isVisible())
+    if (!isVisible() || entities.empty())
     {
         return;
     }
 
-    if (isSelectable())
-    {
-        if (isHighlighted())
-        {
-            setColor(0, 1, 0);
-        } else
-        {
-            setColor(0, 0.5, 0);
-        }
-    }
-    else
-    {
-        if (isHighlighted())
-        {
-            setColor(0.5, 0, 0);
-        }
-        else
-        {
-            setColor(1, 1, 1);
-        }
-    }
-
     glPushMatrix();
     vector4 p = position;
     glTranslated(p.x, p.y, p.z);
 
-    glPushMatrix();
-    glTranslatef(0,0.005,0);
-    glColor3d(0,0,0);
-    outlineMesh->render(GL_LINE_LOOP);
-    glPopMatrix();
-
-    glColor3d(color[0], color[1], color[2]);
-    if (tex) {
-        glEnable(GL_TEXTURE_2D);
-        tex->bind();
-    }
-    mesh->render(GL_TRIANGLES);
-    if (tex) {
-        glDisable(GL_TEXTURE_2D);
-    }
-
     //render all the entities on the cell
-    for (std::list<Entity*>::iterator i=entities.begin();
+    for (EntityList::iterator i=entities.begin();
          i != entities.end(); i++)
     {
         (*i)->render(dt);
@@ -217,20 +139,55 @@ vector4 Cell::getPosition()
     return position;
 }
 
+/**
+ * Set the sets that hold the selectable and highlighted cells of the maze.
+ */
+void Cell::setSelectionSets(CellSet *selectable, CellSet *highlighted)
+{
+    selectableSet = selectable;
+    highlightedSet = highlighted;
+}
+
+/**
+ * Set the hash of the maze's state, which the cell and the entities on it
+ * keep up to date. This is called by Maze::load().
+ */
+void Cell::setZobrist(Zobrist *zobrist)
+{
+    this->zobrist = zobrist;
+}
+
+/**
+ * Returns the hash of the maze's state, or NULL if the cell is not in a
+ * maze.
+ */
+Zobrist *Cell::getZobrist()
+{
+    return zobrist;
+}
+
 /**
  * Returns the selectable state of the cell.
  */
 bool Cell::isSelectable()
 {
-    return selectable;
+    return selectableSet && selectableSet->contains(this);
 }
 
 /**
- * Sets the selectable state of the cell.
+ * Sets the selectable state of the cell. The set updates the colour.
  */
 void Cell::setSelectable(bool sel)
 {
-    selectable = sel;
+    if (!selectableSet) {
+        return;
+    }
+
+    if (sel) {
+        selectableSet->add(this);
+    } else {
+        selectableSet->remove(this);
+    }
 }
 
 /**
@@ -238,15 +195,23 @@ void Cell::setSelectable(bool sel)
  */
 bool Cell::isHighlighted()
 {
-    return highlighted;
+    return highlightedSet && highlightedSet->contains(this);
 }
 
 /**
- * Sets the highlighted state of the cell.
+ * Sets the highlighted state of the cell. The set updates the colour.
  */
 void Cell::setHighlighted(bool hl)
 {
-    highlighted = hl;
+    if (!highlightedSet) {
+        return;
+    }
+
+    if (hl) {
+        highlightedSet->add(this);
+    } else {
+        highlightedSet->remove(this);
+    }
 }
 
 /**
@@ -300,19 +265,23 @@ void Cell::setHasPlayer(bool b)
 }
 
 /**
- * Sets whether this cell has a wall or not.
+ * Sets whether this cell has a wall or not. A new wall is given a random
+ * height taken from random.
  */
-void Cell::setWall(bool w)
+void Cell::setWall(bool w, Random &random)
 {
     if(w == isWall)
 	return; //nothing to do
 
+    int old = getWallHeight();
     if(w)
-	wallHeight = rand()%MAX_WALL_HEIGHT+1;
+	wallHeight = random.nextInt(MAX_WALL_HEIGHT)+1;
 
     position.y += w ? wallHeight : -wallHeight;
 
     isWall = w;
+    wallChanged(old);
+    heightChanged();
 }
 
 /**
@@ -321,10 +290,37 @@ void Cell::setWall(bool w)
  */
 void Cell::hitWall()
 {
+    int old = getWallHeight();
     wallHeight--;
     position.y -= 1;
     if(wallHeight == 0)
 	isWall = false;
+    wallChanged(old);
+    heightChanged();
+}
+
+/**
+ * Returns the height of the wall on this cell, or 0 if there is no wall.
+ */
+int Cell::getWallHeight()
+{
+    return isWall ? wallHeight : 0;
+}
+
+/**
+ * Sets the height of the wall on this cell. A height of 0 removes the wall.
+ */
+void Cell::setWallHeight(int h)
+{
+    if(h == getWallHeight())
+	return; //nothing to do
+
+    int old = getWallHeight();
+    position.y += h - old;
+    wallHeight = h;
+    isWall = h > 0;
+    wallChanged(old);
+    heightChanged();
 }
 
 /**
@@ -341,12 +337,161 @@ bool Cell::getWall()
 void Cell::setTexture(Texture *tex)
 {
     this->tex = tex;
+    heightChanged();
+}
+
+/**
+ * Returns the texture of the cell. This may be NULL.
+ */
+Texture *Cell::getTexture()
+{
+    return tex;
+}
+
+/**
+ * Set the terrain that draws the cell and the chunk that the cell belongs
+ * to.
+ */
+void Cell::setTerrain(Terrain *terrain, int chunk)
+{
+    this->terrain = terrain;
+    this->chunk = chunk;
+}
+
+/**
+ * Returns the chunk of the terrain that the cell belongs to, or -1 if the
+ * cell is not drawn.
+ */
+int Cell::getChunk()
+{
+    return chunk;
+}
+
+/**
+ * Sets the color of the cell.
+ */
+void Cell::setColor(double r, double g, double b)
+{
+    if ((color[0] == r) && (color[1] == g) && (color[2] == b)) {
+        return;
+    }
+
+    color[0] = r;
+    color[1] = g;
+    color[2] = b;
+
+    if (terrain) {
+        terrain->markColorDirty(chunk);
+    }
+}
+
+/**
+ * Returns the colour of the cell in the x, y and z components.
+ */
+vector4 Cell::getColor()
+{
+    return vector4(color[0], color[1], color[2]);
+}
+
+/**
+ * Set the colour from the selectable and highlighted states.
+ */
+void Cell::updateColor()
+{
+    if (isSelectable())
+    {
+        if (isHighlighted())
+        {
+            setColor(0, 1, 0);
+        } else
+        {
+            setColor(0, 0.5, 0);
+        }
+    }
+    else
+    {
+        if (isHighlighted())
+        {
+            setColor(0.5, 0, 0);
+        }
+        else
+        {
+            setColor(1, 1, 1);
+        }
+    }
+}
+
+/**
+ * Tell the terrain that the cell has changed height.
+ */
+void Cell::heightChanged()
+{
+    if (terrain) {
+        terrain->markCellDirty(this);
+    }
+}
+
+/**
+ * Update the hash of the maze after the wall has changed height from
+ * oldHeight, by taking out the key of the old height and adding the key of
+ * the new one.
+ */
+void Cell::wallChanged(int oldHeight)
+{
+    if (zobrist) {
+        zobrist->toggle(Zobrist::wallKey(posi, posj, oldHeight) ^
+                        Zobrist::wallKey(posi, posj, getWallHeight()));
+    }
 }
 
 /**
  * Returns a list of entities on the cell.
  */
-std::list<Entity*> Cell::getEntities()
+Cell::EntityList Cell::getEntities()
 {
     return entities;
 }
+
+/**
+ * Add a listener to be notified when entities enter or leave the cell.
+ * The cell does not take ownership of the listener.
+ */
+void Cell::addListener(CellListener *listener)
+{
+    listeners.push_back(listener);
+}
+
+/**
+ * Remove a listener that was added with addListener().
+ */
+void Cell::removeListener(CellListener *listener)
+{
+    for (std::vector<CellListener*>::iterator i=listeners.begin();
+         i != listeners.end(); i++) {
+        if (*i == listener) {
+            listeners.erase(i);
+            return;
+        }
+    }
+}
+
+/**
+ * Tell the listeners that the entity has entered the cell.
+ */
+void Cell::notifyEnter(Entity *entity)
+{
+    // index rather than iterate in case a listener adds another one
+    for (unsigned i=0; i<listeners.size(); i++) {
+        listeners[i]->notifyEnter(this, entity);
+    }
+}
+
+/**
+ * Tell the listeners that the entity has left the cell.
+ */
+void Cell::notifyExit(Entity *entity)
+{
+    for (unsigned i=0; i<listeners.size(); i++) {
+        listeners[i]->notifyExit(this, entity);
+    }
+}
@@ -10,11 +10,18 @@
 
 #include "mesh.h"
 #include "texture.h"
+#include "pool.h"
+#include "celllistener.h"
+#include "random.h"
+#include "zobrist.h"
+#include "rules.h"
 
 #include <vector>
 #include <list>
 
 class Entity;
+class Terrain;
+class CellSet;
 
 /**
  * The cell class represents a single hexagonal cell.
@@ -23,13 +30,16 @@ class Cell
 {
     friend class Entity;
     friend class Haggis;
+    friend class CellSet;
 
-private:
+public:
     /**
-     * The hexagonal cylinder mesh.
+     * A list of entities. The list nodes come from a pool because entities
+     * move between cells every turn.
      */
-    Mesh *mesh;
+    typedef std::list<Entity*, PoolAllocator<Entity*> > EntityList;
 
+private:
     /* The hexagon outline mesh. It is used for drawing the outline and for
      * intersection calculations.
      */
@@ -48,17 +58,27 @@ private:
     /**
      * A list of entites that are on the cell.
      */
-    std::list<Entity*> entities;
+    EntityList entities;
 
     /**
-     * Indicates whether the cell can be selected by the user.
+     * The listeners that are notified when entities enter or leave the cell.
      */
-    bool selectable;
+    std::vector<CellListener*> listeners;
 
     /**
-     * Indicates whether to highlight the cell when rendering.
+     * The sets of the maze that hold the cells that can be selected by the
+     * user and the cells to highlight. These are NULL if the cell is not in
+     * a maze.
      */
-    bool highlighted;
+    CellSet *selectableSet;
+    CellSet *highlightedSet;
+
+    /**
+     * The hash of the maze's state, which is kept up to date as the wall
+     * and the entities on the cell change. This is NULL if the cell is not
+     * in a maze.
+     */
+    Zobrist *zobrist;
 
     /**
      * Indicates whether the cell is visible or not.
@@ -75,13 +95,6 @@ private:
      */
     bool bHasPlayer;
 
-    /**
-     * This is only for the use of the haggis. When doing a search
-     * through the maze, it needs to know the parent of this cell in
-     * the search.
-     */
-    Cell *parent;
-
     /**
      * Does this cell have a wall on it?
      */
@@ -97,6 +110,30 @@ private:
      */
     Texture *tex;
 
+    /**
+     * The terrain that draws the cell, and the chunk the cell belongs to.
+     * The terrain is NULL if the cell is not drawn.
+     */
+    Terrain *terrain;
+    int chunk;
+
+    /**
+     * Set the colour from the selectable and highlighted states. The
+     * terrain is told if the colour changes.
+     */
+    void updateColor();
+
+    /**
+     * Tell the terrain that the cell has changed height.
+     */
+    void heightChanged();
+
+    /**
+     * Update the hash of the maze after the wall has changed height from
+     * oldHeight.
+     */
+    void wallChanged(int oldHeight);
+
     /**
      * The counter-clockwise function. It is used for intersection
      * calculation. Returns true if the points p, outlineMesh(idx) and
@@ -106,11 +143,6 @@ private:
     bool isccw(int idx, vector4 p);
 
 public:
-    /**
-     * The list of adjacent cells. This is used for pathfinding in the maze.
-     */
-    std::vector<Cell*> neighbours;
-
     /**
      * Constructor. Initialises the possible states of the cell.
      */
@@ -124,15 +156,15 @@ public:
     virtual ~Cell();
 
     /**
-     * Calculates and stores in a mesh object the geometry of the cell. This is
-     * used for rendering and collision detection.
+     * Calculates and stores in a mesh object the outline of the cell. This is
+     * used for collision detection. The cell itself is drawn by the Terrain.
      */
     void calcMesh();
 
     /**
-     * Renders the cell. float dt is the change in time during
-     * the last frame and is used for animation. All the entities
-     * on the cell are also rendered.
+     * Renders the entities on the cell. float dt is the change in time during
+     * the last frame and is used for animation. The cell itself is drawn by
+     * the Terrain.
      */
     void render(float dt);
 
@@ -160,12 +192,30 @@ public:
     /**
      * Sets the color of the cell.
      */
-    void setColor(double r, double g, double b)
-    {
-        color[0] = r;
-        color[1] = g;
-        color[2] = b;
-    }
+    void setColor(double r, double g, double b);
+
+    /**
+     * Returns the colour of the cell in the x, y and z components.
+     */
+    vector4 getColor();
+
+    /**
+     * Set the sets that hold the selectable and highlighted cells of the
+     * maze. This is called by Maze::load().
+     */
+    void setSelectionSets(CellSet *selectable, CellSet *highlighted);
+
+    /**
+     * Set the hash of the maze's state, which the cell and the entities on
+     * it keep up to date. This is called by Maze::load().
+     */
+    void setZobrist(Zobrist *zobrist);
+
+    /**
+     * Returns the hash of the maze's state, or NULL if the cell is not in a
+     * maze.
+     */
+    Zobrist *getZobrist();
 
     /**
      * Return true if the cell is selectable.
@@ -173,7 +223,8 @@ public:
     bool isSelectable();
 
     /**
-     * Set the selectability of the cell.
+     * Set the selectability of the cell, by adding it to or removing it
+     * from the maze's set of selectable cells.
      */
     void setSelectable(bool sel);
 
@@ -183,7 +234,8 @@ public:
     bool isHighlighted();
 
     /**
-     * Set whether the cell is highlighted or not.
+     * Set whether the cell is highlighted or not, by adding it to or
+     * removing it from the maze's set of highlighted cells.
      */
     void setHighlighted(bool hl);
 
@@ -218,9 +270,10 @@ public:
     void setHasPlayer(bool);
 
     /**
-     * Sets whether this cell has a wall or not.
+     * Sets whether this cell has a wall or not. A new wall is given a
+     * random height taken from random.
      */
-    void setWall(bool);
+    void setWall(bool, Random &random);
 
     /**
      * This is called if a grenade hits a wall. It decreases the size of the wall by
@@ -228,11 +281,39 @@ public:
      */
     void hitWall();
 
+    /**
+     * Returns the height of the wall on this cell, or 0 if there is no wall.
+     */
+    int getWallHeight();
+
+    /**
+     * Sets the height of the wall on this cell. A height of 0 removes the
+     * wall.
+     */
+    void setWallHeight(int h);
+
     /**
      * Set the texture to use for the cell.
      */
     void setTexture(Texture *tex);
 
+    /**
+     * Returns the texture of the cell. This may be NULL.
+     */
+    Texture *getTexture();
+
+    /**
+     * Set the terrain that draws the cell and the chunk that the cell
+     * belongs to. This is called by Terrain::build().
+     */
+    void setTerrain(Terrain *terrain, int chunk);
+
+    /**
+     * Returns the chunk of the terrain that the cell belongs to, or -1 if
+     * the cell is not drawn.
+     */
+    int getChunk();
+
     /**
      * Returns whether this cell has a wall or not.
      */
@@ -241,7 +322,30 @@ public:
     /**
      * Returns a list of entities on the cell.
      */
-    std::list<Entity*> getEntities();
+    EntityList getEntities();
+
+    /**
+     * Add a listener to be notified when entities enter or leave the cell.
+     * The cell does not take ownership of the listener.
+     */
+    void addListener(CellListener *listener);
+
+    /**
+     * Remove a listener that was added with addListener().
+     */
+    void removeListener(CellListener *listener);
+
+    /**
+     * Tell the listeners that the entity has entered the cell. This is called
+     * by Entity::setCell().
+     */
+    void notifyEnter(Entity *entity);
+
+    /**
+     * Tell the listeners that the entity has left the cell. This is called
+     * by Entity::setCell().
+     */
+    void notifyExit(Entity *entity);
 };
 
 #endif //CELL_H
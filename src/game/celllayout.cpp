@@ -0,0 +1,47 @@
+/************************************************************************
+ *
+ * celllayout.cpp
+ * CellLayout class implementation
+ *
+ ************************************************************************/
+
+#include "celllayout.h"
+
+/**
+ * Constructor. The layout is for an empty maze.
+ */
+CellLayout::CellLayout(Order order)
+    : order(order), width(0), height(0), tilesAcross(0), tilesDown(0)
+{
+}
+
+/**
+ * Set the size of the maze the layout is for.
+ */
+void CellLayout::resize(int width, int height)
+{
+    this->width = width;
+    this->height = height;
+    tilesAcross = (width + CELL_TILE_SIZE - 1) / CELL_TILE_SIZE;
+    tilesDown = (height + CELL_TILE_SIZE - 1) / CELL_TILE_SIZE;
+}
+
+/**
+ * Returns the order of the cells.
+ */
+CellLayout::Order CellLayout::getOrder() const
+{
+    return order;
+}
+
+/**
+ * Returns the number of cells in the array, including the padding that
+ * makes every tile whole in tiled order.
+ */
+int CellLayout::getSize() const
+{
+    if (order == ROW_MAJOR) {
+        return width*height;
+    }
+    return tilesAcross*tilesDown*CELL_TILE_SIZE*CELL_TILE_SIZE;
+}
@@ -0,0 +1,87 @@
+/************************************************************************
+ *
+ * celllayout.h
+ * CellLayout class
+ *
+ ************************************************************************/
+
+#ifndef CELLLAYOUT_H
+#define CELLLAYOUT_H
+
+#define CELL_TILE_BITS 3                      // tiles are 2^3 cells on a side
+#define CELL_TILE_SIZE (1 << CELL_TILE_BITS)  // the number of cells on a side
+
+/**
+ * The CellLayout decides where each cell of a maze is stored in the array
+ * of cells. In row-major order, a cell's neighbours in the rows above and
+ * below are a whole row away in memory, so a search through a large maze
+ * touches a different part of memory at almost every step.
+ *
+ * In tiled order, the maze is divided into square tiles of cells, which are
+ * stored one after the other in row-major order. The cells within a tile
+ * are stored in Z-order (Morton order), where the bits of the row and
+ * column are interleaved, so that cells that are close in the maze are
+ * close in memory. The array is padded so that every tile is whole.
+ */
+class CellLayout
+{
+public:
+    /**
+     * The ways of ordering the cells.
+     */
+    enum Order {ROW_MAJOR, TILED};
+
+    /**
+     * Constructor. The layout is for an empty maze.
+     */
+    CellLayout(Order order = ROW_MAJOR);
+
+    /**
+     * Set the size of the maze the layout is for.
+     */
+    void resize(int width, int height);
+
+    /**
+     * Returns the order of the cells.
+     */
+    Order getOrder() const;
+
+    /**
+     * Returns the number of cells in the array, including any padding.
+     */
+    int getSize() const;
+
+    /**
+     * Returns the position in the array of the cell in row i and column j.
+     */
+    int getIndex(int i, int j) const
+    {
+        if (order == ROW_MAJOR) {
+            return i*width + j;
+        }
+
+        // the bits of the row within the tile go between those of the
+        // column
+        static const int spread[CELL_TILE_SIZE] = {
+            0x00, 0x01, 0x04, 0x05, 0x10, 0x11, 0x14, 0x15
+        };
+        const int mask = CELL_TILE_SIZE - 1;
+        int tile = (i >> CELL_TILE_BITS)*tilesAcross + (j >> CELL_TILE_BITS);
+        return (tile << (2*CELL_TILE_BITS)) |
+            (spread[i & mask] << 1) | spread[j & mask];
+    }
+
+private:
+    /**
+     * The order of the cells.
+     */
+    Order order;
+
+    /**
+     * The size of the maze, and the number of tiles across and down it.
+     */
+    int width, height;
+    int tilesAcross, tilesDown;
+};
+
+#endif //CELLLAYOUT_H
@@ -0,0 +1,38 @@
+/************************************************************************
+ *
+ * celllistener.h
+ * CellListener class
+ *
+ ************************************************************************/
+
+#ifndef CELLLISTENER_H
+#define CELLLISTENER_H
+
+class Cell;
+class Entity;
+
+/**
+ * A CellListener is notified when entities enter or leave the cells it has
+ * been added to with Cell::addListener(). This is used for things that are
+ * triggered by a player stepping onto a cell, like items and traps.
+ */
+class CellListener
+{
+public:
+    /**
+     * Destructor.
+     */
+    virtual ~CellListener() {}
+
+    /**
+     * Called after the entity has been put on the cell.
+     */
+    virtual void notifyEnter(Cell *cell, Entity *entity) {}
+
+    /**
+     * Called after the entity has been taken off the cell.
+     */
+    virtual void notifyExit(Cell *cell, Entity *entity) {}
+};
+
+#endif //CELLLISTENER_H
@@ -0,0 +1,88 @@
+/************************************************************************
+ *
+ * cellset.cpp
+ * CellSet class implementation
+ *
+ ************************************************************************/
+
+#include "cellset.h"
+#include "cell.h"
+
+#include <algorithm>
+
+/**
+ * Constructor. The set is initially empty.
+ */
+CellSet::CellSet()
+{
+}
+
+/**
+ * Add the cell to the set, if it is not already in it.
+ */
+void CellSet::add(Cell *cell)
+{
+    if (!contains(cell)) {
+        cells.push_back(cell);
+        cell->updateColor();
+    }
+}
+
+/**
+ * Remove the cell from the set, if it is in it.
+ */
+void CellSet::remove(Cell *cell)
+{
+    std::vector<Cell*>::iterator i =
+        std::find(cells.begin(), cells.end(), cell);
+    if (i != cells.end()) {
+        cells.erase(i);
+        cell->updateColor();
+    }
+}
+
+/**
+ * Remove all the cells from the set. The cells are removed before they are
+ * told, so that they see the set as it will be.
+ */
+void CellSet::clear()
+{
+    std::vector<Cell*> old;
+    old.swap(cells);
+    for (unsigned i=0; i<old.size(); i++) {
+        old[i]->updateColor();
+    }
+}
+
+/**
+ * Returns true if the cell is in the set.
+ */
+bool CellSet::contains(Cell *cell) const
+{
+    return std::find(cells.begin(), cells.end(), cell) != cells.end();
+}
+
+/**
+ * Returns the number of cells in the set.
+ */
+int CellSet::size() const
+{
+    return cells.size();
+}
+
+/**
+ * Returns an iterator to the first cell in the set. The cells are in the
+ * order they were added.
+ */
+CellSet::const_iterator CellSet::begin() const
+{
+    return cells.begin();
+}
+
+/**
+ * Returns an iterator past the last cell in the set.
+ */
+CellSet::const_iterator CellSet::end() const
+{
+    return cells.end();
+}
@@ -0,0 +1,75 @@
+/************************************************************************
+ *
+ * cellset.h
+ * CellSet class
+ *
+ ************************************************************************/
+
+#ifndef CELLSET_H
+#define CELLSET_H
+
+#include <vector>
+
+class Cell;
+
+/**
+ * A CellSet holds a few cells of a maze, such as the cells that can be
+ * selected or the cell under the mouse. Only the cells in the set are
+ * stored, so adding, removing and clearing cost no more than the number of
+ * cells in the set, however large the maze is. The cells are told to update
+ * their colours when they join or leave the set.
+ */
+class CellSet
+{
+public:
+    typedef std::vector<Cell*>::const_iterator const_iterator;
+
+    /**
+     * Constructor. The set is initially empty.
+     */
+    CellSet();
+
+    /**
+     * Add the cell to the set, if it is not already in it.
+     */
+    void add(Cell *cell);
+
+    /**
+     * Remove the cell from the set, if it is in it.
+     */
+    void remove(Cell *cell);
+
+    /**
+     * Remove all the cells from the set.
+     */
+    void clear();
+
+    /**
+     * Returns true if the cell is in the set.
+     */
+    bool contains(Cell *cell) const;
+
+    /**
+     * Returns the number of cells in the set.
+     */
+    int size() const;
+
+    /**
+     * Returns an iterator to the first cell in the set. The cells are in the
+     * order they were added.
+     */
+    const_iterator begin() const;
+
+    /**
+     * Returns an iterator past the last cell in the set.
+     */
+    const_iterator end() const;
+
+private:
+    /**
+     * The cells in the set.
+     */
+    std::vector<Cell*> cells;
+};
+
+#endif //CELLSET_H
@@ -12,8 +12,8 @@
  */
 CreditsWindow::CreditsWindow()
 {
-    img = new StaticImage(Texture::load("images/credits/credits.png"));
-    exit = new Button(Texture::load("images/credits/exit.png"));
+    img = new StaticImage(Texture::loadPacked("images/credits/credits.png"));
+    exit = new Button(Texture::loadPacked("images/credits/exit.png"));
 
     addChild(img);
     addChild(exit);
@@ -8,6 +8,7 @@
 #include "entity.h"
 #include "vector4.h"
 #include "cell.h"
+#include "levelofdetail.h"
 
 #include <GL/gl.h>
 
@@ -19,7 +20,7 @@
  * Default constructor.
  */
 Entity::Entity()
-    : cell(NULL), mesh(NULL), visible(true)
+    : cell(NULL), mesh(NULL), ownMesh(true), visible(true)
 {
 }
 
@@ -29,24 +30,25 @@ Entity::Entity()
 Entity::~Entity()
 {
     setCell(NULL);
-    if (mesh) {
-        delete mesh;
-        mesh = NULL;
-    }
+    setMesh(NULL);
 }
 
 /**
  * Sets the cell on which the entity is currently. This function interacts
  * with the private variables in class Cell. If isPlayer is true (and it is
  * false by default), then the cell's hasPlayer flag will be set as well.
- * The cell may be set to NULL.
+ * The cell may be set to NULL. The listeners of the old and new cells
+ * are notified of the move.
  */
 void Entity::setCell(Cell *cell, bool isPlayer)
 {
+    Cell *old = this->cell;
+    uint64_t oldKey = getHashKey();
+
     if (this->cell) {
         // remove this from the entities list in the current cell
 
-        for (std::list<Entity*>::iterator i=this->cell->entities.begin();
+        for (Cell::EntityList::iterator i=this->cell->entities.begin();
              i != this->cell->entities.end(); i++) {
             if (*i == this) {
                 this->cell->entities.erase(i);
@@ -59,11 +61,45 @@ void Entity::setCell(Cell *cell, bool isPlayer)
 
     this->cell = cell;
 
+    // move the entity's key in the hash of the maze to the new cell
+    if (old && old->zobrist) {
+        old->zobrist->toggle(oldKey);
+    }
+    if (cell && cell->zobrist) {
+        cell->zobrist->toggle(getHashKey());
+    }
+
+    if (old) {
+        old->notifyExit(this);
+    }
+
     if (this->cell) {
         // add this to the entities list of the new cell
         cell->entities.push_back(this);
 	if(isPlayer)
 	    this->cell->bHasPlayer = true;
+
+        cell->notifyEnter(this);
+    }
+}
+
+/**
+ * Returns the key of the entity on its cell in the hash of the maze's
+ * state. Only players and items are part of the state, so this is 0.
+ */
+uint64_t Entity::getHashKey()
+{
+    return 0;
+}
+
+/**
+ * Update the hash of the maze after a change to the entity that changed
+ * its key from oldKey.
+ */
+void Entity::keyChanged(uint64_t oldKey)
+{
+    if (cell && cell->zobrist) {
+        cell->zobrist->toggle(oldKey ^ getHashKey());
     }
 }
 
@@ -108,15 +144,18 @@ void Entity::setRotation(float theta)
 }
 
 /**
- * Set the mesh that is rendered for this entity. The entity is responsible
- * for deleting the mesh after it has been set.
+ * Set the mesh that is rendered for this entity. If own is true (the
+ * default), the entity is responsible for deleting the mesh after it has
+ * been set. Otherwise the mesh is shared and must be kept valid while the
+ * entity uses it.
  */
-void Entity::setMesh(Mesh *mesh)
+void Entity::setMesh(Mesh *mesh, bool own)
 {
-    if (this->mesh) {
+    if (this->mesh && ownMesh) {
         delete this->mesh;
     }
     this->mesh = mesh;
+    ownMesh = own;
 }
 
 /**
@@ -133,12 +172,62 @@ void Entity::render(float dt)
 
     if (mesh)
     {
-        mesh->render(GL_QUADS);
+        //far away, the mesh is replaced by a quad facing the camera
+        LevelOfDetail &lod = LevelOfDetail::getInstance();
+        vector4 world = getPosition();
+        if (cell) {
+            world += cell->getPosition();
+        }
+
+        if (lod.getEntityLevel(world) == LOD_ENTITY_IMPOSTOR) {
+            renderImpostor();
+            lod.addTriangles(LOD_ENTITY_IMPOSTOR, 2);
+        } else {
+            mesh->render(GL_QUADS);
+            lod.addTriangles(LOD_ENTITY_MESH, mesh->getNumPoints() / 2);
+        }
     }
 
     glPopMatrix();
 }
 
+/**
+ * Draw a single quad facing the camera, as big as the mesh, instead of the
+ * mesh.
+ */
+void Entity::renderImpostor()
+{
+    //get the modelview matrix
+    float matrix[16];
+    glGetFloatv(GL_MODELVIEW_MATRIX, matrix);
+
+    //the vectors of the screen in the entity's coordinates
+    float e = mesh->getExtent();
+    vector4 right = vector4(matrix[0], matrix[4], matrix[8]) * e;
+    vector4 up = vector4(matrix[1], matrix[5], matrix[9]) * e;
+
+    glBegin(GL_QUADS);
+    glNormal3d(matrix[2], matrix[6], matrix[10]);
+
+    vector4 calc = (-right - up);
+    glTexCoord2f(0.0, 0.0);
+    glVertex3d(calc.x, calc.y, calc.z);
+
+    calc = (right - up);
+    glTexCoord2f(1.0, 0.0);
+    glVertex3d(calc.x, calc.y, calc.z);
+
+    calc = (right + up);
+    glTexCoord2f(1.0, 1.0);
+    glVertex3d(calc.x, calc.y, calc.z);
+
+    calc = (up - right);
+    glTexCoord2f(0.0, 1.0);
+    glVertex3d(calc.x, calc.y, calc.z);
+
+    glEnd();
+}
+
 /**
  * Sets the "visible" flag.
  */
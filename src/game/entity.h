@@ -30,9 +30,10 @@ public:
      * Sets the cell on which the entity is currently. This function interacts
      * with the private variables in class Cell. If isPlayer is true (and it is
      * false by default), then the cell's hasPlayer flag will be set as well.
-     * The cell may be set to NULL.
+     * The cell may be set to NULL. The listeners of the old and new cells
+     * are notified of the move.
      */
-    void setCell(Cell *cell, bool isPlayer = false);
+    virtual void setCell(Cell *cell, bool isPlayer = false);
 
     /**
      * Return the cell that contains this entity. The cell may be NULL.
@@ -60,10 +61,12 @@ public:
     void setRotation(float theta);
 
     /**
-     * Set the mesh that is rendered for this entity. The entity is responsible
-     * for deleting the mesh after it has been set.
+     * Set the mesh that is rendered for this entity. If own is true (the
+     * default), the entity is responsible for deleting the mesh after it has
+     * been set. Otherwise the mesh is shared and must be kept valid while the
+     * entity uses it.
      */
-    void setMesh(Mesh *mesh);
+    void setMesh(Mesh *mesh, bool own = true);
 
     /**
      * Render the cell.
@@ -80,7 +83,26 @@ public:
      */
     bool isVisible();
 
+    /**
+     * Returns the key of the entity on its cell in the hash of the maze's
+     * state, or 0 if it has no cell. Entities that are not part of the
+     * state of the game, like this one, have a key of 0.
+     */
+    virtual uint64_t getHashKey();
+
 protected:
+    /**
+     * Draw a single quad facing the camera, as big as the mesh, instead of
+     * the mesh.
+     */
+    void renderImpostor();
+
+    /**
+     * Update the hash of the maze after a change to the entity that
+     * changed its key from oldKey.
+     */
+    void keyChanged(uint64_t oldKey);
+
     /**
      * The position of the entity relative to the cell.
      */
@@ -101,6 +123,11 @@ protected:
      */
     Mesh *mesh;
 
+    /**
+     * True if the entity is responsible for deleting the mesh.
+     */
+    bool ownMesh;
+
     /**
      * Is the entity visible, or is it hiding on the cell?
      */
@@ -11,11 +11,12 @@
 #include "action.h"
 #include "billboard.h"
 #include "vector4.h"
+#include "pool.h"
 
 /**
  * The FloatAction class animates a billboard to floating upwards.
  */
-class FloatAction : public Action
+class FloatAction : public Action, public Pooled<FloatAction>
 {
 public:
 
@@ -7,8 +7,16 @@
 
 #include "game.h"
 #include "level.h"
+#include "renderstate.h"
 
 #include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <cmath>
+
+#define BENCHMARK_FRAMES 500  // the number of frames the benchmark runs for
+
+using namespace std;
 
 /**
  * Constructor. The command line arguments are parsed for options.
@@ -20,6 +28,16 @@ Game::Game(int argc, char *argv[])
     intro = NULL;
     level = NULL;
     credits = NULL;
+
+    benchmark = false;
+    for (int i=1; i<argc; i++) {
+        if (strcmp(argv[i], "--benchmark") == 0) {
+            benchmark = true;
+        } else if ((strcmp(argv[i], "--frame-time") == 0) && (i+1 < argc)) {
+            //the target frame time is given in milliseconds
+            setTargetFrameTime(atof(argv[++i]) / 1000.0);
+        }
+    }
 }
 
 /**
@@ -39,13 +57,45 @@ Game::~Game()
     }
 }
 
+/**
+ * Returns true if the game was started with --benchmark. The first level is
+ * then shown with the camera circling the hero, and statistics are printed
+ * when it finishes.
+ */
+bool Game::isBenchmark()
+{
+    return benchmark;
+}
+
 /**
  * Perform a single iteration of the main loop.
  */
 void Game::step(float t, float dt) throw(app_error)
 {
+    //the benchmark goes straight to the maze of the first level
+    if ((state == -1) && benchmark) {
+        level = new Level();
+        level->load("");
+        level->startNow();
+        Application::setRootWindow(level);
+
+        frames = 0;
+        drawCalls = 0;
+        stateChanges = 0;
+        for (int i=0; i<LOD_COUNT; i++) {
+            triangles[i] = 0;
+        }
+        state = 3;
+
+    } else if (state == 3) {
+        if (level->shouldExit()) {
+            quit();
+        } else {
+            stepBenchmark();
+        }
+
     //if the game is just starting
-    if (state == -1) {
+    } else if (state == -1) {
         state = 0;
 	//introduction
         intro = new IntroWindow();
@@ -91,3 +141,56 @@ void Game::step(float t, float dt) throw(app_error)
     //continue with the loop
     Application::step(t, dt);
 }
+
+/**
+ * Move the camera for the next frame of the benchmark, and collect the
+ * statistics of the last one. The benchmark ends after BENCHMARK_FRAMES
+ * frames and the averages are printed. An app_error is thrown if no
+ * terrain was drawn, since the statistics would then mean nothing.
+ */
+void Game::stepBenchmark() throw(app_error)
+{
+    LevelOfDetail &lod = LevelOfDetail::getInstance();
+    Maze *maze = level->getMaze();
+
+    //the first frame has not been drawn yet
+    if (frames > 0) {
+        for (int i=0; i<LOD_COUNT; i++) {
+            triangles[i] += lod.getFrameTriangles((DetailLevel) i);
+        }
+        drawCalls += maze->getTerrain()->getDrawCalls();
+        stateChanges += RenderState::getInstance().getFrameChanges();
+    }
+
+    if (frames == BENCHMARK_FRAMES) {
+        long terrain = triangles[LOD_TERRAIN_FULL] +
+            triangles[LOD_TERRAIN_NO_OUTLINES] + triangles[LOD_TERRAIN_FLAT];
+        if (terrain == 0) {
+            throw app_error("Benchmark: no terrain was drawn.");
+        }
+
+        const char *names[LOD_COUNT] = {
+            "terrain, full detail", "terrain, no outlines", "terrain, flat",
+            "entities, mesh", "entities, impostor"
+        };
+
+        cout << "Benchmark: " << frames << " frames" << endl;
+        cout << "Average triangles per frame:" << endl;
+        for (int i=0; i<LOD_COUNT; i++) {
+            cout << "   " << names[i] << ": " << triangles[i] / frames << endl;
+        }
+        cout << "Average terrain draw calls per frame: "
+             << drawCalls / frames << endl;
+        cout << "Average state changes per frame: "
+             << stateChanges / frames << endl;
+        quit();
+        return;
+    }
+
+    //circle the hero twice, zooming from near to far and back
+    Camera *camera = maze->getCamera();
+    float a = 2.0 * M_PI * frames / BENCHMARK_FRAMES;
+    camera->set_phi(2*a);
+    camera->set_r(50 - 45*cos(a));
+    frames++;
+}
@@ -14,6 +14,7 @@
 #include "level.h"
 #include "introwindow.h"
 #include "creditswindow.h"
+#include "levelofdetail.h"
 
 /**
  * The Game class handles all the high-level game logic like loading the
@@ -33,6 +34,13 @@ public:
      */
     virtual ~Game();
 
+    /**
+     * Returns true if the game was started with --benchmark. The first
+     * level is then shown with the camera circling the hero, and statistics
+     * are printed when it finishes.
+     */
+    bool isBenchmark();
+
 protected:
     /**
      * Perform a single iteration of the main loop.
@@ -46,9 +54,31 @@ private:
      *    0 = intro window
      *    1 = first level
      *    2 = credits window
+     *    3 = benchmark
      */
     int state;
 
+    /**
+     * Whether the game is running a benchmark, and for how many frames it
+     * has run.
+     */
+    bool benchmark;
+    int frames;
+
+    /**
+     * The totals of the statistics collected during the benchmark.
+     */
+    long triangles[LOD_COUNT];
+    long drawCalls, stateChanges;
+
+    /**
+     * Move the camera for the next frame of the benchmark, and collect the
+     * statistics of the last one. The benchmark ends after BENCHMARK_FRAMES
+     * frames and the averages are printed. An app_error is thrown if no
+     * terrain was drawn, since the statistics would then mean nothing.
+     */
+    void stepBenchmark() throw(app_error);
+
     /**
      * The introduction window. This may be NULL if state != 0.
      */
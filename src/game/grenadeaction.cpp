@@ -6,18 +6,46 @@
  ************************************************************************/
 
 #include "grenadeaction.h"
+#include "gamerules.h"
+#include "hexcoord.h"
 #include <GL/glu.h>
 #include <iostream>
 
 #define VEL 10.0
 #define ACC -100.0
-#define SELECTABLE_RADIUS_SQ 25.0
-#define CELL_CHECK_RADIUS 4   //approximately selection area
-#define DAMAGE 4
 
-//for some compilers
-#define max(x, y) (((x) > (y)) ? (x) : (y))
-#define min(x, y) (((x) < (y)) ? (x) : (y))
+/**
+ * The grenade mesh. All grenades look the same, so they share one mesh.
+ */
+static Mesh *grenadeMesh = NULL;
+
+/**
+ * The texture for the health loss billboard. It is only loaded once.
+ */
+static Texture *hitTexture = NULL;
+
+/**
+ * Returns the grenade mesh, creating it the first time it is needed.
+ */
+static Mesh *getGrenadeMesh()
+{
+    if (!grenadeMesh) {
+        grenadeMesh = Mesh::makeCube(0.25);
+    }
+    return grenadeMesh;
+}
+
+/**
+ * Returns the health loss texture, loading it the first time it is needed.
+ * This may be NULL if textures cannot be loaded.
+ */
+static Texture *getHitTexture()
+{
+    if (!hitTexture) {
+        hitTexture = Texture::load("images/overlay/hit.png");
+    }
+    return hitTexture;
+}
 
 /**
  * Constructor.
@@ -27,12 +55,11 @@
 GrenadeAction::GrenadeAction(Player *player, Player *opp,
                              Cell *src, Cell *dest)
     : player(player), opponent(opp), src(src), dest(dest),
-      floater(NULL), texhealth(NULL)
+      floater(NULL)
 {
     assert(canThrow(player));
 
-    grenade = new Entity();
-    grenade->setCell(src);
+    grenade.setCell(src);
     t = 0;
 
     vector4 d = dest->getPosition() - src->getPosition();
@@ -43,8 +70,8 @@ GrenadeAction::GrenadeAction(Player *player, Player *opp,
     //s/t - 1/2*a*t = u
     vel.y = d.y/T - 0.5*ACC*T;
 
-    //create grenade mesh
-    grenade->setMesh(Mesh::makeCube(0.25));
+    //use the shared grenade mesh
+    grenade.setMesh(getGrenadeMesh(), false);
 }
 
 /**
@@ -52,14 +79,9 @@ GrenadeAction::GrenadeAction(Player *player, Player *opp,
  */
 GrenadeAction::~GrenadeAction()
 {
-    delete grenade;
-
     if (floater) {
         delete floater;
     }
-    if (texhealth) {
-        delete texhealth;
-    }
 }
 
 /**
@@ -90,13 +112,11 @@ bool GrenadeAction::update(float dt)
             } else if (dest == opponent->getCell()) {
                 // we have hit the opponent
 
-                opponent->setHealth(opponent->getHealth() - DAMAGE);
+                opponent->setHealth(opponent->getHealth() - GRENADE_DAMAGE);
 
                 // create a floating health loss animation
 
-                texhealth = Texture::load("images/overlay/hit.png");
-
-                BillBoard *bb = new BillBoard(texhealth);
+                BillBoard *bb = new BillBoard(getHitTexture());
                 bb->setPosition(opponent->getPosition());
                 bb->setCell(opponent->getCell());
 
@@ -112,7 +132,7 @@ bool GrenadeAction::update(float dt)
     vel.y += ACC*dt;
     position += vel * dt;
 
-    grenade->setPosition(position);
+    grenade.setPosition(position);
 
     return true;
 }
@@ -141,32 +161,32 @@ void GrenadeAction::markSelectable(Player *player, Maze *maze)
     int pi, pj;
     player->getCell()->getMazePosition(pi, pj);
 
-    // check all adjacent cells
-    const int mini = max(0, pi-CELL_CHECK_RADIUS);
-    const int maxi = min(maze->getHeight()-1, pi+CELL_CHECK_RADIUS);
-    const int minj = max(0, pj-CELL_CHECK_RADIUS);
-    const int maxj = min(maze->getWidth()-1, pj+CELL_CHECK_RADIUS);
-    for(int i = mini; i <= maxi; i++)
+    // check the cells in range. The first offset is the player's own cell,
+    // and a grenade can't be thrown on self.
+    const GridOffset *offsets = HexCoord::getOffsets(pi);
+    const int count = HexCoord::getDiscSize(GRENADE_RANGE);
+    for (int k = 1; k < count; k++)
     {
-        for (int j = minj; j <= maxj; j++)
+        int i = pi + offsets[k].di;
+        int j = pj + offsets[k].dj;
+        if ((i < 0) || (i >= maze->getHeight()) ||
+            (j < 0) || (j >= maze->getWidth()))
         {
-            if ((i == pi) && (j == pj))
-            {
-                // can't throw grenade on self
-                continue;
-            }
-
-            //get cell under consideration
-            Cell *c = maze->getCell(i, j);
-
-            //get relative position
-            vector4 relpos = c->getPosition() - player->getCell()->getPosition();
-            relpos.y = 0;
-            //if the cell is in range, make it selectable
-            if(relpos.squaredLength() < SELECTABLE_RADIUS_SQ)
-            {
-                c->setSelectable(true);
-            }
+            // this goes off the edge of the maze
+            continue;
         }
+
+        maze->setSelectable(maze->getCell(i, j));
     }
 }
+
+/**
+ * Set m to the throw at the destination, and return true.
+ */
+bool GrenadeAction::getMove(Move &m) const
+{
+    int i, j;
+    dest->getMazePosition(i, j);
+    m = Move(Move::GRENADE, i, j);
+    return true;
+}
@@ -14,11 +14,13 @@
 #include "maze.h"
 #include "player.h"
 #include "floataction.h"
+#include "pool.h"
+#include "rules.h"
 
 /**
  * The GrenadeAction class animates a grenade being thrown.
  */
-class GrenadeAction : public Action {
+class GrenadeAction : public Action, public Pooled<GrenadeAction> {
 public:
     /**
      * Constructor.
@@ -49,6 +51,11 @@ public:
      */
     virtual bool update(float dt);
 
+    /**
+     * Set m to the throw at the destination, and return true.
+     */
+    virtual bool getMove(Move &m) const;
+
 private:
     /**
      * The player who is throwing the grenade.
@@ -78,18 +85,13 @@ private:
     /**
      * The object that makes sure the grenade is rendered.
      */
-    Entity *grenade;
+    Entity grenade;
 
     /**
      * The float action for notifying the opponent health loss.
      */
     FloatAction *floater;
 
-    /**
-     * The health texture for the health loss billboard.
-     */
-    Texture *texhealth;
-
     /**
      * The velocity vector.
      */
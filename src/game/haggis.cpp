@@ -6,28 +6,30 @@
  ************************************************************************/
 
 #include "haggis.h"
+#include "renderstate.h"
 #include "walkaction.h"
 #include "waitaction.h"
 #include "jumpaction.h"
 #include "grenadeaction.h"
+#include "psychicaction.h"
+#include "haggispolicy.h"
 #include "level.h"
+#include "statebridge.h"
 
 #include <GL/gl.h>
 
 #include <cmath>
 
-#include <queue>
-
 #include <iostream>
 
-#define GRENADE_RADIUS_SQ 25.0
-
 /**
  * Constructor. Takes maze and hero because these are necessary for AI.
  */
 Haggis::Haggis(Maze *m, Hero* h)
-    : bTurn(false), maze(m), hero(h)
+    : bTurn(false), maze(m), policy(new HaggisPolicy()), thinker(NULL),
+      hero(h)
 {
+    side = Zobrist::HAGGIS;
     setMesh(Mesh::makeCube(0.5));
     t = 0;
 }
@@ -37,7 +39,8 @@ Haggis::Haggis(Maze *m, Hero* h)
  */
 Haggis::~Haggis()
 {
-    //nothing to destruct
+    delete thinker;
+    delete policy;
 }
 
 /**
@@ -45,9 +48,8 @@ Haggis::~Haggis()
  */
 void Haggis::render(float dt)
 {
-    if(bTurn)
+    if(bTurn && takeTurn())
     {
-        takeTurn();
         bTurn = false;
     }
 
@@ -62,9 +64,9 @@ void Haggis::render(float dt)
     float lightcol[] = {1.0, 1.0, 0.0, 1.0};
     glLightfv(GL_LIGHT3, GL_DIFFUSE, lightcol);
     glLightf(GL_LIGHT3, GL_QUADRATIC_ATTENUATION, 0.5);
-    glEnable(GL_LIGHT3);
+    RenderState::getInstance().enable(GL_LIGHT3);
 
-    glColor3f(1,1,0);
+    RenderState::getInstance().color(1,1,0);
     Player::render(dt);
 
     setPosition(rest);
@@ -79,127 +81,99 @@ void Haggis::setTurn()
 }
 
 /**
- * Makes the haggis take a turn.
+ * Set the AI that decides the haggis' moves. The haggis takes ownership of
+ * it, and deletes the one it had. A policy that can ponder gets a thinker
+ * to run it, seeded from the maze's random numbers.
  */
-void Haggis::takeTurn()
+void Haggis::setPolicy(Policy *p)
 {
-    //if the haggis can see the hero, there is a 50% chance that it will shoot him
-    if (GrenadeAction::canThrow(this)) {
-        if(rand() % 2) {
-            vector4 diff = getCell()->getPosition() - hero->getCell()->getPosition();
-            diff.y = 0;
-            if(diff.squaredLength() < GRENADE_RADIUS_SQ) {
-                maze->getLevel()->notifyHaggisAction(new GrenadeAction(this, hero, getCell(), hero->getCell()));
-                return;
-            }
-        }
-    }
+    delete thinker;
+    thinker = NULL;
+    delete policy;
+    policy = p;
 
-    if (!WalkAction::canWalk(this))
-    {
-        maze->getLevel()->notifyHaggisAction(new WaitAction(this));
-        return;
+    if (policy->canPonder()) {
+        thinker = new Thinker(policy, maze->getRandom().next());
     }
+}
 
-    if(pathToFollow.empty())
-    {
-        findPath();
-	if(pathToFollow.empty())
-	{
-	    //the haggis is stuck
-	    maze->getLevel()->notifyHaggisAction(new WaitAction(this));
-	    return;
-	}
+/**
+ * Lets the haggis know that it is the hero's turn, so it can start
+ * thinking about its replies.
+ */
+void Haggis::ponder()
+{
+    if (thinker) {
+        thinker->ponder(getState(true));
     }
+}
 
-    //go to next cell
-    Cell *nextCell = pathToFollow.back();
-    pathToFollow.pop_back();
-
-    //check that the player is not on this cell
-    if(nextCell->hasPlayer())
-    {
-	//try to jump over the player.
-	if(pathToFollow.empty())
-	{
-	    //decide to wait
-	    maze->getLevel()->notifyHaggisAction(new WaitAction(this));
-	    return;
-	}
-
-	//jump over the player
-	nextCell = pathToFollow.back();
-	pathToFollow.pop_back();
-	maze->getLevel()->notifyHaggisAction(new JumpAction(this, nextCell));
-	return;
+/**
+ * Lets the haggis know the move the hero has committed to, so it can start
+ * thinking about its reply while the move is animated. The position after
+ * the move is worked out with the rules, since the maze won't have changed
+ * until the move's action has finished.
+ */
+void Haggis::notifyHeroMove(const Move &m)
+{
+    if (thinker) {
+        GameState s = getState(true);
+        GameRules::play(s, m);
+        thinker->think(s);
     }
-
-    maze->getLevel()->notifyHaggisAction(new WalkAction(this, nextCell));
 }
 
 /**
- * Finds a random destination and the path to get there.
+ * Makes the haggis take a turn. The policy chooses the move from the state
+ * of the maze, and the action for it is passed to the level. With a
+ * thinker, the move is only taken once it has been chosen, which it
+ * usually has been already; if the maze turned out differently from what
+ * the thinker expected, it starts thinking again from the real state.
  */
-void Haggis::findPath()
+bool Haggis::takeTurn()
 {
-    using namespace std;
-
-    //store every visitable cell
-    vector<Cell*> visitable;
-
-    //do a breadth-first search of the maze
-    queue<Cell*> q;
-
-    //the cell the haggis is on is the start
-    q.push(this->cell);
-    
-    //if the parent is NULL, the cell has not yet been seen
-    //in the search
-    for(int i = 0; i < maze->getWidth(); i++)
-    {
-        for(int j = 0; j < maze->getHeight(); j++)
-        {
-            maze->getCell(j,i)->parent = NULL;
-        }
-    }
+    GameState state = getState(false);
 
-    Cell *curr;
-    while(!q.empty())
-    {
-        //get current cell
-        curr = q.front();
-        q.pop();
-
-        //push all its neighbours onto the queue
-        for(unsigned i = 0; i < curr->neighbours.size(); i++)
-        {
-            if(curr->neighbours[i]->parent == NULL &&
-               !curr->neighbours[i]->isWall && curr->neighbours[i]->isVisible())
-            {
-                curr->neighbours[i]->parent = curr;
-                q.push(curr->neighbours[i]);
-                visitable.push_back(curr->neighbours[i]);
-            }
+    Move m;
+    if (thinker) {
+        thinker->think(state);
+        if (!thinker->getMove(state, m)) {
+            return false;
         }
-    }
-    
-    //make sure the haggis can get somewhere
-    if(visitable.size() < 2)
-    {
-	pathToFollow.clear();
-	return;
+    } else {
+        m = policy->choose(state, maze->getRandom());
     }
 
-    //choose a random destination
-    Cell *dest = visitable[rand()%visitable.size()];
-    
-    //find the path to get there
-    pathToFollow.clear();
-    while(dest != this->cell)
-    {
-        pathToFollow.push_back(dest);
-        dest = dest->parent;
+    Action *a;
+    switch (m.type) {
+    case Move::GRENADE:
+        a = new GrenadeAction(this, hero, getCell(), maze->getCell(m.i, m.j));
+        break;
+    case Move::JUMP:
+        a = new JumpAction(this, maze->getCell(m.i, m.j));
+        break;
+    case Move::WALK:
+        a = new WalkAction(this, maze->getCell(m.i, m.j));
+        break;
+    case Move::PSYCHIC:
+        a = new PsychicAction(this, maze->getCell(m.i, m.j));
+        break;
+    default:
+        a = new WaitAction(this);
+        break;
     }
+    maze->getLevel()->notifyHaggisAction(a);
+    return true;
 }
 
-
+/**
+ * Returns the state of the maze, for the turn of the hero if heroTurn is
+ * true and the haggis otherwise.
+ */
+GameState Haggis::getState(bool heroTurn)
+{
+    GameState state;
+    StateBridge::extract(state, maze, hero, this);
+    state.heroTurn = heroTurn;
+    return state;
+}
@@ -11,7 +11,8 @@
 #include "player.h"
 #include "maze.h"
 #include "hero.h"
-#include <vector>
+#include "policy.h"
+#include "thinker.h"
 
 /**
  * The Haggis represents the computer player
@@ -39,6 +40,24 @@ public:
      */
     void setTurn();
 
+    /**
+     * Set the AI that decides the haggis' moves. The haggis takes
+     * ownership of it, and deletes the one it had.
+     */
+    void setPolicy(Policy *p);
+
+    /**
+     * Lets the haggis know that it is the hero's turn, so it can start
+     * thinking about its replies.
+     */
+    void ponder();
+
+    /**
+     * Lets the haggis know the move the hero has committed to, so it can
+     * start thinking about its reply while the move is animated.
+     */
+    void notifyHeroMove(const Move &m);
+
 private:
 
     /**
@@ -58,23 +77,30 @@ private:
     Maze *maze;
 
     /**
-     * This is the path the haggis decides to follow.
+     * The haggis' AI. It is a HaggisPolicy unless another one is set.
+     */
+    Policy *policy;
+
+    /**
+     * Runs the policy on a thread of its own if it can ponder, so that the
+     * frames don't wait for it. It is NULL if the policy is run when the
+     * haggis takes its turn.
      */
-    std::vector<Cell*> pathToFollow;
+    Thinker *thinker;
 
     /**
-     * This decides what the haggis will do, and does it. It finds a
-     * random spot in the maze for the haggis to move to and moves it
-     * there one step at a time, and it makes the haggis throw grenades
-     * when the hero is in range. Basically, it is the haggis' AI.
+     * This decides what the haggis will do, and does it. The policy
+     * chooses a move from the state of the maze, and the haggis starts
+     * the action for it. False is returned if the thinker has not chosen
+     * the move yet, and the haggis should try again next frame.
      */
-    void takeTurn();
+    bool takeTurn();
 
     /**
-     * This method searches through the maze and finds the haggis a
-     * new random location to go to, and a path to follow.
+     * Returns the state of the maze, for the turn of the hero if heroTurn
+     * is true and the haggis otherwise.
      */
-    void findPath();
+    GameState getState(bool heroTurn);
 
     /**
      * The haggis needs to know where the hero is so that it can throw grenades.
@@ -6,6 +6,7 @@
   ************************************************************************/
 
 #include "hero.h"
+#include "renderstate.h"
 
 #include <GL/gl.h>
 
@@ -48,10 +49,10 @@ void Hero::render(float dt)
     float lightcol[] = {1.0, 0.0, 0.0, 1.0};
     glLightfv(GL_LIGHT2, GL_DIFFUSE, lightcol);
     glLightf(GL_LIGHT2, GL_QUADRATIC_ATTENUATION, 0.5);
-    glEnable(GL_LIGHT2);
+    RenderState::getInstance().enable(GL_LIGHT2);
 
     //draw the hero. This is done in the base class Player.
-    glColor3f(1,0,0);
+    RenderState::getInstance().color(1,0,0);
     Player::render(dt);
 
     setPosition(rest);
@@ -0,0 +1,102 @@
+/************************************************************************
+ *
+ * hitindex.cpp
+ * HitIndex class implementation
+ *
+ ************************************************************************/
+
+#include "hitindex.h"
+
+/**
+ * Constructor. The index is empty.
+ */
+HitIndex::HitIndex()
+{
+}
+
+/**
+ * Remove all the windows, and make the index cover the area from the origin
+ * to size.
+ */
+void HitIndex::clear(vector4 size)
+{
+    this->size = size;
+    entries.clear();
+    cells.resize(HIT_GRID_SIZE * HIT_GRID_SIZE);
+    for (unsigned i=0; i<cells.size(); i++) {
+        cells[i].clear();
+    }
+}
+
+/**
+ * Add a window to the index. The windows under a point are returned in the
+ * order they were added.
+ */
+void HitIndex::add(Window *win, vector4 offset, vector4 min, vector4 max)
+{
+    HitEntry e;
+    e.win = win;
+    e.offset = offset;
+    e.min = min;
+    e.max = max;
+    entries.push_back(e);
+
+    int x0 = getCell(min.x, size.x);
+    int x1 = getCell(max.x, size.x);
+    int y0 = getCell(min.y, size.y);
+    int y1 = getCell(max.y, size.y);
+    for (int j=y0; j<=y1; j++) {
+        for (int i=x0; i<=x1; i++) {
+            cells[j*HIT_GRID_SIZE + i].push_back(entries.size() - 1);
+        }
+    }
+}
+
+/**
+ * Add the windows whose area contains the point p to hits, in the order
+ * they were added to the index.
+ */
+void HitIndex::find(vector4 p, std::vector<HitEntry> &hits)
+{
+    if (cells.empty()) {
+        return;
+    }
+
+    int i = getCell(p.x, size.x);
+    int j = getCell(p.y, size.y);
+    std::vector<int> &cell = cells[j*HIT_GRID_SIZE + i];
+    for (unsigned i=0; i<cell.size(); i++) {
+        HitEntry &e = entries[cell[i]];
+        if ((p.x >= e.min.x) && (p.y >= e.min.y) &&
+            (p.x < e.max.x) && (p.y < e.max.y)) {
+            hits.push_back(e);
+        }
+    }
+}
+
+/**
+ * Returns the number of windows in the index.
+ */
+int HitIndex::getEntryCount()
+{
+    return entries.size();
+}
+
+/**
+ * Returns the column or row of the grid that contains the coordinate x,
+ * along an axis of length len. Coordinates outside are clamped.
+ */
+int HitIndex::getCell(float x, float len)
+{
+    if (len <= 0) {
+        return 0;
+    }
+
+    int c = (int) (x / len * HIT_GRID_SIZE);
+    if (c < 0) {
+        return 0;
+    } else if (c >= HIT_GRID_SIZE) {
+        return HIT_GRID_SIZE - 1;
+    }
+    return c;
+}
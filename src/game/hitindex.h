@@ -0,0 +1,93 @@
+/************************************************************************
+ *
+ * hitindex.h
+ * HitIndex class
+ *
+ ************************************************************************/
+
+#ifndef HITINDEX_H
+#define HITINDEX_H
+
+#include "vector4.h"
+
+#include <vector>
+
+class Window;
+
+#define HIT_GRID_SIZE 16  // the index is divided into this many cells along each side
+
+/**
+ * A window in a HitIndex. The offset is the position of the window relative
+ * to the window that owns the index, and min and max are the corners of
+ * the part of the window that can receive events, in the same coordinates.
+ */
+struct HitEntry
+{
+    Window *win;
+    vector4 offset;
+    vector4 min, max;
+};
+
+/**
+ * The HitIndex finds the windows under a point without walking the window
+ * tree. The area of the owning window is divided into a grid, and each
+ * cell of the grid lists the windows that overlap it, in the order that
+ * they should receive events.
+ */
+class HitIndex
+{
+public:
+    /**
+     * Constructor. The index is empty.
+     */
+    HitIndex();
+
+    /**
+     * Remove all the windows, and make the index cover the area from the
+     * origin to size.
+     */
+    void clear(vector4 size);
+
+    /**
+     * Add a window to the index. The windows under a point are returned in
+     * the order they were added.
+     */
+    void add(Window *win, vector4 offset, vector4 min, vector4 max);
+
+    /**
+     * Add the windows whose area contains the point p to hits, in the order
+     * they were added to the index.
+     */
+    void find(vector4 p, std::vector<HitEntry> &hits);
+
+    /**
+     * Returns the number of windows in the index.
+     */
+    int getEntryCount();
+
+private:
+    /**
+     * The windows in the index.
+     */
+    std::vector<HitEntry> entries;
+
+    /**
+     * For each cell of the grid, by row, the indices of the entries that
+     * overlap it. The grid is only allocated when the index is first
+     * cleared, since most windows never own an index.
+     */
+    std::vector< std::vector<int> > cells;
+
+    /**
+     * The area covered by the index.
+     */
+    vector4 size;
+
+    /**
+     * Returns the column or row of the grid that contains the coordinate x,
+     * along an axis of length len. Coordinates outside are clamped.
+     */
+    int getCell(float x, float len);
+};
+
+#endif //HITINDEX_H
@@ -13,9 +13,9 @@
 IntroWindow::IntroWindow()
 {
     //load images
-    img = new StaticImage(Texture::load("images/intro/intro.png"));
-    start = new Button(Texture::load("images/intro/start.png"));
-    exit = new Button(Texture::load("images/intro/exit.png"));
+    img = new StaticImage(Texture::loadPacked("images/intro/intro.png"));
+    start = new Button(Texture::loadPacked("images/intro/start.png"));
+    exit = new Button(Texture::loadPacked("images/intro/exit.png"));
 
     //add children
     addChild(img);
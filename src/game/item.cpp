@@ -6,6 +6,7 @@
  ************************************************************************/
 
 #include "item.h"
+#include "renderstate.h"
 #include "itemaction.h"
 #include "billboard.h"
 
@@ -27,8 +28,8 @@ std::map<Item::ItemType, Mesh*> meshes;
 
 /**
  * This loads the appropriate texture for an item, if one has not
- * been loaded already. The texture is returned and is guaranteed not to be
- * NULL.
+ * been loaded already. The texture is returned. It is only NULL if SDL has
+ * not been initialised, as in the unit tests.
  */
 Texture *getItemTexture(Item::ItemType type)
 {
@@ -51,8 +52,9 @@ Texture *getItemTexture(Item::ItemType type)
     };
 
     Texture *tex = Texture::load(filename);
-    assert(tex);
-    textures[type] = tex;
+    if (tex) {
+        textures[type] = tex;
+    }
     return tex;
 }
 
@@ -74,7 +76,7 @@ Mesh *getItemMesh(Item::ItemType type)
  * Default constructor.
  */
 Item::Item(Level* l)
-    : Entity(), level(l)
+    : Entity(), itemType(HEALTH), level(l)
 {
     setVisibility(false);
     spent = false;
@@ -85,37 +87,65 @@ Item::Item(Level* l)
  */
 Item::~Item()
 {
-    //nothing to destruct
+    //stop listening to the cell
+    setCell(NULL);
 }
 
 /**
- * Renders the item and checks if it has been picked up by the hero.
+ * Renders the item.
  */
 void Item::render(float dt)
 {
     // change the colour depending on the item type
+    RenderState &state = RenderState::getInstance();
     switch(getType()) 
     {
-	case HEALTH:  glColor3f(1, 0, 1); break;
-	case ENERGY:  glColor3f(0, 0, 1); break;
-	case GRENADE: glColor3f(0.31, 0.59, 0.20); break;
-	case TRAP: glColor3f(0.5, 0.5, 0.5); break;
+	case HEALTH:  state.color(1, 0, 1); break;
+	case ENERGY:  state.color(0, 0, 1); break;
+	case GRENADE: state.color(0.31, 0.59, 0.20); break;
+	case TRAP: state.color(0.5, 0.5, 0.5); break;
     }
 
     //call the superclass
     Entity::render(dt);
+}
 
-    if (!spent) {
-        //if the hero or the haggis land on this cell, activate this item
-        if (level->getHero()->getCell() == getCell()) { //the hero got it
-            level->notifyGeneralAction(new ItemAction(this, level->getHero()));
-            setVisibility(true);
-            spent = true;
-        } else if (level->getHaggis()->getCell() == getCell()) { //the haggis got it
-            level->notifyGeneralAction(new ItemAction(this, level->getHaggis()));
-            setVisibility(true);
-            spent = true;
-        }
+/**
+ * Sets the cell that the item is on. The item listens to the cell so that
+ * it knows when a player steps onto it.
+ */
+void Item::setCell(Cell *cell, bool isPlayer)
+{
+    if (getCell()) {
+        getCell()->removeListener(this);
+    }
+
+    Entity::setCell(cell, isPlayer);
+
+    if (getCell()) {
+        getCell()->addListener(this);
+    }
+}
+
+/**
+ * Called when an entity enters the item's cell. If the entity is the
+ * hero or the haggis, the item is activated.
+ */
+void Item::notifyEnter(Cell *cell, Entity *entity)
+{
+    if (spent || !level) {
+        return;
+    }
+
+    //if the hero or the haggis land on this cell, activate this item
+    if (entity == level->getHero()) { //the hero got it
+        setSpent(true);
+        setVisibility(true);
+        level->notifyGeneralAction(new ItemAction(this, level->getHero()));
+    } else if (entity == level->getHaggis()) { //the haggis got it
+        setSpent(true);
+        setVisibility(true);
+        level->notifyGeneralAction(new ItemAction(this, level->getHaggis()));
     }
 }
 
@@ -124,7 +154,9 @@ void Item::render(float dt)
  */
 void Item::setType(ItemType it)
 {
+    uint64_t key = getHashKey();
     itemType = it;
+    keyChanged(key);
     setMesh(getItemMesh(it));
 }
 
@@ -136,6 +168,39 @@ Item::ItemType Item::getType()
     return itemType;
 }
 
+/**
+ * Returns true if the item has been picked up.
+ */
+bool Item::isSpent()
+{
+    return spent;
+}
+
+/**
+ * Sets whether the item has been picked up, without activating it.
+ */
+void Item::setSpent(bool s)
+{
+    uint64_t key = getHashKey();
+    spent = s;
+    keyChanged(key);
+}
+
+/**
+ * Returns the key of the item on its cell in the hash of the maze's state,
+ * or 0 if it has no cell or has been spent.
+ */
+uint64_t Item::getHashKey()
+{
+    if (!getCell() || spent) {
+        return 0;
+    }
+
+    int i, j;
+    getCell()->getMazePosition(i, j);
+    return Zobrist::itemKey(i, j, itemType);
+}
+
 /**
  * Turns the item into billboard so that it can float.
  */
@@ -12,10 +12,15 @@
 #include "texture.h"
 #include "level.h"
 #include "billboard.h"
+#include "celllistener.h"
 
 #define NUM_ITEMS 4  //number of different item types
 
-class Item : public Entity
+/**
+ * An Item is activated when a player steps onto its cell. It listens to its
+ * cell for players entering, so it costs nothing until somebody moves.
+ */
+class Item : public Entity, public CellListener
 {
 public:
     /**
@@ -34,10 +39,22 @@ public:
     ~Item();
 
     /**
-     * Render the cell.
+     * Render the item.
      */
     void render(float dt);
 
+    /**
+     * Sets the cell that the item is on. The item listens to the cell so that
+     * it knows when a player steps onto it.
+     */
+    virtual void setCell(Cell *cell, bool isPlayer = false);
+
+    /**
+     * Called when an entity enters the item's cell. If the entity is the
+     * hero or the haggis, the item is activated.
+     */
+    virtual void notifyEnter(Cell *cell, Entity *entity);
+
     /**
      * Sets the item type.
      */
@@ -48,6 +65,16 @@ public:
      */
     ItemType getType();
 
+    /**
+     * Returns true if the item has been picked up.
+     */
+    bool isSpent();
+
+    /**
+     * Sets whether the item has been picked up, without activating it.
+     */
+    void setSpent(bool);
+
     /**
      * Create a billboard object with the item texture. The billboard entity
      * initially has the same cell and position as the item. It is the caller's
@@ -55,6 +82,12 @@ public:
      */
     BillBoard *makeBillBoard();
 
+    /**
+     * Returns the key of the item on its cell in the hash of the maze's
+     * state, or 0 if it has no cell or has been spent.
+     */
+    virtual uint64_t getHashKey();
+
  private:
     /**
      * The type of this item.
@@ -11,9 +11,6 @@
 
 #define MOVING_TIME 0.5    //how long the item is moving
 #define FLOATING_TIME 0.5  //how long the item is stationary
-#define HEALTH_INCREASE 4  //by how much the health item increases health
-#define ENERGY_INCREASE 4  //by how much the energy item increases energy
-#define HEALTH_DECREASE 4  //by how much the trap item decreases health
 
 /**
  * Default constructor. Sets the item and the hero.
@@ -30,7 +27,7 @@ ItemAction::ItemAction(Item* i, Player *p)
     }
     else if(item->getType() == Item::GRENADE)
     {
-	player->setAmmo(player->getAmmo()+1);
+	player->setAmmo(player->getAmmo()+AMMO_INCREASE);
     }
     else if(item->getType() == Item::ENERGY)
     {
@@ -13,11 +13,13 @@
 #include "player.h"
 #include "item.h"
 #include "billboard.h"
+#include "pool.h"
+#include "rules.h"
 
 /**
  * The ItemAction class animates an item being picked up by the hero.
  */
-class ItemAction : public Action
+class ItemAction : public Action, public Pooled<ItemAction>
 {
 public:
 
@@ -6,17 +6,12 @@
  ************************************************************************/
 
 #include "jumpaction.h"
+#include "gamerules.h"
+#include "hexcoord.h"
 #include <GL/glu.h>
 
 #define VEL 10.0
 #define ACC -100.0
-#define SELECTABLE_RADIUS_SQ 25.0
-#define CELL_CHECK_RADIUS 4   //approximately selection area
-#define ENERGY 5
-
-//for some stupid compilers
-#define max(x, y) (((x) > (y)) ? (x) : (y))
-#define min(x, y) (((x) < (y)) ? (x) : (y))
 
 /**
  * Constructor.
@@ -65,10 +60,11 @@ bool JumpAction::update(float dt)
     //which it should have by this time, end the action.
     if (t >= T)
     {
-        //move player to new cell
+        //move player to new cell, after taking the energy so that any
+        //item on the cell is applied last
         player->setPosition(initial);
+        player->setEnergy(player->getEnergy() - JUMP_ENERGY);
         player->setCell(dest, true);
-        player->setEnergy(player->getEnergy() - ENERGY);
         return false;
     }
 
@@ -87,7 +83,7 @@ bool JumpAction::update(float dt)
  */
 bool JumpAction::canJump(Player *player)
 {
-    return (player->getEnergy() >= ENERGY);
+    return (player->getEnergy() >= JUMP_ENERGY);
 }
 
 /**
@@ -106,36 +102,38 @@ void JumpAction::markSelectable(Player *player, Maze *maze)
     int pi, pj;
     player->getCell()->getMazePosition(pi, pj);
 
-    // check all adjacent cells
-    const int mini = max(0, pi-CELL_CHECK_RADIUS);
-    const int maxi = min(maze->getHeight()-1, pi+CELL_CHECK_RADIUS);
-    const int minj = max(0, pj-CELL_CHECK_RADIUS);
-    const int maxj = min(maze->getWidth()-1, pj+CELL_CHECK_RADIUS);
-    for(int i = mini; i <= maxi; i++)
+    // check the cells in range. The first offset is the player's own cell.
+    const GridOffset *offsets = HexCoord::getOffsets(pi);
+    const int count = HexCoord::getDiscSize(JUMP_RANGE);
+    for (int k = 1; k < count; k++)
     {
-        for (int j = minj; j <= maxj; j++)
+        int i = pi + offsets[k].di;
+        int j = pj + offsets[k].dj;
+        if ((i < 0) || (i >= maze->getHeight()) ||
+            (j < 0) || (j >= maze->getWidth()))
         {
-            if ((i == pi) && (j == pj))
-            {
-                // can't throw grenade on self
-                continue;
-            }
-
-            //get cell under consideration
-            Cell *c = maze->getCell(i, j);
-
-            //cannot jump onto walls or other players
-            if(c->getWall() || c->hasPlayer() || !c->isVisible())
-                continue;
-
-            //get relative position
-            vector4 relpos = c->getPosition() - player->getCell()->getPosition();
-            relpos.y = 0;
-            //if the cell is in range, make it selectable
-            if(relpos.squaredLength() < SELECTABLE_RADIUS_SQ)
-            {
-                c->setSelectable(true);
-            }
+            // this goes off the edge of the maze
+            continue;
         }
+
+        //get cell under consideration
+        Cell *c = maze->getCell(i, j);
+
+        //cannot jump onto walls or other players
+        if(c->getWall() || c->hasPlayer() || !c->isVisible())
+            continue;
+
+        maze->setSelectable(c);
     }
 }
+
+/**
+ * Set m to the jump to the destination, and return true.
+ */
+bool JumpAction::getMove(Move &m) const
+{
+    int i, j;
+    dest->getMazePosition(i, j);
+    m = Move(Move::JUMP, i, j);
+    return true;
+}
@@ -13,11 +13,13 @@
 #include "cell.h"
 #include "maze.h"
 #include "player.h"
+#include "pool.h"
+#include "rules.h"
 
 /**
  * The JumpAction class makes the player jump.
  */
-class JumpAction : public Action {
+class JumpAction : public Action, public Pooled<JumpAction> {
 public:
     /**
      * Constructor.
@@ -46,6 +48,11 @@ public:
      */
     virtual bool update(float dt);
 
+    /**
+     * Set m to the jump to the destination, and return true.
+     */
+    virtual bool getMove(Move &m) const;
+
 private:
     /**
      * The player that is being moved.
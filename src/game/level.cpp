@@ -11,6 +11,8 @@
 #include "haggis.h"
 #include "walkaction.h"
 #include "grenadeaction.h"
+#include "mctspolicy.h"
+#include "pool.h"
 
 #include <string>
 #include <iostream>
@@ -20,7 +22,8 @@
  * Constructor. Initially, no level is loaded.
  */
 Level::Level()
-    : action(NULL), playerAction(NULL), loaded(false), state(-1)
+    : maze(NULL), hero(NULL), haggis(NULL), action(NULL), playerAction(NULL),
+      loaded(false), cturn(HERO_TURN), state(-1)
 {
 }
 
@@ -77,9 +80,17 @@ void Level::draw(float dt)
                 delete playerAction;
                 playerAction = NULL;
 
-                // notify the haggis that it should make its move
+                // the turn is over, so start counting the allocations
+                // for the next one
+                PoolBase::startTurn();
+                turnChanged();
+
+                // notify the haggis that it should make its move, or
+                // that it can think about its next one
                 if(cturn == HAGGIS_TURN) {
                     haggis->setTurn();
+                } else {
+                    haggis->ponder();
                 }
             }
         }
@@ -117,6 +128,13 @@ void Level::notifyHeroAction(Action *a)
     if ((getCurrentTurn() == HERO_TURN) && (!playerAction)) {
         playerAction = a;
         cturn = HAGGIS_TURN;
+        turnChanged();
+
+        // let the haggis think about its reply while the action runs
+        Move m;
+        if (a->getMove(m)) {
+            haggis->notifyHeroMove(m);
+        }
     }
 }
 
@@ -134,6 +152,7 @@ void Level::notifyHaggisAction(Action *a)
     if((getCurrentTurn() == HAGGIS_TURN) && (!playerAction)) {
         playerAction = a;
         cturn = HERO_TURN;
+        turnChanged();
     }
 }
 
@@ -196,9 +215,13 @@ void Level::load(std::string path)
     hero->setCell(c);
     hero->setPosition(vector4(0, 1, 0));
 
+    // the overlay shows the hero's attributes
+    hero->addListener(overlay);
+
     // create the haggis and put it on its starting cell
 
     haggis = new Haggis(maze, hero);
+    haggis->setPolicy(new MctsPolicy(THINKER_THREADS));
     c = maze->getHaggisCell();
     assert(c != NULL);
     haggis->setCell(c);
@@ -222,6 +245,28 @@ bool Level::isLoaded()
     return loaded;
 }
 
+/**
+ * Skip the level begin screen and display the maze straight away, as if
+ * the user had chosen to start. This method requires that the level is
+ * loaded.
+ */
+void Level::startNow()
+{
+    assert(isLoaded());
+
+    if (state == 0) {
+        startMaze();
+    }
+}
+
+/**
+ * Return the maze. This method requires that the level has been loaded.
+ */
+Maze *Level::getMaze()
+{
+    return maze;
+}
+
 /**
  * Return the hero. This method requires that the level has been loaded.
  */
@@ -250,6 +295,25 @@ Level::turn Level::getCurrentTurn()
     }
 }
 
+/**
+ * Return the turn that follows the running action, or the current turn if
+ * no action is running.
+ */
+Level::turn Level::getNextTurn()
+{
+    return cturn;
+}
+
+/**
+ * Returns the hash of the state of the game: the maze's hash, with whose
+ * turn it is. This method requires that the level has been loaded.
+ */
+uint64_t Level::getHash()
+{
+    assert(isLoaded());
+    return maze->getHash() ^ Zobrist::turnKey(cturn);
+}
+
 /**
  * Sets the size of the window.
  */
@@ -336,6 +400,9 @@ void Level::startMaze()
     overlay->setEnabled(true);
     lend->setEnabled(false);
     state = 1;
+
+    // the hero moves first, so the haggis can start thinking
+    haggis->ponder();
 }
 
 /**
@@ -367,4 +434,15 @@ Action* Level::getPlayerAction()
 void Level::setCurrentTurn(turn t)
 {
     cturn = t;
+    turnChanged();
+}
+
+/**
+ * Tell the overlay that the current turn has changed.
+ */
+void Level::turnChanged()
+{
+    if (isLoaded()) {
+        overlay->notifyTurnChanged();
+    }
 }
@@ -51,6 +51,13 @@ public:
      */
     bool isLoaded();
 
+    /**
+     * Skip the level begin screen and display the maze straight away, as
+     * if the user had chosen to start. This method requires that the level
+     * is loaded.
+     */
+    void startNow();
+
     /**
      * Notify the level that the user has initated an action. This is called
      * by Overlay. This method requires that the level has been loaded. The
@@ -83,11 +90,36 @@ public:
      */
     Haggis *getHaggis();
 
+    /**
+     * Return the maze. This method requires that the level has been loaded.
+     */
+    Maze *getMaze();
+
     /**
      * Return the current turn.
      */
     turn getCurrentTurn();
 
+    /**
+     * Return the turn that follows the running action, or the current turn
+     * if no action is running.
+     */
+    turn getNextTurn();
+
+    /**
+     * Sets the current turn.
+     */
+    void setCurrentTurn(turn);
+
+    /**
+     * Returns the hash of the state of the game: the maze's hash, with
+     * whose turn it is. Levels in the same state have the same hash, so it
+     * can be used to find states that have been seen before. It is kept up
+     * to date as the game is played. This method requires that the level
+     * has been loaded.
+     */
+    uint64_t getHash();
+
     /**
      * Sets the size of the window.
      */
@@ -140,11 +172,6 @@ protected:
      */
     Action *getPlayerAction();
 
-    /**
-     * Sets the current turn.
-     */
-    void setCurrentTurn(turn);
-
 private:
     /**
      * The current action.
@@ -205,6 +232,11 @@ private:
      * Display the level end screen and set the state to 2.
      */
     void startLevelEnd();
+
+    /**
+     * Tell the overlay that the current turn has changed.
+     */
+    void turnChanged();
 };
 
 #endif //LEVEL_H
@@ -21,9 +21,9 @@
 LevelBegin::LevelBegin()
 {
     //load images
-    img = new StaticImage(Texture::load("images/lbegin/msg.png"));
-    btnstart = new Button(Texture::load("images/lbegin/start.png"));
-    btnexit = new Button(Texture::load("images/lbegin/exit.png"));
+    img = new StaticImage(Texture::loadPacked("images/lbegin/msg.png"));
+    btnstart = new Button(Texture::loadPacked("images/lbegin/start.png"));
+    btnexit = new Button(Texture::loadPacked("images/lbegin/exit.png"));
 
     //add children
     addChild(img);
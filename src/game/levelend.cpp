@@ -17,13 +17,13 @@ LevelEnd::LevelEnd()
     //load images
     std::string prefix = "images/lend/";
 
-    imgwon = new StaticImage(Texture::load(prefix + "win.png"));
-    imglost = new StaticImage(Texture::load(prefix + "lose.png"));
+    imgwon = new StaticImage(Texture::loadPacked(prefix + "win.png"));
+    imglost = new StaticImage(Texture::loadPacked(prefix + "lose.png"));
 
-    btnretry = new Button(Texture::load(prefix + "retry.png"));
-    btncont = new Button(Texture::load(prefix + "continue.png"));
+    btnretry = new Button(Texture::loadPacked(prefix + "retry.png"));
+    btncont = new Button(Texture::loadPacked(prefix + "continue.png"));
 
-    exit = new Button(Texture::load(prefix + "exit.png"));
+    exit = new Button(Texture::loadPacked(prefix + "exit.png"));
 
     //add children (buttons)
     addChild(imgwon);
@@ -0,0 +1,177 @@
+/************************************************************************
+ *
+ * levelofdetail.cpp
+ * LevelOfDetail class implementation
+ *
+ ************************************************************************/
+
+#include "levelofdetail.h"
+
+#include <cmath>
+
+#define OUTLINE_DISTANCE 35   // outlines are dropped beyond this distance
+#define FLAT_DISTANCE 60      // only flat tops are drawn beyond this distance
+#define IMPOSTOR_DISTANCE 45  // entities become impostors beyond this distance
+
+/**
+ * Returns the level of detail settings shared by everything that is drawn.
+ */
+LevelOfDetail &LevelOfDetail::getInstance()
+{
+    static LevelOfDetail lod;
+    return lod;
+}
+
+/**
+ * Constructor. The eye is at the origin and the distances have their
+ * default values.
+ */
+LevelOfDetail::LevelOfDetail()
+    : eye(0, 0, 0), outlineDistance(OUTLINE_DISTANCE),
+      flatDistance(FLAT_DISTANCE), impostorDistance(IMPOSTOR_DISTANCE)
+{
+    for (int i=0; i<LOD_COUNT; i++) {
+        triangles[i] = 0;
+        lastTriangles[i] = 0;
+    }
+}
+
+/**
+ * Set the position of the camera in world space.
+ */
+void LevelOfDetail::setEye(vector4 eye)
+{
+    this->eye = eye;
+}
+
+/**
+ * Returns the position of the camera in world space.
+ */
+vector4 LevelOfDetail::getEye()
+{
+    return eye;
+}
+
+/**
+ * Set the distance beyond which cell outlines are not drawn.
+ */
+void LevelOfDetail::setOutlineDistance(float d)
+{
+    outlineDistance = d;
+}
+
+/**
+ * Returns the distance beyond which cell outlines are not drawn.
+ */
+float LevelOfDetail::getOutlineDistance()
+{
+    return outlineDistance;
+}
+
+/**
+ * Set the distance beyond which only the flat tops of cells are drawn.
+ */
+void LevelOfDetail::setFlatDistance(float d)
+{
+    flatDistance = d;
+}
+
+/**
+ * Returns the distance beyond which only the flat tops of cells are drawn.
+ */
+float LevelOfDetail::getFlatDistance()
+{
+    return flatDistance;
+}
+
+/**
+ * Set the distance beyond which entities are drawn as impostors.
+ */
+void LevelOfDetail::setImpostorDistance(float d)
+{
+    impostorDistance = d;
+}
+
+/**
+ * Returns the distance beyond which entities are drawn as impostors.
+ */
+float LevelOfDetail::getImpostorDistance()
+{
+    return impostorDistance;
+}
+
+/**
+ * Returns the level of detail for terrain in the box between min and max,
+ * from the distance of the nearest point of the box to the eye.
+ */
+DetailLevel LevelOfDetail::getTerrainLevel(vector4 min, vector4 max)
+{
+    float d2 = 0;
+    for (int k=0; k<3; k++) {
+        float d = 0;
+        if (eye[k] < min[k]) {
+            d = min[k] - eye[k];
+        } else if (eye[k] > max[k]) {
+            d = eye[k] - max[k];
+        }
+        d2 += d*d;
+    }
+
+    float d = sqrt(d2);
+    if (d > flatDistance) {
+        return LOD_TERRAIN_FLAT;
+    } else if (d > outlineDistance) {
+        return LOD_TERRAIN_NO_OUTLINES;
+    }
+    return LOD_TERRAIN_FULL;
+}
+
+/**
+ * Returns the level of detail for an entity at the point in world space.
+ */
+DetailLevel LevelOfDetail::getEntityLevel(vector4 p)
+{
+    vector4 d = p - eye;
+    if (d.x*d.x + d.y*d.y + d.z*d.z > impostorDistance*impostorDistance) {
+        return LOD_ENTITY_IMPOSTOR;
+    }
+    return LOD_ENTITY_MESH;
+}
+
+/**
+ * Count triangles drawn at a level of detail during the current frame.
+ */
+void LevelOfDetail::addTriangles(DetailLevel level, int n)
+{
+    triangles[level] += n;
+}
+
+/**
+ * Start counting triangles for a new frame. The counts for the frame that
+ * has just finished can be read with getLastFrameTriangles.
+ */
+void LevelOfDetail::startFrame()
+{
+    for (int i=0; i<LOD_COUNT; i++) {
+        lastTriangles[i] = triangles[i];
+        triangles[i] = 0;
+    }
+}
+
+/**
+ * Returns the number of triangles drawn at the level of detail during the
+ * current frame.
+ */
+int LevelOfDetail::getFrameTriangles(DetailLevel level)
+{
+    return triangles[level];
+}
+
+/**
+ * Returns the number of triangles drawn at the level of detail during the
+ * last complete frame.
+ */
+int LevelOfDetail::getLastFrameTriangles(DetailLevel level)
+{
+    return lastTriangles[level];
+}
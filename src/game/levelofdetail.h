@@ -0,0 +1,143 @@
+/************************************************************************
+ *
+ * levelofdetail.h
+ * LevelOfDetail class
+ *
+ ************************************************************************/
+
+#ifndef LEVELOFDETAIL_H
+#define LEVELOFDETAIL_H
+
+#include "vector4.h"
+
+/**
+ * The levels of detail that triangles are counted for. The terrain is drawn
+ * in full near the camera, without outlines further away, and as flat
+ * untextured tops far away. Entities are drawn with their meshes near the
+ * camera and as single quads facing the camera far away.
+ */
+enum DetailLevel
+{
+    LOD_TERRAIN_FULL,
+    LOD_TERRAIN_NO_OUTLINES,
+    LOD_TERRAIN_FLAT,
+    LOD_ENTITY_MESH,
+    LOD_ENTITY_IMPOSTOR,
+    LOD_COUNT
+};
+
+/**
+ * The LevelOfDetail decides how much detail to draw things with, from their
+ * distance to the camera. The distances at which detail is dropped can be
+ * tuned. It also counts the triangles drawn at each level of detail during
+ * a frame.
+ */
+class LevelOfDetail
+{
+public:
+    /**
+     * Returns the level of detail settings shared by everything that is
+     * drawn.
+     */
+    static LevelOfDetail &getInstance();
+
+    /**
+     * Constructor. The eye is at the origin and the distances have their
+     * default values.
+     */
+    LevelOfDetail();
+
+    /**
+     * Set the position of the camera in world space.
+     */
+    void setEye(vector4 eye);
+
+    /**
+     * Returns the position of the camera in world space.
+     */
+    vector4 getEye();
+
+    /**
+     * Set the distance beyond which cell outlines are not drawn.
+     */
+    void setOutlineDistance(float d);
+
+    /**
+     * Returns the distance beyond which cell outlines are not drawn.
+     */
+    float getOutlineDistance();
+
+    /**
+     * Set the distance beyond which only the flat tops of cells are drawn.
+     */
+    void setFlatDistance(float d);
+
+    /**
+     * Returns the distance beyond which only the flat tops of cells are
+     * drawn.
+     */
+    float getFlatDistance();
+
+    /**
+     * Set the distance beyond which entities are drawn as impostors.
+     */
+    void setImpostorDistance(float d);
+
+    /**
+     * Returns the distance beyond which entities are drawn as impostors.
+     */
+    float getImpostorDistance();
+
+    /**
+     * Returns the level of detail for terrain in the box between min and
+     * max, from the distance of the nearest point of the box to the eye.
+     */
+    DetailLevel getTerrainLevel(vector4 min, vector4 max);
+
+    /**
+     * Returns the level of detail for an entity at the point in world space.
+     */
+    DetailLevel getEntityLevel(vector4 p);
+
+    /**
+     * Count triangles drawn at a level of detail during the current frame.
+     */
+    void addTriangles(DetailLevel level, int n);
+
+    /**
+     * Start counting triangles for a new frame. The counts for the frame
+     * that has just finished can be read with getLastFrameTriangles.
+     */
+    void startFrame();
+
+    /**
+     * Returns the number of triangles drawn at the level of detail during
+     * the current frame.
+     */
+    int getFrameTriangles(DetailLevel level);
+
+    /**
+     * Returns the number of triangles drawn at the level of detail during
+     * the last complete frame.
+     */
+    int getLastFrameTriangles(DetailLevel level);
+
+private:
+    /**
+     * The position of the camera.
+     */
+    vector4 eye;
+
+    /**
+     * The distances at which detail is dropped.
+     */
+    float outlineDistance, flatDistance, impostorDistance;
+
+    /**
+     * The triangle counters for the current and last complete frames.
+     */
+    int triangles[LOD_COUNT];
+    int lastTriangles[LOD_COUNT];
+};
+
+#endif //LEVELOFDETAIL_H
@@ -6,6 +6,8 @@
  ************************************************************************/
 
 #include "maze.h"
+#include "renderstate.h"
+#include "levelofdetail.h"
 #include "level.h"
 #include "item.h"
 #include "application.h"  //for app_error
@@ -35,6 +37,10 @@ Maze::Maze()
     zoomOut = false;
     selectionEnabled = false;
     selectedCell = NULL;
+    pickedCell = NULL;
+    pickDirty = true;
+    layoutOrder = CellLayout::ROW_MAJOR;
+    seed = 1;
 }
 
 /**
@@ -49,6 +55,20 @@ Maze::~Maze()
  * Loads the maze from file.
  */
 void Maze::load(std::string fn)
+{
+    std::ifstream fin(fn.c_str());  //open file containing level
+
+    if(!fin)   //make sure a valid filename was sent
+        throw app_error(std::string("Unable to open file: ") + fn);
+
+    load(fin, fn);
+}
+
+/**
+ * Loads the maze from a stream in the same format as a maze file. fn is
+ * the name used in error messages.
+ */
+void Maze::load(std::istream &fin, std::string fn)
 {
     if(bLoaded)   //if something already loaded
         unload();   //free it
@@ -58,11 +78,6 @@ void Maze::load(std::string fn)
     Texture *grass = Texture::load("images/tex/grass.png");
     Texture *dirt = Texture::load("images/tex/dirt.png");
 
-    std::ifstream fin(fn.c_str());  //open file containing level
-
-    if(!fin)   //make sure a valid filename was sent
-        throw app_error(std::string("Unable to open file: ") + fn);
-
     fin >> width;  //read in width
     fin >> height;  //read in height
 
@@ -72,11 +87,18 @@ void Maze::load(std::string fn)
 	throw app_error(fn + std::string(" contains invalid data."));
     }
 
-    //allocate memory for cells
-    cells = new Cell*[height];
-    for (int i=0; i<height; i++)
+    grid.resize(width, height);
+    random.setSeed(seed);
+    layout = CellLayout(layoutOrder);
+    layout.resize(width, height);
+
+    //allocate memory for cells, in the order given by the layout
+    cells = new Cell[layout.getSize()];
+    zobrist.clear();
+    for (int i=0; i<layout.getSize(); i++)
     {
-        cells[i] = new Cell[width];
+        cells[i].setSelectionSets(&selectable, &highlighted);
+        cells[i].setZobrist(&zobrist);
     }
 
     double sinp3 = sin(M_PI/3); //to avoid calculating this repeatedly
@@ -89,7 +111,7 @@ void Maze::load(std::string fn)
             int ctype;     //the cell type
             fin >> ctype;  //read the cell type from file
 
-            cells[i][j].setMazePosition(i, j);
+            getCell(i, j)->setMazePosition(i, j);
             vector4 pos = vector4(1.5*i - 0.75*width,
                                   0,
                                   (2*j+(i%2))*sinp3 - sinp3*height);
@@ -97,58 +119,57 @@ void Maze::load(std::string fn)
             // calculate a height offset
             float rr = pos.squaredLength();
             pos.y = 10.0*exp(-rr/100.0);
-            cells[i][j].setPosition(pos);
+            getCell(i, j)->setPosition(pos);
 
 
-            findCellNeighbours(&cells[i][j]);
             if (ctype == 0)
             {
                 // there is no cell here
-                cells[i][j].setVisible(false);
+                getCell(i, j)->setVisible(false);
             }
             else if (ctype == 2)
             {
                 //if this cell is a wall
-                cells[i][j].setWall(true);
+                getCell(i, j)->setWall(true, random);
             }
             else if (ctype == 3)
             {
                 // this is the starting cell of the hero
-                heroCell = &cells[i][j];
-                cells[i][j].setHasPlayer(true);
+                heroCell = getCell(i, j);
+                getCell(i, j)->setHasPlayer(true);
             }
             else if(ctype == 4)
             {
                 //this is the starting cell of the haggis
-                haggisCell = &cells[i][j];
-                cells[i][j].setHasPlayer(true);
+                haggisCell = getCell(i, j);
+                getCell(i, j)->setHasPlayer(true);
             }
             else if(ctype == 5)
 	    {
                 //this is a health item
                 Item *nitem = new Item(level);
-                nitem->setCell(&cells[i][j]);
+                nitem->setCell(getCell(i, j));
                 nitem->setType(Item::HEALTH);
 	    }
             else if(ctype == 6)
 	    {
                 //this is a energy item
                 Item *nitem = new Item(level);
-                nitem->setCell(&cells[i][j]);
+                nitem->setCell(getCell(i, j));
                 nitem->setType(Item::ENERGY);
             }
             else if(ctype == 7)
 	    {
                 //this is a grenade item
                 Item *nitem = new Item(level);
-                nitem->setCell(&cells[i][j]);
+                nitem->setCell(getCell(i, j));
                 nitem->setType(Item::GRENADE);
             }
 	    else if(ctype == 8)
 	    {
 		//this is a trap
 		Item *nitem = new Item(level);
-                nitem->setCell(&cells[i][j]);
+                nitem->setCell(getCell(i, j));
                 nitem->setType(Item::TRAP);
 	    }
 	    else  if(ctype != 1)//otherwise the data is invalid
@@ -157,13 +178,16 @@ void Maze::load(std::string fn)
 	    }
 
 	    //set the texture based on whether the cell is a wall or not
-            if (cells[i][j].getWall()) {
-                cells[i][j].setTexture(dirt);
+            if (getCell(i, j)->getWall()) {
+                getCell(i, j)->setTexture(dirt);
             } else {
-                cells[i][j].setTexture(grass);
+                getCell(i, j)->setTexture(grass);
             }
         }
     }
+
+    //bake the cells into the terrain
+    terrain.build(this);
 }
 
 /**
@@ -174,18 +198,95 @@ void Maze::unload()
     if(!bLoaded)
         return;    //do not free memory if there is nothing to free
 
-    //free each of the rows of cells
-    for (int i=0; i<height; i++)
-    {
-        delete[] cells[i];
-    }
+    selectable.clear();
+    highlighted.clear();
+    pickedCell = NULL;
+    pickDirty = true;
+    terrain.clear();
 
-    //free the array of pointers
+    //free the cells
     delete [] cells;
+    zobrist.clear();
 
     bLoaded = false;
 }
 
+/**
+ * Set the order the cells are stored in. This takes effect when the maze
+ * is next loaded.
+ */
+void Maze::setLayout(CellLayout::Order order)
+{
+    layoutOrder = order;
+}
+
+/**
+ * Returns the order the cells are stored in.
+ */
+CellLayout::Order Maze::getLayout()
+{
+    return layoutOrder;
+}
+
+/**
+ * Set the seed of the random numbers. This takes effect when the maze is
+ * next loaded, so the same seed gives the same game.
+ */
+void Maze::setSeed(uint32_t seed)
+{
+    this->seed = seed;
+}
+
+/**
+ * Returns the seed of the random numbers.
+ */
+uint32_t Maze::getSeed()
+{
+    return seed;
+}
+
+/**
+ * Returns the random numbers of the game played in the maze.
+ */
+Random &Maze::getRandom()
+{
+    return random;
+}
+
+/**
+ * Returns the hash of the state of the game played in the maze: its walls,
+ * its items and its players. It is kept up to date as the game is played,
+ * so this takes no time.
+ */
+uint64_t Maze::getHash()
+{
+    return zobrist.getHash();
+}
+
+/**
+ * Returns the hash of the state of the game played in the maze, worked out
+ * from the wall of every cell and the entities on it. It is the same as
+ * getHash(), but much slower; it is there to check that the hash has been
+ * kept up to date.
+ */
+uint64_t Maze::computeHash()
+{
+    Zobrist z;
+    for (int i=0; i<height; i++) {
+        for (int j=0; j<width; j++) {
+            Cell *c = getCell(i, j);
+            z.toggle(Zobrist::wallKey(i, j, c->getWallHeight()));
+
+            Cell::EntityList entities = c->getEntities();
+            for (Cell::EntityList::iterator e = entities.begin();
+                 e != entities.end(); e++) {
+                z.toggle((*e)->getHashKey());
+            }
+        }
+    }
+    return z.getHash();
+}
+
 /**
  * Returns the cell the hero initially occupies.
  */
@@ -237,6 +338,13 @@ void Maze::setCellSelectionEnable(bool enabled)
         selectedCell = NULL;
     }
     selectionEnabled = enabled;
+
+    // the selectable cells are reset when selection is disabled
+    if (!enabled) {
+        selectable.clear();
+        highlighted.clear();
+        pickDirty = true;
+    }
 }
 
 /**
@@ -247,6 +355,77 @@ bool Maze::isCellSelectionEnabled()
     return selectionEnabled;
 }
 
+/**
+ * Make the cell selectable. This is called by the actions' markSelectable
+ * methods, so that the maze knows which cells can be picked.
+ */
+void Maze::setSelectable(Cell *cell)
+{
+    if (!selectable.contains(cell)) {
+        selectable.add(cell);
+        pickDirty = true;
+    }
+}
+
+/**
+ * Returns the selectable cell whose top is hit first by the ray from src in
+ * the direction r, or NULL if there is none.
+ */
+Cell *Maze::pickCell(vector4 r, vector4 src)
+{
+    Cell *closest = NULL;
+    vectype closestDist = 600;      //the max viewing distance
+    for (CellSet::const_iterator i=selectable.begin(); i!=selectable.end();
+         i++) {
+        vectype dist;
+        if ((*i)->intersect(r, src, dist) && (dist < closestDist)) {
+            closestDist = dist;
+            closest = *i;
+        }
+    }
+    return closest;
+}
+
+/**
+ * Pick the cell under the mouse again if anything it depends on has
+ * changed.
+ */
+void Maze::updatePick(vector4 mouse, double mvmat[16], double projmat[16],
+                      int viewport[4])
+{
+    bool changed = pickDirty || !(mouse == pickMouse);
+    for (int k=0; (k<16) && !changed; k++) {
+        changed = (mvmat[k] != pickModelview[k]) ||
+            (projmat[k] != pickProjection[k]);
+    }
+    if (!changed) {
+        return;
+    }
+
+    vector4 front, select;
+
+    //unproject a position close to the screen
+    gluUnProject(mouse.x, mouse.y, 0, mvmat, projmat, viewport,
+                 &front.x, &front.y, &front.z);
+
+    //unproject a position far from the screen
+    gluUnProject(mouse.x, mouse.y, 1, mvmat, projmat, viewport,
+                 &select.x, &select.y, &select.z);
+
+    //make select a directed ray from the screen to the back of the
+    //geometry space.
+    select -= front;
+
+    pickedCell = pickCell(select, front);
+
+    pickDirty = false;
+    pickMouse = mouse;
+    for (int k=0; k<16; k++) {
+        pickModelview[k] = mvmat[k];
+        pickProjection[k] = projmat[k];
+    }
+}
+
 /**
  * Returns the last cell selected since cell selection was last enabled.
  * This may be NULL if no cell has been selected yet or if cell selection
@@ -280,7 +459,7 @@ Cell *Maze::getCell(int i, int j)
 {
     assert((i >= 0) && (i < height));
     assert((j >= 0) && (j < width));
-    return &cells[i][j];
+    return &cells[layout.getIndex(i, j)];
 }
 
 /**
@@ -293,9 +472,9 @@ void Maze::draw(float dt)
     //variables needed to store information for the upcoming projections
     double mvmat[16], projmat[16];
     int viewport[4];
-    vector4 front, select;
 
-    glDisable(GL_TEXTURE_2D);
+    RenderState &state = RenderState::getInstance();
+    state.disable(GL_TEXTURE_2D);
 
     glGetIntegerv(GL_VIEWPORT, viewport);
 
@@ -325,20 +504,18 @@ void Maze::draw(float dt)
     //update the camera
     camera.update(dt);
 
-    //set the light at the camera's position
-    float lightpos[] = {0, 1, 0, 1};
-    glLightfv(GL_LIGHT1, GL_POSITION, lightpos);
-    float lightcol[] = {0.5, 0.5, 0.5, 1.0};
-    glLightfv(GL_LIGHT1, GL_DIFFUSE, lightcol);
-    //this is the global light
-    glEnable(GL_LIGHT1);
-
     vector4 focus = level->getHero()->getPosition() +
         level->getHero()->getCell()->getPosition();
     camera.set_focus(focus);
     camera.positionCamera();
+    LevelOfDetail::getInstance().setEye(camera.getPosition());
 
-    glColor3f(1,1,1);
+    //the entities are lit by the sun that is baked into the terrain. This
+    //is the global light
+    Terrain::placeSun(GL_LIGHT1);
+    state.enable(GL_LIGHT1);
+
+    state.color(1,1,1);
  
     //get the necessary matrices to perform an unproject
     glGetDoublev(GL_PROJECTION_MATRIX, projmat);
@@ -346,65 +523,52 @@ void Maze::draw(float dt)
 
     vector4 mp = (getMousePosition() + getAbsolutePosition()) * viewport[3];
 
-    //unproject a position close to the screen
-    gluUnProject(mp.x, mp.y, 0, mvmat, projmat, viewport,
-                 &front.x, &front.y, &front.z);
-
-    //unproject a position far from the screen
-    gluUnProject(mp.x, mp.y, 1, mvmat, projmat, viewport,
-                 &select.x, &select.y, &select.z);
-
-    //make select a directed ray from the screen to the back of the
-    //geometry space.
-    select -= front;
-
-
-    Cell *intersectedCell = NULL;
-
     if (isCellSelectionEnabled()) {
 
-        // test all cells for intersection
-        vectype closestCell = 600;      //the max viewing distance
-        for(int i = 0; i < height; i++) {
-            for (int j=0; j < width; j++) {
-                vectype dist;
-                if(cells[i][j].intersect(select, front, dist)) {
-                    if(dist < closestCell) {
-                        closestCell = dist;
-                        intersectedCell = &cells[i][j];
-                    }
-                }
+        // only the selectable cells are picked, and only when the mouse,
+        // the camera or the selectable cells have changed
+        updatePick(mp, mvmat, projmat, viewport);
+        Cell *intersectedCell = pickedCell;
+
+        // if the mouse has moved onto another cell, change the highlight.
+        // Only the cells that change are recoloured.
+        if ((intersectedCell == NULL) ||
+            !highlighted.contains(intersectedCell)) {
+            highlighted.clear();
+            if (intersectedCell != NULL) {
+                highlighted.add(intersectedCell);
             }
         }
 
-        // if the mouse has been clicked, possibly select the cell
+        // if the mouse has been clicked, select the cell
         if ((intersectedCell != NULL) && bLeftClicked) {
-            if (intersectedCell->isSelectable()) {
-                selectedCell = intersectedCell;
-                bLeftClicked = false;
-            }
+            selectedCell = intersectedCell;
+            bLeftClicked = false;
         }
     }
 
-    glEnable(GL_LIGHTING);
+    //the cells have their static lighting baked in, and only the lights
+    //of the hero and the haggis are added to them
+    terrain.clearLights();
+    Hero *hero = level->getHero();
+    terrain.addLight(GL_LIGHT2, hero->getCell()->getPosition() +
+                     hero->getPosition());
+    Haggis *haggis = level->getHaggis();
+    if (haggis && haggis->getCell()) {
+        terrain.addLight(GL_LIGHT3, haggis->getCell()->getPosition() +
+                         haggis->getPosition());
+    }
 
-    //render cells
+    //render the cells, then everything on them
+    terrain.render();
+    state.enable(GL_LIGHTING);
     for(int i = 0; i < height; i++) {
         for (int j=0; j < width; j++) {
-            //if the mouse is over the cell, change its color.
-            cells[i][j].setHighlighted(intersectedCell == &cells[i][j]);
-
-            //if selection is not enabled, make all cells unselectable
-            if (!isCellSelectionEnabled()) {
-                cells[i][j].setSelectable(false);
-            }
-
-            //render the cell
-            cells[i][j].render(dt);
+            getCell(i, j)->render(dt);
         }
     }
 
-    glDisable(GL_LIGHTING);
+    state.disable(GL_LIGHTING);
     bLeftClicked = false;
 }
 
@@ -446,55 +610,39 @@ bool Maze::onHandleButtonEvent(ButtonEvent event)
 }
 
 /**
- * On initialization of the maze, each cell knows what its neighbours
- * are, to make path-finding in the maze easier.
+ * Returns how the cells of the maze are joined.
  */
-void Maze::findCellNeighbours(Cell* cell)
+const MazeGrid &Maze::getGrid()
 {
-    int pi, pj;
-    cell->getMazePosition(pi, pj);
-
-    // check all adjacent cells
-    for (int i=0; i<3; i++)
-    {
-        for (int j=0; j<3; j++)
-        {
-            if ((i == 1) && (j == 1))
-            {
-                // the current cell is not its own neighbour
-                continue;
-            }
-
-            // adjacent cell coordinates
-            int ni = pi + i-1;
-            int nj = pj + j-1;
+    return grid;
+}
 
-            if ((ni < 0) || (ni >= getHeight()) ||
-                (nj < 0) || (nj >= getWidth()))
-            {
-                // this goes off the edge of the maze
-                continue;
-            }
+/**
+ * Returns neighbour k of the cell, or NULL if it is off the edge of the
+ * maze.
+ */
+Cell *Maze::getNeighbour(Cell *cell, int k)
+{
+    int i, j, ni, nj;
+    cell->getMazePosition(i, j);
+    if (!grid.getNeighbour(i, j, k, ni, nj)) {
+        return NULL;
+    }
+    return getCell(ni, nj);
+}
 
-            if (pi % 2 == 0)
-            {
-                // even row
-                if ((i != 1) && (j == 2))
-                {
-                    continue;
-                }
-            }
-            else
-            {
-                // odd row
-                if ((i != 1) && (j == 0))
-                {
-                    continue;
-                }
-            }
+/**
+ * Returns the terrain that draws the cells.
+ */
+Terrain *Maze::getTerrain()
+{
+    return &terrain;
+}
 
-            //ni, nj is a neighbour
-            cell->neighbours.push_back(getCell(ni, nj));
-        }
-    }
+/**
+ * Returns the camera that views the maze.
+ */
+Camera *Maze::getCamera()
+{
+    return &camera;
 }
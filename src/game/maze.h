@@ -9,21 +9,42 @@
 #define MAZE_H
 
 #include <string>   //for filename
+#include <istream>
+#include <vector>
 
 //classes necessary in this class
 #include "cell.h"
+#include "cellset.h"
+#include "grid.h"
+#include "celllayout.h"
+#include "terrain.h"
 #include "window.h"
 #include "camera.h"
 #include "texture.h"
+#include "random.h"
 
 class Level;
 
 class Maze : public Window
 {
  private:
-    Cell** cells;
+    Cell* cells;
     int width, height;
 
+    /**
+     * Where each cell is stored in the cells array, and the order to use
+     * when the maze is next loaded.
+     */
+    CellLayout layout;
+    CellLayout::Order layoutOrder;
+
+    /**
+     * The random numbers of the game played in the maze, and the seed they
+     * start from when the maze is next loaded.
+     */
+    Random random;
+    uint32_t seed;
+
     Cell *heroCell;
     Cell *haggisCell;  //the cell the haggis initially occupies.
     bool bLoaded;   //true if maze is loaded
@@ -60,6 +81,48 @@ class Maze : public Window
      */
     Cell *selectedCell;
 
+    /**
+     * The terrain that draws the cells.
+     */
+    Terrain terrain;
+
+    /**
+     * How the cells are joined. The neighbours of a cell are worked out
+     * from its position when they are needed.
+     */
+    MazeGrid grid;
+
+    /**
+     * The cells made selectable since cell selection was last disabled,
+     * which are the only cells picked with the mouse, and the cell under
+     * the mouse. The cells ask these sets for their state.
+     */
+    CellSet selectable;
+    CellSet highlighted;
+
+    /**
+     * The hash of the state of the game played in the maze. The cells and
+     * the entities on them keep it up to date as they change.
+     */
+    Zobrist zobrist;
+
+    /**
+     * The cell under the mouse, and what it was picked with. The cell is
+     * only picked again when the mouse, the camera or the selectable cells
+     * change.
+     */
+    Cell *pickedCell;
+    bool pickDirty;
+    vector4 pickMouse;
+    double pickModelview[16], pickProjection[16];
+
+    /**
+     * Pick the cell under the mouse again if anything it depends on has
+     * changed.
+     */
+    void updatePick(vector4 mouse, double mvmat[16], double projmat[16],
+                    int viewport[4]);
+
  public:
     Maze();
     virtual ~Maze();
@@ -67,6 +130,53 @@ class Maze : public Window
     void load(std::string);  //loads maze from file
     void unload();
 
+    /**
+     * Loads the maze from a stream in the same format as a maze file. The
+     * name is used in error messages.
+     */
+    void load(std::istream &in, std::string name);
+
+    /**
+     * Set the order the cells are stored in. This takes effect when the
+     * maze is next loaded.
+     */
+    void setLayout(CellLayout::Order order);
+
+    /**
+     * Returns the order the cells are stored in.
+     */
+    CellLayout::Order getLayout();
+
+    /**
+     * Set the seed of the random numbers. This takes effect when the maze
+     * is next loaded, so the same seed gives the same game.
+     */
+    void setSeed(uint32_t seed);
+
+    /**
+     * Returns the seed of the random numbers.
+     */
+    uint32_t getSeed();
+
+    /**
+     * Returns the random numbers of the game played in the maze. The wall
+     * heights and the haggis' choices are taken from these.
+     */
+    Random &getRandom();
+
+    /**
+     * Returns the hash of the state of the game played in the maze: its
+     * walls, its items and its players. It is kept up to date as the game
+     * is played, so this takes no time.
+     */
+    uint64_t getHash();
+
+    /**
+     * Returns the hash of the state of the game played in the maze, worked
+     * out from every cell. It is the same as getHash(), but much slower.
+     */
+    uint64_t computeHash();
+
     /**
      * Returns the cell that the hero initially occupies. This may be NULL
      * if the hero cell was not set in the level file.
@@ -104,6 +214,18 @@ class Maze : public Window
      */
     bool isCellSelectionEnabled();
 
+    /**
+     * Make the cell selectable. This is called by the actions' markSelectable
+     * methods, so that the maze knows which cells can be picked.
+     */
+    void setSelectable(Cell *cell);
+
+    /**
+     * Returns the selectable cell whose top is hit first by the ray from
+     * src in the direction r, or NULL if there is none.
+     */
+    Cell *pickCell(vector4 r, vector4 src);
+
     /**
      * Returns the last cell selected since cell selection was last enabled.
      * This may be NULL if no cell has been selected yet or if cell selection
@@ -126,11 +248,28 @@ class Maze : public Window
      * column.
      */
     Cell *getCell(int i, int j);
+
+    /**
+     * Returns the terrain that draws the cells.
+     */
+    Terrain *getTerrain();
+
+    /**
+     * Returns the camera that views the maze.
+     */
+    Camera *getCamera();
     
     /**
-     * Calculates the neighbours of the cell, and stores them.
+     * Returns how the cells of the maze are joined.
+     */
+    const MazeGrid &getGrid();
+
+    /**
+     * Returns neighbour k of the cell, where k is less than
+     * MazeGrid::getNeighbourCount(), or NULL if it is off the edge of the
+     * maze.
      */
-    void findCellNeighbours(Cell*);
+    Cell *getNeighbour(Cell *cell, int k);
 
 protected:
     /**
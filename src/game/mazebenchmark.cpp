@@ -0,0 +1,141 @@
+/************************************************************************
+ *
+ * mazebenchmark.cpp
+ * MazeBenchmark class implementation
+ *
+ ************************************************************************/
+
+#include "mazebenchmark.h"
+#include "hexcoord.h"
+
+#include <sstream>
+#include <ctime>
+
+#define BENCHMARK_SEARCHES 20  // the number of searches that are timed
+#define BENCHMARK_SCANS 5      // the number of times the maze is scanned
+#define BENCHMARK_RANGE 3      // the number of steps the scans reach
+
+/**
+ * Tells the search which cells can be walked on.
+ */
+struct BenchmarkWalkable
+{
+    Maze *maze;
+
+    BenchmarkWalkable(Maze *maze)
+        : maze(maze)
+    {
+    }
+
+    bool operator()(int i, int j) const
+    {
+        Cell *c = maze->getCell(i, j);
+        return !c->getWall() && c->isVisible();
+    }
+};
+
+/**
+ * Constructor. The benchmark uses a square maze with the given number of
+ * cells along each side.
+ */
+MazeBenchmark::MazeBenchmark(int size)
+    : size(size)
+{
+}
+
+/**
+ * Run the benchmark for each layout and print the results.
+ */
+void MazeBenchmark::run(std::ostream &out)
+{
+    const CellLayout::Order orders[] = {CellLayout::ROW_MAJOR,
+                                        CellLayout::TILED};
+    const char *names[] = {"row-major", "tiled"};
+
+    out << "Layout benchmark: " << size << "x" << size << " maze" << std::endl;
+    for (int i=0; i<2; i++) {
+        Maze maze;
+        maze.setLayout(orders[i]);
+        generate(maze);
+
+        out << "   " << names[i] << ": "
+            << timeSearch(maze) / 1e6 << " million cells/s searched, "
+            << timeRangeScan(maze) / 1e6 << " million cells/s scanned"
+            << std::endl;
+    }
+}
+
+/**
+ * Returns the number of cells visited per second by breadth-first searches
+ * from the middle of the maze.
+ */
+double MazeBenchmark::timeSearch(Maze &maze)
+{
+    std::vector<int> order, parents;
+    double visited = 0;
+
+    clock_t start = clock();
+    for (int n=0; n<BENCHMARK_SEARCHES; n++) {
+        maze.getGrid().search(size/2, size/2 + n, BenchmarkWalkable(&maze),
+                              order, parents);
+        visited += order.size();
+    }
+    double seconds = double(clock() - start) / CLOCKS_PER_SEC;
+
+    return (seconds > 0) ? visited / seconds : 0;
+}
+
+/**
+ * Returns the number of cells visited per second by scanning the cells
+ * within range of every cell of the maze.
+ */
+double MazeBenchmark::timeRangeScan(Maze &maze)
+{
+    const int count = HexCoord::getDiscSize(BENCHMARK_RANGE);
+    double visited = 0;
+    int open = 0;
+
+    clock_t start = clock();
+    for (int n=0; n<BENCHMARK_SCANS; n++) {
+        for (int i=0; i<size; i++) {
+            const GridOffset *offsets = HexCoord::getOffsets(i);
+            for (int j=0; j<size; j++) {
+                for (int k=1; k<count; k++) {
+                    int ni = i + offsets[k].di;
+                    int nj = j + offsets[k].dj;
+                    if ((ni < 0) || (ni >= size) || (nj < 0) || (nj >= size)) {
+                        continue;
+                    }
+                    if (!maze.getCell(ni, nj)->getWall()) {
+                        open++;
+                    }
+                    visited++;
+                }
+            }
+        }
+    }
+    double seconds = double(clock() - start) / CLOCKS_PER_SEC;
+
+    // the count is used so that the scan is not optimised away
+    if (open < 0) {
+        return 0;
+    }
+    return (seconds > 0) ? visited / seconds : 0;
+}
+
+/**
+ * Load an open maze with a scattering of walls. The walls are placed the
+ * same way every time, so that the layouts are compared on the same maze.
+ */
+void MazeBenchmark::generate(Maze &maze)
+{
+    std::stringstream s;
+    s << size << " " << size << std::endl;
+    for (int i=0; i<size; i++) {
+        for (int j=0; j<size; j++) {
+            s << (((i*7 + j*13) % 11 == 0) ? 2 : 1) << " ";
+        }
+        s << std::endl;
+    }
+    maze.load(s, "benchmark maze");
+}
@@ -0,0 +1,62 @@
+/************************************************************************
+ *
+ * mazebenchmark.h
+ * MazeBenchmark class
+ *
+ ************************************************************************/
+
+#ifndef MAZEBENCHMARK_H
+#define MAZEBENCHMARK_H
+
+#include "maze.h"
+
+#include <ostream>
+
+/**
+ * The MazeBenchmark compares how quickly the cells of a large maze can be
+ * searched when they are stored in each CellLayout. It times the two ways
+ * the game walks through the maze: the breadth-first search that the
+ * haggis uses to find a path, and the scans of the cells in range of a
+ * player that the actions use to mark cells selectable.
+ *
+ * It does not need a window, and is run with --layout-benchmark.
+ */
+class MazeBenchmark
+{
+public:
+    /**
+     * Constructor. The benchmark uses a square maze with the given number
+     * of cells along each side, up to the largest size a maze can be.
+     */
+    MazeBenchmark(int size);
+
+    /**
+     * Run the benchmark for each layout and print the results.
+     */
+    void run(std::ostream &out);
+
+    /**
+     * Returns the number of cells visited per second by breadth-first
+     * searches from the middle of the maze.
+     */
+    double timeSearch(Maze &maze);
+
+    /**
+     * Returns the number of cells visited per second by scanning the cells
+     * within three steps of every cell of the maze.
+     */
+    double timeRangeScan(Maze &maze);
+
+private:
+    /**
+     * The number of cells along each side of the maze.
+     */
+    int size;
+
+    /**
+     * Load an open maze with a scattering of walls.
+     */
+    void generate(Maze &maze);
+};
+
+#endif //MAZEBENCHMARK_H
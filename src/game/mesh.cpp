@@ -89,6 +89,32 @@ void Mesh::render(int beginType)
     glEnd();
 }
 
+/**
+ * Returns the number of points in the mesh.
+ */
+int Mesh::getNumPoints()
+{
+    return numPoints;
+}
+
+/**
+ * Returns the largest distance of a point from the origin along any axis,
+ * which is half the size of a box around the mesh.
+ */
+float Mesh::getExtent()
+{
+    float e = 0;
+    for (int i = 0; i < numPoints; i++)
+    {
+        for (int k = 0; k < 3; k++)
+        {
+            float d = (points[i][k] < 0) ? -points[i][k] : points[i][k];
+            e = (d > e) ? d : e;
+        }
+    }
+    return e;
+}
+
 /**
  * Sets the normal for a given point idx to n
  */
@@ -39,6 +39,17 @@ class Mesh
         return points[i];
     }
 
+    /**
+     * Returns the number of points in the mesh.
+     */
+    int getNumPoints();
+
+    /**
+     * Returns the largest distance of a point from the origin along any
+     * axis, which is half the size of a box around the mesh.
+     */
+    float getExtent();
+
     //sets the normal for a given point
     void setNormal(int, vector4);
 
@@ -12,6 +12,10 @@
 #include "grenadeaction.h"
 #include "jumpaction.h"
 #include "psychicaction.h"
+#include "renderstate.h"
+#include "uibatch.h"
+
+#include <GL/gl.h>
 
 #include <iostream>
 
@@ -22,11 +26,11 @@ Overlay::Overlay()
 {
     // Create action buttons
 
-    actions.push_back(new Button(Texture::load("images/overlay/waitaction.png")));
-    actions.push_back(new Button(Texture::load("images/overlay/stepaction.png")));
-    actions.push_back(new Button(Texture::load("images/overlay/jumpaction.png")));
-    actions.push_back(new Button(Texture::load("images/overlay/grenadeaction.png")));
-    actions.push_back(new Button(Texture::load("images/overlay/psychicaction.png")));
+    actions.push_back(new Button(Texture::loadPacked("images/overlay/waitaction.png")));
+    actions.push_back(new Button(Texture::loadPacked("images/overlay/stepaction.png")));
+    actions.push_back(new Button(Texture::loadPacked("images/overlay/jumpaction.png")));
+    actions.push_back(new Button(Texture::loadPacked("images/overlay/grenadeaction.png")));
+    actions.push_back(new Button(Texture::loadPacked("images/overlay/psychicaction.png")));
 
     for (std::vector<Button*>::iterator i=actions.begin(); i != actions.end();
          i++)
@@ -36,25 +40,25 @@ Overlay::Overlay()
 
     // Create the exit button
 
-    btnexit = new Button(Texture::load("images/overlay/exitaction.png"));
+    btnexit = new Button(Texture::loadPacked("images/overlay/exitaction.png"));
     addChild(btnexit);
 
     // Create turn status labels
 
-    heroturn = new StaticImage(Texture::load("images/overlay/playerturn.png"));
+    heroturn = new StaticImage(Texture::loadPacked("images/overlay/playerturn.png"));
     addChild(heroturn);
 
-    haggisturn = new StaticImage(Texture::load("images/overlay/haggisturn.png"));
+    haggisturn = new StaticImage(Texture::loadPacked("images/overlay/haggisturn.png"));
     addChild(haggisturn);
 
-    actionturn = new StaticImage(Texture::load("images/overlay/actionturn.png"));
+    actionturn = new StaticImage(Texture::loadPacked("images/overlay/actionturn.png"));
     addChild(actionturn);
 
     // Create attribute labels
 
-    labels.push_back(new StaticImage(Texture::load("images/overlay/health.png")));
-    labels.push_back(new StaticImage(Texture::load("images/overlay/energy.png")));
-    labels.push_back(new StaticImage(Texture::load("images/overlay/ammo.png")));
+    labels.push_back(new StaticImage(Texture::loadPacked("images/overlay/health.png")));
+    labels.push_back(new StaticImage(Texture::loadPacked("images/overlay/energy.png")));
+    labels.push_back(new StaticImage(Texture::loadPacked("images/overlay/ammo.png")));
 
     for (std::vector<StaticImage*>::iterator i=labels.begin(); i!=labels.end();
          i++) {
@@ -73,6 +77,9 @@ Overlay::Overlay()
     level = NULL;
     maze = NULL;
     state = NORMAL;
+    statsDirty = turnDirty = listDirty = true;
+    list = 0;
+    hovered = -1;
 }
 
 /**
@@ -104,6 +111,10 @@ Overlay::~Overlay()
 
     // destroy the exit button
     delete btnexit;
+
+    if (list) {
+        glDeleteLists(list, 1);
+    }
 }
 
 /**
@@ -193,6 +204,8 @@ void Overlay::setSize(vector4 size)
         bars[i]->setSize(lsize);
         pos.x += w;
     }
+
+    listDirty = true;
 }
 
 /**
@@ -204,36 +217,111 @@ bool Overlay::shouldExit()
 }
 
 /**
- * Draw the overlay and processes button events.
+ * Render the overlay. Button events are processed every time, but the
+ * widgets are only drawn again if something has changed since the last
+ * time.
  */
-void Overlay::draw(float dt)
+void Overlay::render(int pass, float dt)
 {
-    // update the current turn label
+    if (!isEnabled() || !(getRenderPasses() & pass)) {
+        Window::render(pass, dt);
+        return;
+    }
 
-    Level::turn t = level->getCurrentTurn();
+    update();
+
+    // anything batched before the overlay must be drawn first, and the
+    // overlay's own widgets must be drawn inside the display list
+    UIBatch &batch = UIBatch::getInstance();
+    batch.flush();
+
+    if (listDirty || !list) {
+        if (!list) {
+            list = glGenLists(1);
+        }
+
+        // the list must set every state it needs when it is called
+        RenderState::getInstance().invalidate();
+
+        glNewList(list, GL_COMPILE_AND_EXECUTE);
+        Window::render(pass, dt);
+        batch.flush();
+        glEndList();
+
+        listDirty = false;
+    } else {
+        glCallList(list);
+        RenderState::getInstance().invalidate();
+    }
+
+    // the display list may have changed the projection matrix
+    forgetProjection();
+}
+
+/**
+ * Returns true, since the overlay renders its widgets into a display list
+ * itself.
+ */
+bool Overlay::rendersChildren()
+{
+    return true;
+}
+
+/**
+ * Called when the hero's attributes change.
+ */
+void Overlay::notifyStatsChanged(Player *player)
+{
+    statsDirty = true;
+}
 
-    bool herot = (t == Level::HERO_TURN);
+/**
+ * Called by the level when the current turn changes.
+ */
+void Overlay::notifyTurnChanged()
+{
+    turnDirty = true;
+}
+
+/**
+ * Update the widgets if the hero's attributes or the turn have changed,
+ * and process button events.
+ */
+void Overlay::update()
+{
+    Level::turn t = level->getCurrentTurn();
     bool haggist = (t == Level::HAGGIS_TURN);
-    bool actiont = (t == Level::ACTION_TURN);
 
-    heroturn->setEnabled(herot);
-    haggisturn->setEnabled(haggist);
-    actionturn->setEnabled(actiont);
+    // update the current turn label
+
+    if (turnDirty) {
+        heroturn->setEnabled(t == Level::HERO_TURN);
+        haggisturn->setEnabled(haggist);
+        actionturn->setEnabled(t == Level::ACTION_TURN);
+
+        turnDirty = false;
+        listDirty = true;
+    }
+
+    if (statsDirty) {
+        // update the progress bars
 
-    // update the progress bars
+        Hero *h = level->getHero();
+        bars[0]->setProgress((float) h->getHealth() / (float) h->getMaxStat());
+        bars[1]->setProgress((float) h->getEnergy() / (float) h->getMaxStat());
+        bars[2]->setProgress((float) h->getAmmo() / (float) h->getMaxStat());
 
-    Hero *h = level->getHero();
-    bars[0]->setProgress((float) h->getHealth() / (float) h->getMaxStat());
-    bars[1]->setProgress((float) h->getEnergy() / (float) h->getMaxStat());
-    bars[2]->setProgress((float) h->getAmmo() / (float) h->getMaxStat());
+        // update the action buttons
 
-    // update the action buttons
+        actions[0]->setEnabled(WaitAction::canWait(h));
+        actions[1]->setEnabled(WalkAction::canWalk(h));
+        actions[2]->setEnabled(JumpAction::canJump(h));
+        actions[3]->setEnabled(GrenadeAction::canThrow(h));
+        actions[4]->setEnabled(PsychicAction::canPsychic(h));
 
-    actions[0]->setEnabled(WaitAction::canWait(h));
-    actions[1]->setEnabled(WalkAction::canWalk(h));
-    actions[2]->setEnabled(JumpAction::canJump(h));
-    actions[3]->setEnabled(GrenadeAction::canThrow(h));
-    actions[4]->setEnabled(PsychicAction::canPsychic(h));
+        statsDirty = false;
+        listDirty = true;
+    }
 
     // do something depending on the state
     // check for action button presses
@@ -269,6 +357,32 @@ void Overlay::draw(float dt)
     }
 }
 
+/**
+ * Marks the hovered button when the mouse moves, so that the overlay is
+ * drawn again if it changed. The event is not handled so that it still
+ * reaches the maze.
+ */
+bool Overlay::onHandleMouseEvent(MouseEvent event)
+{
+    int h = -1;
+    for (int i=0; i<(int)actions.size(); i++) {
+        if (actions[i]->isInside(event.getPosition() -
+                                 actions[i]->getPosition())) {
+            h = i;
+        }
+    }
+    if (btnexit->isInside(event.getPosition() - btnexit->getPosition())) {
+        h = (int) actions.size();
+    }
+
+    if (h != hovered) {
+        hovered = h;
+        listDirty = true;
+    }
+
+    return false;
+}
+
 /**
  * Looks at which button has been pressed and determines what
  * needs to be done next. Called from draw.
@@ -324,6 +438,7 @@ void Overlay::getCellSelection(int act)
     maze->setCellSelectionEnable(true);
     state = WAITING_FOR_CELL;
     actions[act]->setToggle(true);
+    listDirty = true;
 }
 
 /**
@@ -364,4 +479,5 @@ void Overlay::handleCellSelection()
     {
         actions[i]->setToggle(false);
     }
+    listDirty = true;
 }
@@ -13,15 +13,18 @@
 #include "staticimage.h"
 #include "maze.h"
 #include "progressbar.h"
+#include "playerlistener.h"
 
 #include <vector>
 
 class Level;
 
 /**
- * The Overlay contains the user interface for the maze.
+ * The Overlay contains the user interface for the maze. The widgets are only
+ * updated when the hero's attributes or the current turn change, and the
+ * rendered overlay is kept in a display list until something changes.
  */
-class Overlay : public Window
+class Overlay : public Window, public PlayerListener
 {
 public:
     /**
@@ -55,11 +58,41 @@ public:
      */
     bool shouldExit();
 
+    /**
+     * Render the overlay. Button events are processed every time, but the
+     * widgets are only drawn again if something has changed since the last
+     * time.
+     */
+    virtual void render(int pass, float dt);
+
+    /**
+     * Called when the hero's attributes change.
+     */
+    virtual void notifyStatsChanged(Player *player);
+
+    /**
+     * Called by the level when the current turn changes.
+     */
+    void notifyTurnChanged();
+
 protected:
     /**
-     * Draw the overlay and processes button events.
+     * Returns true, since the overlay renders its widgets into a display
+     * list itself.
+     */
+    virtual bool rendersChildren();
+
+    /**
+     * Update the widgets if the hero's attributes or the turn have changed,
+     * and process button events.
+     */
+    void update();
+
+    /**
+     * Marks the hovered button when the mouse moves, so that the overlay is
+     * drawn again if it changed.
      */
-    virtual void draw(float dt);
+    virtual bool onHandleMouseEvent(MouseEvent event);
 
     /**
      * Looks at which button has been pressed and determines what
@@ -118,6 +151,33 @@ private:
      */
     int action;
 
+    /**
+     * True if the hero's attributes have changed since the widgets were
+     * last updated.
+     */
+    bool statsDirty;
+
+    /**
+     * True if the turn has changed since the widgets were last updated.
+     */
+    bool turnDirty;
+
+    /**
+     * True if the display list must be compiled again.
+     */
+    bool listDirty;
+
+    /**
+     * The display list holding the rendered overlay. It is 0 if it has not
+     * been created yet.
+     */
+    unsigned int list;
+
+    /**
+     * The index of the action button under the mouse, or -1 if there is none.
+     */
+    int hovered;
+
     /**
      * Setup the maze to allow the user to select a cell. The state is
      * changed to WAITING_FOR_CELL. The current action is changed to act.
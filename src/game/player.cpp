@@ -14,6 +14,7 @@
  * Initially, all attributes are set to their maximum.
  */
 Player::Player()
+    : side(Zobrist::HERO)
 {
     health = energy = getMaxStat();
     ammo = getMaxStat();
@@ -24,6 +25,8 @@ Player::Player()
  */
 Player::~Player()
 {
+    // take the player's key out of the hash while it is still a player
+    setCell(NULL);
 }
 
 /**
@@ -39,7 +42,13 @@ int Player::getHealth()
  */
 void Player::setHealth(int health)
 {
-    this->health = std::max(std::min(health, getMaxStat()), 0);
+    health = std::max(std::min(health, getMaxStat()), 0);
+    if (health != this->health) {
+        uint64_t key = getHashKey();
+        this->health = health;
+        keyChanged(key);
+        statsChanged();
+    }
 }
 
 /**
@@ -55,7 +64,13 @@ int Player::getEnergy()
  */
 void Player::setEnergy(int energy)
 {
-    this->energy = std::max(std::min(energy, getMaxStat()), 0);
+    energy = std::max(std::min(energy, getMaxStat()), 0);
+    if (energy != this->energy) {
+        uint64_t key = getHashKey();
+        this->energy = energy;
+        keyChanged(key);
+        statsChanged();
+    }
 }
 
 /**
@@ -72,7 +87,13 @@ int Player::getAmmo()
  */
 void Player::setAmmo(int ammo)
 {
-    this->ammo = std::max(std::min(ammo, getMaxStat()), 0);
+    ammo = std::max(std::min(ammo, getMaxStat()), 0);
+    if (ammo != this->ammo) {
+        uint64_t key = getHashKey();
+        this->ammo = ammo;
+        keyChanged(key);
+        statsChanged();
+    }
 }
 
 /**
@@ -80,7 +101,7 @@ void Player::setAmmo(int ammo)
  */
 int Player::getMaxStat()
 {
-    return 16;
+    return MAX_STAT;
 }
 
 /**
@@ -91,3 +112,54 @@ bool Player::isDead()
 {
     return (getEnergy() <= 0) || (getHealth() <= 0);
 }
+
+/**
+ * Add a listener to be notified when the player's attributes change.
+ * The player does not take ownership of the listener.
+ */
+void Player::addListener(PlayerListener *listener)
+{
+    listeners.push_back(listener);
+}
+
+/**
+ * Remove a listener that was added with addListener().
+ */
+void Player::removeListener(PlayerListener *listener)
+{
+    for (std::vector<PlayerListener*>::iterator i=listeners.begin();
+         i != listeners.end(); i++) {
+        if (*i == listener) {
+            listeners.erase(i);
+            return;
+        }
+    }
+}
+
+/**
+ * Returns the key of the player's cell and statistics in the hash of the
+ * maze's state, or 0 if it has no cell.
+ */
+uint64_t Player::getHashKey()
+{
+    if (!getCell()) {
+        return 0;
+    }
+
+    int i, j;
+    getCell()->getMazePosition(i, j);
+    return Zobrist::playerKey(side, i, j) ^
+        Zobrist::statKey(side, Zobrist::HEALTH, health) ^
+        Zobrist::statKey(side, Zobrist::ENERGY, energy) ^
+        Zobrist::statKey(side, Zobrist::AMMO, ammo);
+}
+
+/**
+ * Notify the listeners that an attribute has changed.
+ */
+void Player::statsChanged()
+{
+    for (unsigned i=0; i<listeners.size(); i++) {
+        listeners[i]->notifyStatsChanged(this);
+    }
+}
@@ -10,12 +10,17 @@
 
 #include "vector4.h"
 #include "entity.h"
+#include "playerlistener.h"
+
+#include "rules.h"
+
+#include <vector>
 
 /**
  * The Player represents either the user or the haggis. It stores the
  * player attributes like health, energy and ammunition. Each attribute is
  * an integer in the range [0, maxstat] where maxstat is the number returned
- * by getMaxStat().
+ * by getMaxStat(). Listeners are notified whenever an attribute changes.
  */
 class Player : public Entity {
 public:
@@ -73,6 +78,30 @@ public:
      */
     bool isDead();
 
+    /**
+     * Add a listener to be notified when the player's attributes change.
+     * The player does not take ownership of the listener.
+     */
+    void addListener(PlayerListener *listener);
+
+    /**
+     * Remove a listener that was added with addListener().
+     */
+    void removeListener(PlayerListener *listener);
+
+    /**
+     * Returns the key of the player's cell and statistics in the hash of
+     * the maze's state, or 0 if it has no cell.
+     */
+    virtual uint64_t getHashKey();
+
+protected:
+    /**
+     * The side the player is on in the hash of the maze's state. It is the
+     * hero's unless a subclass says otherwise.
+     */
+    Zobrist::Side side;
+
 private:
     /**
      * The player's health.
@@ -88,6 +117,16 @@ private:
      * The number of grenade the player has.
      */
     int ammo;
+
+    /**
+     * The listeners to notify when an attribute changes.
+     */
+    std::vector<PlayerListener*> listeners;
+
+    /**
+     * Notify the listeners that an attribute has changed.
+     */
+    void statsChanged();
 };
 
 #endif //PLAYER_H
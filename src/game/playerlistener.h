@@ -0,0 +1,32 @@
+/************************************************************************
+ *
+ * playerlistener.h
+ * PlayerListener class
+ *
+ ************************************************************************/
+
+#ifndef PLAYERLISTENER_H
+#define PLAYERLISTENER_H
+
+class Player;
+
+/**
+ * A PlayerListener is notified when the attributes of the players it has
+ * been added to with Player::addListener() change. It is used by the user
+ * interface so that it only has to update when something has changed.
+ */
+class PlayerListener
+{
+public:
+    /**
+     * Destructor.
+     */
+    virtual ~PlayerListener() {}
+
+    /**
+     * Called after the player's health, energy or ammunition has changed.
+     */
+    virtual void notifyStatsChanged(Player *player) {}
+};
+
+#endif //PLAYERLISTENER_H
@@ -0,0 +1,61 @@
+/************************************************************************
+ *
+ * pool.cpp
+ * PoolBase class implementation
+ *
+ ************************************************************************/
+
+#include "pool.h"
+
+int PoolBase::turnAllocs = 0;
+int PoolBase::turnHeapAllocs = 0;
+int PoolBase::lastTurnAllocs = 0;
+int PoolBase::lastTurnHeapAllocs = 0;
+
+/**
+ * Start counting allocations for a new turn. The counts for the turn
+ * that has just finished can be read with the getLastTurn methods.
+ */
+void PoolBase::startTurn()
+{
+    lastTurnAllocs = turnAllocs;
+    lastTurnHeapAllocs = turnHeapAllocs;
+    turnAllocs = 0;
+    turnHeapAllocs = 0;
+}
+
+/**
+ * Returns the number of objects allocated from pools during the current
+ * turn.
+ */
+int PoolBase::getTurnAllocations()
+{
+    return turnAllocs;
+}
+
+/**
+ * Returns the number of times the pools went to the global heap during
+ * the current turn.
+ */
+int PoolBase::getTurnHeapAllocations()
+{
+    return turnHeapAllocs;
+}
+
+/**
+ * Returns the number of objects allocated from pools during the last
+ * complete turn.
+ */
+int PoolBase::getLastTurnAllocations()
+{
+    return lastTurnAllocs;
+}
+
+/**
+ * Returns the number of times the pools went to the global heap during
+ * the last complete turn.
+ */
+int PoolBase::getLastTurnHeapAllocations()
+{
+    return lastTurnHeapAllocs;
+}
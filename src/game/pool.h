@@ -0,0 +1,316 @@
+/************************************************************************
+ *
+ * pool.h
+ * Pool, Pooled and PoolAllocator templates
+ *
+ ************************************************************************/
+
+#ifndef POOL_H
+#define POOL_H
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#define POOL_CHUNK_SIZE 16  // number of blocks allocated at a time
+#define POOL_ALIGN 16       // blocks are aligned to this many bytes
+
+/**
+ * The PoolBase keeps the allocation counters that are shared by all the
+ * pools. Each turn, startTurn() is called so that the allocations made during
+ * a single turn can be reported.
+ */
+class PoolBase
+{
+public:
+    /**
+     * Start counting allocations for a new turn. The counts for the turn
+     * that has just finished can be read with the getLastTurn methods.
+     */
+    static void startTurn();
+
+    /**
+     * Returns the number of objects allocated from pools during the current
+     * turn.
+     */
+    static int getTurnAllocations();
+
+    /**
+     * Returns the number of times the pools went to the global heap during
+     * the current turn.
+     */
+    static int getTurnHeapAllocations();
+
+    /**
+     * Returns the number of objects allocated from pools during the last
+     * complete turn.
+     */
+    static int getLastTurnAllocations();
+
+    /**
+     * Returns the number of times the pools went to the global heap during
+     * the last complete turn. Once every pool has grown to the size the game
+     * needs, this is zero.
+     */
+    static int getLastTurnHeapAllocations();
+
+protected:
+    /**
+     * The allocation counters for the current turn.
+     */
+    static int turnAllocs, turnHeapAllocs;
+
+    /**
+     * The allocation counters for the last complete turn.
+     */
+    static int lastTurnAllocs, lastTurnHeapAllocs;
+};
+
+/**
+ * A Pool hands out fixed size blocks of memory for objects of type T. Freed
+ * blocks are kept on a free list and reused, so the global heap is only used
+ * when the pool has to grow. There is one pool per type, returned by
+ * getInstance(). Requests for a size other than sizeof(T), which happens when
+ * a subclass of T is allocated, are passed on to the global heap.
+ */
+template <class T>
+class Pool : public PoolBase
+{
+public:
+    /**
+     * Returns the pool for type T.
+     */
+    static Pool<T> &getInstance()
+    {
+        static Pool<T> pool;
+        return pool;
+    }
+
+    /**
+     * Destructor. The memory of all the chunks is returned to the heap.
+     */
+    ~Pool()
+    {
+        for (unsigned i=0; i<chunks.size(); i++) {
+            ::operator delete(chunks[i]);
+        }
+    }
+
+    /**
+     * Allocate a block of the given size.
+     */
+    void *allocate(size_t size)
+    {
+        turnAllocs++;
+
+        if (size != sizeof(T)) {
+            turnHeapAllocs++;
+            return ::operator new(size);
+        }
+
+        if (!freeList) {
+            grow();
+        }
+
+        Block *b = freeList;
+        freeList = b->next;
+        live++;
+        return b;
+    }
+
+    /**
+     * Return a block that was allocated with the given size to the pool.
+     */
+    void release(void *p, size_t size)
+    {
+        if (!p) {
+            return;
+        }
+
+        if (size != sizeof(T)) {
+            ::operator delete(p);
+            return;
+        }
+
+        Block *b = (Block*) p;
+        b->next = freeList;
+        freeList = b;
+        live--;
+    }
+
+    /**
+     * Returns the number of blocks currently in use.
+     */
+    int getLiveCount()
+    {
+        return live;
+    }
+
+    /**
+     * Returns the total number of blocks owned by the pool.
+     */
+    int getCapacity()
+    {
+        return (int) chunks.size() * POOL_CHUNK_SIZE;
+    }
+
+private:
+    /**
+     * A free block. It is only used to link the free list together.
+     */
+    struct Block
+    {
+        Block *next;
+    };
+
+    /**
+     * The size of a block, rounded up so that every block is aligned.
+     */
+    enum {
+        BLOCK_SIZE = ((sizeof(T) > sizeof(Block) ? sizeof(T) : sizeof(Block))
+                      + POOL_ALIGN - 1) / POOL_ALIGN * POOL_ALIGN
+    };
+
+    /**
+     * The first free block. It is NULL if there are no free blocks.
+     */
+    Block *freeList;
+
+    /**
+     * The chunks of memory allocated from the heap.
+     */
+    std::vector<char*> chunks;
+
+    /**
+     * The number of blocks in use.
+     */
+    int live;
+
+    /**
+     * Constructor. Use getInstance() to get the pool.
+     */
+    Pool()
+        : freeList(NULL), live(0)
+    {
+    }
+
+    /**
+     * Pools cannot be copied.
+     */
+    Pool(const Pool<T>&);
+    Pool<T> &operator=(const Pool<T>&);
+
+    /**
+     * Allocate another chunk of blocks from the heap and put them on the
+     * free list.
+     */
+    void grow()
+    {
+        turnHeapAllocs++;
+
+        char *chunk = (char*) ::operator new(BLOCK_SIZE * POOL_CHUNK_SIZE);
+        chunks.push_back(chunk);
+
+        for (int i=POOL_CHUNK_SIZE-1; i>=0; i--) {
+            Block *b = (Block*) (chunk + i*BLOCK_SIZE);
+            b->next = freeList;
+            freeList = b;
+        }
+    }
+};
+
+/**
+ * Classes that inherit from Pooled<T> are allocated from Pool<T> by new and
+ * returned to it by delete. T should be the class itself, and it should have
+ * a virtual destructor if it is deleted through a base class pointer.
+ */
+template <class T>
+class Pooled
+{
+public:
+    static void *operator new(size_t size)
+    {
+        return Pool<T>::getInstance().allocate(size);
+    }
+
+    static void operator delete(void *p, size_t size)
+    {
+        Pool<T>::getInstance().release(p, size);
+    }
+};
+
+/**
+ * An STL allocator that takes single elements from Pool<T>. It is used for
+ * node based containers like std::list, which allocate one node at a time.
+ */
+template <class T>
+class PoolAllocator
+{
+public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef ptrdiff_t difference_type;
+
+    template <class U>
+    struct rebind
+    {
+        typedef PoolAllocator<U> other;
+    };
+
+    PoolAllocator() {}
+    PoolAllocator(const PoolAllocator<T>&) {}
+    template <class U> PoolAllocator(const PoolAllocator<U>&) {}
+
+    pointer address(reference x) const { return &x; }
+    const_pointer address(const_reference x) const { return &x; }
+
+    pointer allocate(size_type n, const void* = 0)
+    {
+        if (n == 1) {
+            return (pointer) Pool<T>::getInstance().allocate(sizeof(T));
+        }
+        return (pointer) ::operator new(n * sizeof(T));
+    }
+
+    void deallocate(pointer p, size_type n)
+    {
+        if (n == 1) {
+            Pool<T>::getInstance().release(p, sizeof(T));
+        } else {
+            ::operator delete(p);
+        }
+    }
+
+    size_type max_size() const
+    {
+        return size_t(-1) / sizeof(T);
+    }
+
+    void construct(pointer p, const T& val)
+    {
+        new((void*) p) T(val);
+    }
+
+    void destroy(pointer p)
+    {
+        p->~T();
+    }
+};
+
+template <class T, class U>
+bool operator==(const PoolAllocator<T>&, const PoolAllocator<U>&)
+{
+    return true;
+}
+
+template <class T, class U>
+bool operator!=(const PoolAllocator<T>&, const PoolAllocator<U>&)
+{
+    return false;
+}
+
+#endif //POOL_H
@@ -6,8 +6,8 @@
  ************************************************************************/
 
 #include "progressbar.h"
+#include "uibatch.h"
 
-#include <GL/gl.h>
 #include <cassert>
 
 /**
@@ -40,33 +40,14 @@ void ProgressBar::setProgress(float p)
  */
 void ProgressBar::draw(float dt)
 {
-    //disable textures
-    glDisable(GL_TEXTURE_2D);
+    UIBatch &batch = UIBatch::getInstance();
 
     float w = getSize().x;
 
     // fill
-
-    glColor3f(0, 1, 0);
-
-    glBegin(GL_QUADS); //begin drawing
-    glVertex2f(0, 0);
-    glVertex2f(w*progress, 0);
-    glVertex2f(w*progress, getSize().y);
-    glVertex2f(0, getSize().y);
-    glEnd(); //end drawing
+    batch.addQuad(NULL, vector4(0, 0), vector4(w*progress, getSize().y),
+                  0, 1, 0);
 
     // outline
-
-    glPolygonMode(GL_FRONT, GL_LINE);
-    glColor3f(0, 0, 0);
-
-    glBegin(GL_QUADS);  //being drawing
-    glVertex2f(0, 0);
-    glVertex2f(w, 0);
-    glVertex2f(w, getSize().y);
-    glVertex2f(0, getSize().y);
-    glEnd(); //end drawing
-
-    glPolygonMode(GL_FRONT, GL_FILL);  //reset
+    batch.addOutline(vector4(0, 0), getSize(), 0, 0, 0);
 }
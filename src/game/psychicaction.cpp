@@ -6,8 +6,7 @@
  ************************************************************************/
 
 #include "psychicaction.h"
-
-#define ENERGY 1
+#include "gamerules.h"
 
 /**
  * Returns true if the player can perform a psychic action. This checks
@@ -15,7 +14,7 @@
  */
 bool PsychicAction::canPsychic(Player *player)
 {
-    return (player->getEnergy() >= ENERGY);
+    return (player->getEnergy() >= PSYCHIC_ENERGY);
 }
 
 /**
@@ -24,13 +23,12 @@ bool PsychicAction::canPsychic(Player *player)
 void PsychicAction::markSelectable(Player *player, Maze *maze)
 {
     if (player->getCell()) {  //if cell is initialised
-        std::vector<Cell*> neigh = player->getCell()->neighbours; 
-        std::vector<Cell*>::iterator i;
-        for (i=neigh.begin(); i != neigh.end(); i++) { //go through all the neighbours
-            Cell *c = *i;
+        //go through all the neighbours
+        for (int k=0; k < MazeGrid::getNeighbourCount(); k++) {
+            Cell *c = maze->getNeighbour(player->getCell(), k);
 	    //if it is allowed to, make it selectable
-            if (!c->getWall() && c->isVisible() && !c->hasPlayer()) {
-                c->setSelectable(true);
+            if (c && !c->getWall() && c->isVisible() && !c->hasPlayer()) {
+                maze->setSelectable(c);
             }
         }
     }
@@ -60,8 +58,8 @@ PsychicAction::~PsychicAction()
  */
 bool PsychicAction::update(float dt)
 {
-    std::list<Entity*> ent = target->getEntities();
-    std::list<Entity*>::iterator i;
+    Cell::EntityList ent = target->getEntities();
+    Cell::EntityList::iterator i;
     for (i=ent.begin(); i != ent.end(); i++) {
         Entity *e = *i;
 
@@ -72,3 +70,14 @@ bool PsychicAction::update(float dt)
 
     return false;
 }
+
+/**
+ * Set m to the use of psychic powers on the target, and return true.
+ */
+bool PsychicAction::getMove(Move &m) const
+{
+    int i, j;
+    target->getMazePosition(i, j);
+    m = Move(Move::PSYCHIC, i, j);
+    return true;
+}
@@ -12,11 +12,13 @@
 #include "player.h"
 #include "cell.h"
 #include "maze.h"
+#include "pool.h"
+#include "rules.h"
 
 /**
  * The PsychicAction class reveals the hidden items on an adjacent cell.
  */
-class PsychicAction : public Action {
+class PsychicAction : public Action, public Pooled<PsychicAction> {
 public:
 
     /**
@@ -47,6 +49,11 @@ public:
      */
     virtual bool update(float dt);
 
+    /**
+     * Set m to the use of psychic powers on the target, and return true.
+     */
+    virtual bool getMove(Move &m) const;
+
 private:
     /**
      * The player that is being moved.
@@ -0,0 +1,232 @@
+/************************************************************************
+ *
+ * renderstate.cpp
+ * RenderState class implementation
+ *
+ ************************************************************************/
+
+#include "renderstate.h"
+
+/**
+ * Returns the state of the OpenGL context.
+ */
+RenderState &RenderState::getInstance()
+{
+    static RenderState state;
+    return state;
+}
+
+/**
+ * Constructor. Initially, nothing is known about the state.
+ */
+RenderState::RenderState()
+    : changes(0), skipped(0), lastChanges(0), lastSkipped(0)
+{
+    invalidate();
+}
+
+/**
+ * Enable the OpenGL capability, if it is not already enabled.
+ */
+void RenderState::enable(GLenum cap)
+{
+    setCap(cap, true);
+}
+
+/**
+ * Disable the OpenGL capability, if it is not already disabled.
+ */
+void RenderState::disable(GLenum cap)
+{
+    setCap(cap, false);
+}
+
+/**
+ * Set a capability if it is not known to be in that state already.
+ */
+void RenderState::setCap(GLenum cap, bool on)
+{
+    std::map<GLenum, bool>::iterator i = caps.find(cap);
+    if ((i != caps.end()) && (i->second == on)) {
+        skipped++;
+        return;
+    }
+
+    if (on) {
+        glEnable(cap);
+    } else {
+        glDisable(cap);
+    }
+    caps[cap] = on;
+    changes++;
+}
+
+/**
+ * Bind the 2D texture with the given OpenGL name, if it is not already
+ * bound.
+ */
+void RenderState::bindTexture(GLuint id)
+{
+    if (textureKnown && (texture == id)) {
+        skipped++;
+        return;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, id);
+    textureKnown = true;
+    texture = id;
+    changes++;
+}
+
+/**
+ * Set the current colour, if it is different.
+ */
+void RenderState::color(float r, float g, float b, float a)
+{
+    if (colorKnown && (current[0] == r) && (current[1] == g) &&
+        (current[2] == b) && (current[3] == a)) {
+        skipped++;
+        return;
+    }
+
+    glColor4f(r, g, b, a);
+    colorKnown = true;
+    current[0] = r;
+    current[1] = g;
+    current[2] = b;
+    current[3] = a;
+    changes++;
+}
+
+/**
+ * Set the alpha test function, if it is different.
+ */
+void RenderState::alphaFunc(GLenum func, float ref)
+{
+    if (alphaKnown && (alphaFn == func) && (alphaRef == ref)) {
+        skipped++;
+        return;
+    }
+
+    glAlphaFunc(func, ref);
+    alphaKnown = true;
+    alphaFn = func;
+    alphaRef = ref;
+    changes++;
+}
+
+/**
+ * Set the blending function, if it is different.
+ */
+void RenderState::blendFunc(GLenum src, GLenum dst)
+{
+    if (blendKnown && (blendSrc == src) && (blendDst == dst)) {
+        skipped++;
+        return;
+    }
+
+    glBlendFunc(src, dst);
+    blendKnown = true;
+    blendSrc = src;
+    blendDst = dst;
+    changes++;
+}
+
+/**
+ * Set the shading model, if it is different.
+ */
+void RenderState::shadeModel(GLenum mode)
+{
+    if (shadeKnown && (shade == mode)) {
+        skipped++;
+        return;
+    }
+
+    glShadeModel(mode);
+    shadeKnown = true;
+    shade = mode;
+    changes++;
+}
+
+/**
+ * Forget the bound texture if it has the given name. This must be called
+ * when a texture is deleted, since OpenGL may reuse the name.
+ */
+void RenderState::forgetTexture(GLuint id)
+{
+    if (texture == id) {
+        textureKnown = false;
+    }
+}
+
+/**
+ * Forget the current colour. This must be called after drawing with a
+ * colour array, which leaves the current colour undefined.
+ */
+void RenderState::forgetColor()
+{
+    colorKnown = false;
+}
+
+/**
+ * Forget everything about the state, so that every following change is
+ * sent to OpenGL.
+ */
+void RenderState::invalidate()
+{
+    caps.clear();
+    textureKnown = false;
+    texture = 0;
+    colorKnown = false;
+    alphaKnown = false;
+    blendKnown = false;
+    shadeKnown = false;
+}
+
+/**
+ * Start counting changes for a new frame. The counts for the frame that
+ * has just finished can be read with the getLastFrame methods.
+ */
+void RenderState::startFrame()
+{
+    lastChanges = changes;
+    lastSkipped = skipped;
+    changes = 0;
+    skipped = 0;
+}
+
+/**
+ * Returns the number of state changes sent to OpenGL during the current
+ * frame.
+ */
+int RenderState::getFrameChanges()
+{
+    return changes;
+}
+
+/**
+ * Returns the number of state changes skipped during the current frame
+ * because they would have had no effect.
+ */
+int RenderState::getFrameSkipped()
+{
+    return skipped;
+}
+
+/**
+ * Returns the number of state changes sent to OpenGL during the last
+ * complete frame.
+ */
+int RenderState::getLastFrameChanges()
+{
+    return lastChanges;
+}
+
+/**
+ * Returns the number of state changes skipped during the last complete
+ * frame.
+ */
+int RenderState::getLastFrameSkipped()
+{
+    return lastSkipped;
+}
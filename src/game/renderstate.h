@@ -0,0 +1,179 @@
+/************************************************************************
+ *
+ * renderstate.h
+ * RenderState class
+ *
+ ************************************************************************/
+
+#ifndef RENDERSTATE_H
+#define RENDERSTATE_H
+
+#include <GL/gl.h>
+
+#include <map>
+
+/**
+ * The RenderState remembers the OpenGL state that the game has set, so that
+ * changes that would have no effect are not sent to OpenGL. Capabilities,
+ * the bound texture, the current colour, and the alpha and blend functions
+ * should all be set through the RenderState rather than directly.
+ *
+ * Anything that changes the state behind its back, like calling a display
+ * list that changes the state, must call invalidate() afterwards. Display
+ * lists must not be compiled with states that were skipped, so invalidate()
+ * should also be called before compiling a list that changes the state.
+ *
+ * The number of changes made and skipped are counted for each frame.
+ * startFrame() is called by the Application at the start of every frame.
+ */
+class RenderState
+{
+public:
+    /**
+     * Returns the state of the OpenGL context.
+     */
+    static RenderState &getInstance();
+
+    /**
+     * Constructor. Initially, nothing is known about the state.
+     */
+    RenderState();
+
+    /**
+     * Enable the OpenGL capability, if it is not already enabled.
+     */
+    void enable(GLenum cap);
+
+    /**
+     * Disable the OpenGL capability, if it is not already disabled.
+     */
+    void disable(GLenum cap);
+
+    /**
+     * Bind the 2D texture with the given OpenGL name, if it is not already
+     * bound.
+     */
+    void bindTexture(GLuint id);
+
+    /**
+     * Set the current colour, if it is different.
+     */
+    void color(float r, float g, float b, float a = 1);
+
+    /**
+     * Set the alpha test function, if it is different.
+     */
+    void alphaFunc(GLenum func, float ref);
+
+    /**
+     * Set the blending function, if it is different.
+     */
+    void blendFunc(GLenum src, GLenum dst);
+
+    /**
+     * Set the shading model, if it is different.
+     */
+    void shadeModel(GLenum mode);
+
+    /**
+     * Forget the bound texture if it has the given name. This must be called
+     * when a texture is deleted, since OpenGL may reuse the name.
+     */
+    void forgetTexture(GLuint id);
+
+    /**
+     * Forget the current colour. This must be called after drawing with a
+     * colour array, which leaves the current colour undefined.
+     */
+    void forgetColor();
+
+    /**
+     * Forget everything about the state, so that every following change is
+     * sent to OpenGL.
+     */
+    void invalidate();
+
+    /**
+     * Start counting changes for a new frame. The counts for the frame that
+     * has just finished can be read with the getLastFrame methods.
+     */
+    void startFrame();
+
+    /**
+     * Returns the number of state changes sent to OpenGL during the current
+     * frame.
+     */
+    int getFrameChanges();
+
+    /**
+     * Returns the number of state changes skipped during the current frame
+     * because they would have had no effect.
+     */
+    int getFrameSkipped();
+
+    /**
+     * Returns the number of state changes sent to OpenGL during the last
+     * complete frame.
+     */
+    int getLastFrameChanges();
+
+    /**
+     * Returns the number of state changes skipped during the last complete
+     * frame.
+     */
+    int getLastFrameSkipped();
+
+private:
+    /**
+     * The known capabilities, and whether they are enabled.
+     */
+    std::map<GLenum, bool> caps;
+
+    /**
+     * The bound texture, if textureKnown is true.
+     */
+    bool textureKnown;
+    GLuint texture;
+
+    /**
+     * The current colour, if colorKnown is true.
+     */
+    bool colorKnown;
+    float current[4];
+
+    /**
+     * The alpha test function, if alphaKnown is true.
+     */
+    bool alphaKnown;
+    GLenum alphaFn;
+    float alphaRef;
+
+    /**
+     * The blending function, if blendKnown is true.
+     */
+    bool blendKnown;
+    GLenum blendSrc, blendDst;
+
+    /**
+     * The shading model, if shadeKnown is true.
+     */
+    bool shadeKnown;
+    GLenum shade;
+
+    /**
+     * The counters for the current frame.
+     */
+    int changes, skipped;
+
+    /**
+     * The counters for the last complete frame.
+     */
+    int lastChanges, lastSkipped;
+
+    /**
+     * Set a capability if it is not known to be in that state already.
+     */
+    void setCap(GLenum cap, bool on);
+};
+
+#endif //RENDERSTATE_H
@@ -0,0 +1,201 @@
+/************************************************************************
+ *
+ * resolutionscaler.cpp
+ * ResolutionScaler class implementation
+ *
+ ************************************************************************/
+
+#include "resolutionscaler.h"
+#include "renderstate.h"
+
+#include <cmath>
+
+#define MIN_SCALE 0.5        // the resolution is never lowered further
+#define SCALE_DAMPING 0.25   // how quickly the scale follows the frame time
+
+/**
+ * Constructor. There is no target frame time, so the scale stays 1.
+ */
+ResolutionScaler::ResolutionScaler()
+    : w(0), h(0), target(0), scale(1), tex(0), texSize(0)
+{
+}
+
+/**
+ * Destructor.
+ */
+ResolutionScaler::~ResolutionScaler()
+{
+    release();
+}
+
+/**
+ * Set the size of the screen in pixels.
+ */
+void ResolutionScaler::setScreenSize(int w, int h)
+{
+    this->w = w;
+    this->h = h;
+}
+
+/**
+ * Set the time in seconds that a frame should take. If it is 0, the
+ * resolution is not scaled.
+ */
+void ResolutionScaler::setTargetFrameTime(float t)
+{
+    target = t;
+    if (target <= 0) {
+        scale = 1;
+    }
+}
+
+/**
+ * Returns the time in seconds that a frame should take.
+ */
+float ResolutionScaler::getTargetFrameTime()
+{
+    return target;
+}
+
+/**
+ * Returns the fraction of the screen's width and height that the 3D pass
+ * is rendered at.
+ */
+float ResolutionScaler::getScale()
+{
+    return scale;
+}
+
+/**
+ * Returns the width in pixels that the 3D pass is rendered at.
+ */
+int ResolutionScaler::getRenderWidth()
+{
+    return (int) (w * scale);
+}
+
+/**
+ * Returns the height in pixels that the 3D pass is rendered at.
+ */
+int ResolutionScaler::getRenderHeight()
+{
+    return (int) (h * scale);
+}
+
+/**
+ * Adjust the scale after a frame that took t seconds.
+ */
+void ResolutionScaler::update(float t)
+{
+    if ((target <= 0) || (t <= 0)) {
+        return;
+    }
+
+    // the time is taken to be proportional to the number of pixels, which
+    // is the square of the scale
+    float ideal = scale * sqrt(target / t);
+    scale += (ideal - scale) * SCALE_DAMPING;
+
+    if (scale < MIN_SCALE) {
+        scale = MIN_SCALE;
+    } else if (scale > 1) {
+        scale = 1;
+    }
+}
+
+/**
+ * Start rendering the 3D pass at the current scale.
+ */
+void ResolutionScaler::begin()
+{
+    if (scale < 1) {
+        glViewport(0, 0, getRenderWidth(), getRenderHeight());
+    }
+}
+
+/**
+ * Finish the 3D pass, stretching it over the whole screen if it was
+ * rendered at a lower resolution.
+ */
+void ResolutionScaler::end()
+{
+    if (scale >= 1) {
+        return;
+    }
+
+    RenderState &state = RenderState::getInstance();
+    int rw = getRenderWidth();
+    int rh = getRenderHeight();
+
+    // the texture must be a power of two big enough for the whole screen
+    if (!tex) {
+        texSize = 1;
+        while ((texSize < w) || (texSize < h)) {
+            texSize *= 2;
+        }
+
+        glGenTextures(1, &tex);
+        state.bindTexture(tex);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, texSize, texSize, 0, GL_RGB,
+                     GL_UNSIGNED_BYTE, NULL);
+    }
+
+    // copy the pass out of the corner of the frame buffer
+    state.bindTexture(tex);
+    glCopyTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 0, 0, rw, rh);
+
+    // and stretch it over the screen
+    glViewport(0, 0, w, h);
+
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glOrtho(0, 1, 0, 1, -1, 1);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    state.disable(GL_DEPTH_TEST);
+    state.disable(GL_LIGHTING);
+    state.disable(GL_BLEND);
+    state.enable(GL_TEXTURE_2D);
+    state.color(1, 1, 1);
+
+    float s = (float) rw / texSize;
+    float t = (float) rh / texSize;
+    glBegin(GL_QUADS);
+    glTexCoord2f(0, 0);
+    glVertex2f(0, 0);
+    glTexCoord2f(s, 0);
+    glVertex2f(1, 0);
+    glTexCoord2f(s, t);
+    glVertex2f(1, 1);
+    glTexCoord2f(0, t);
+    glVertex2f(0, 1);
+    glEnd();
+
+    state.disable(GL_TEXTURE_2D);
+
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+}
+
+/**
+ * Delete the texture. This must be called before the OpenGL context is
+ * destroyed.
+ */
+void ResolutionScaler::release()
+{
+    if (tex) {
+        glDeleteTextures(1, &tex);
+        RenderState::getInstance().forgetTexture(tex);
+        tex = 0;
+    }
+}
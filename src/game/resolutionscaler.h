@@ -0,0 +1,110 @@
+/************************************************************************
+ *
+ * resolutionscaler.h
+ * ResolutionScaler class
+ *
+ ************************************************************************/
+
+#ifndef RESOLUTIONSCALER_H
+#define RESOLUTIONSCALER_H
+
+#include <GL/gl.h>
+
+/**
+ * The ResolutionScaler renders the 3D pass at a lower resolution when
+ * frames take longer than a target time, which helps when filling pixels
+ * is the bottleneck. The pass is drawn into the corner of the frame buffer,
+ * copied into a texture and stretched over the whole screen, and the user
+ * interface is then drawn at the full resolution on top.
+ *
+ * After each frame, the scale is moved towards the one that would have
+ * made the frame take the target time, assuming that the time is
+ * proportional to the number of pixels.
+ */
+class ResolutionScaler
+{
+public:
+    /**
+     * Constructor. There is no target frame time, so the scale stays 1.
+     */
+    ResolutionScaler();
+
+    /**
+     * Destructor.
+     */
+    ~ResolutionScaler();
+
+    /**
+     * Set the size of the screen in pixels.
+     */
+    void setScreenSize(int w, int h);
+
+    /**
+     * Set the time in seconds that a frame should take. If it is 0, the
+     * resolution is not scaled.
+     */
+    void setTargetFrameTime(float t);
+
+    /**
+     * Returns the time in seconds that a frame should take.
+     */
+    float getTargetFrameTime();
+
+    /**
+     * Returns the fraction of the screen's width and height that the 3D
+     * pass is rendered at.
+     */
+    float getScale();
+
+    /**
+     * Returns the width in pixels that the 3D pass is rendered at.
+     */
+    int getRenderWidth();
+
+    /**
+     * Returns the height in pixels that the 3D pass is rendered at.
+     */
+    int getRenderHeight();
+
+    /**
+     * Adjust the scale after a frame that took t seconds.
+     */
+    void update(float t);
+
+    /**
+     * Start rendering the 3D pass at the current scale.
+     */
+    void begin();
+
+    /**
+     * Finish the 3D pass, stretching it over the whole screen if it was
+     * rendered at a lower resolution.
+     */
+    void end();
+
+    /**
+     * Delete the texture. This must be called before the OpenGL context is
+     * destroyed.
+     */
+    void release();
+
+private:
+    /**
+     * The size of the screen.
+     */
+    int w, h;
+
+    /**
+     * The target frame time, and the current scale.
+     */
+    float target, scale;
+
+    /**
+     * The texture that the 3D pass is copied into, and its size. It is
+     * created when it is first needed.
+     */
+    GLuint tex;
+    int texSize;
+};
+
+#endif //RESOLUTIONSCALER_H
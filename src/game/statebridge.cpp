@@ -0,0 +1,127 @@
+/************************************************************************
+ *
+ * statebridge.cpp
+ * StateBridge class implementation
+ *
+ ************************************************************************/
+
+#include "statebridge.h"
+#include "level.h"
+#include "maze.h"
+#include "item.h"
+
+#include <assert.h>
+
+/**
+ * Set the state of a player from the player.
+ */
+static void extractPlayer(PlayerState &s, Player *p)
+{
+    s.i = s.j = -1;
+    if (p->getCell()) {
+        int i, j;
+        p->getCell()->getMazePosition(i, j);
+        s.i = i;
+        s.j = j;
+    }
+    s.health = p->getHealth();
+    s.energy = p->getEnergy();
+    s.ammo = p->getAmmo();
+}
+
+/**
+ * Set the state to the state of the level. The level must be loaded, and
+ * the maze must be no more than GAME_STATE_MAX_SIZE cells in each
+ * direction. No player action may be running, since the maze would then be
+ * part of the way through the action while the turn is already the one
+ * that follows it.
+ */
+void StateBridge::extract(GameState &s, Level *level)
+{
+    assert(level->getCurrentTurn() != Level::ACTION_TURN);
+    extract(s, level->getMaze(), level->getHero(), level->getHaggis());
+    s.heroTurn = (level->getNextTurn() == Level::HERO_TURN);
+}
+
+/**
+ * Set the state to the state of the maze and the players. The turn is not
+ * changed.
+ */
+void StateBridge::extract(GameState &s, Maze *maze, Player *hero,
+                          Player *haggis)
+{
+    s.resize(maze->getWidth(), maze->getHeight());
+    for (int i=0; i<s.getHeight(); i++) {
+        for (int j=0; j<s.getWidth(); j++) {
+            Cell *c = maze->getCell(i, j);
+            s.set(GameState::VISIBLE, i, j, c->isVisible());
+            s.setWallHeight(i, j, c->getWallHeight());
+
+            Cell::EntityList entities = c->getEntities();
+            for (Cell::EntityList::iterator e = entities.begin();
+                 e != entities.end(); e++) {
+                Item *it = dynamic_cast<Item*>(*e);
+                if (it && !it->isSpent()) {
+                    s.set((GameState::Plane)
+                          (GameState::ITEM_HEALTH + it->getType()), i, j);
+                    s.set(GameState::REVEALED, i, j, it->isVisible());
+                }
+            }
+        }
+    }
+
+    extractPlayer(s.hero, hero);
+    extractPlayer(s.haggis, haggis);
+}
+
+/**
+ * Change the level to match the state. The walls and items are set first,
+ * so that putting the players back on their cells does not pick up the
+ * items under them again. Both players are taken off the maze before
+ * either is put back, so that a cell's player flag is right even if they
+ * swapped cells.
+ */
+void StateBridge::apply(const GameState &s, Level *level)
+{
+    Maze *maze = level->getMaze();
+    assert((maze->getWidth() == s.getWidth()) &&
+           (maze->getHeight() == s.getHeight()));
+
+    for (int i=0; i<s.getHeight(); i++) {
+        for (int j=0; j<s.getWidth(); j++) {
+            Cell *c = maze->getCell(i, j);
+            c->setWallHeight(s.getWallHeight(i, j));
+
+            Cell::EntityList entities = c->getEntities();
+            for (Cell::EntityList::iterator e = entities.begin();
+                 e != entities.end(); e++) {
+                Item *it = dynamic_cast<Item*>(*e);
+                if (it) {
+                    bool here = s.get((GameState::Plane)
+                                      (GameState::ITEM_HEALTH +
+                                       it->getType()), i, j);
+                    it->setSpent(!here);
+                    it->setVisibility(!here ||
+                                      s.get(GameState::REVEALED, i, j));
+                }
+            }
+        }
+    }
+
+    Player *players[2] = {level->getHero(), level->getHaggis()};
+    const PlayerState *states[2] = {&s.hero, &s.haggis};
+    for (int k=0; k<2; k++) {
+        players[k]->setCell(NULL, true);
+    }
+    for (int k=0; k<2; k++) {
+        const PlayerState &p = *states[k];
+        if (p.i >= 0) {
+            players[k]->setCell(maze->getCell(p.i, p.j), true);
+        }
+        players[k]->setHealth(p.health);
+        players[k]->setEnergy(p.energy);
+        players[k]->setAmmo(p.ammo);
+    }
+
+    level->setCurrentTurn(s.heroTurn ? Level::HERO_TURN : Level::HAGGIS_TURN);
+}
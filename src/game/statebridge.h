@@ -0,0 +1,51 @@
+/************************************************************************
+ *
+ * statebridge.h
+ * StateBridge class
+ *
+ ************************************************************************/
+
+#ifndef STATEBRIDGE_H
+#define STATEBRIDGE_H
+
+#include "gamestate.h"
+
+class Level;
+class Maze;
+class Player;
+
+/**
+ * The StateBridge moves a GameState in and out of a Level, so that the
+ * rules, the AI and the simulator can work on states without knowing about
+ * the maze, the cells or anything that draws them.
+ *
+ * A state is taken from a level with extract(), and can be put back with
+ * apply() into the level it was taken from, or one loaded from the same
+ * file. Items cannot be added to a level, so apply() only changes whether
+ * the items that are already there have been picked up.
+ */
+class StateBridge
+{
+public:
+    /**
+     * Set the state to the state of the level. The level must be loaded,
+     * and the maze must be no more than GAME_STATE_MAX_SIZE cells in each
+     * direction. No player action may be running.
+     */
+    static void extract(GameState &s, Level *level);
+
+    /**
+     * Set the state to the state of the maze and the players. The turn is
+     * not changed.
+     */
+    static void extract(GameState &s, Maze *maze, Player *hero,
+                        Player *haggis);
+
+    /**
+     * Change the level to match the state. The level must have a maze of
+     * the same size, with the items in the same places.
+     */
+    static void apply(const GameState &s, Level *level);
+};
+
+#endif //STATEBRIDGE_H
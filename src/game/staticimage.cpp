@@ -6,8 +6,7 @@
  ************************************************************************/
 
 #include "staticimage.h"
-
-#include <GL/gl.h>
+#include "uibatch.h"
 
 /**
  * Constructor. The StaticImage takes ownership of the texture. If the
@@ -37,30 +36,10 @@ Texture *StaticImage::getTexture()
 }
 
 /**
- * Draw the texture. This is done by creating an OpenGL rectangle on which it is displayed.
+ * Draw the texture. This is done by adding a rectangle on which it is
+ * displayed to the UI batch.
  */
 void StaticImage::draw(float dt)
 {
-    //enable texturing
-    glEnable(GL_TEXTURE_2D);
-    if (tex) {   //if the texture has been initialised
-        tex->bind();
-        glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
-    }
-
-    //enable blending to get rid of edges
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-    glColor3f(1, 1, 1);
-
-    //draw the rectangle
-    glBegin(GL_QUADS);
-    glTexCoord2f(0, 1); glVertex2f(0, 0);
-    glTexCoord2f(1, 1); glVertex2f(getSize().x, 0);
-    glTexCoord2f(1, 0); glVertex2f(getSize().x, getSize().y);
-    glTexCoord2f(0, 0); glVertex2f(0, getSize().y);
-    glEnd();
-
-    glDisable(GL_BLEND);  //reset
+    UIBatch::getInstance().addQuad(tex, vector4(0, 0), getSize(), 1, 1, 1);
 }
@@ -0,0 +1,713 @@
+/************************************************************************
+ *
+ * terrain.cpp
+ * Terrain class implementation
+ *
+ ************************************************************************/
+
+#include "terrain.h"
+#include "renderstate.h"
+#include "levelofdetail.h"
+#include "maze.h"
+
+#include <GL/gl.h>
+
+#include <cmath>
+
+#define OUTLINE_OFFSET 0.005  // outlines are raised so the tops do not hide them
+#define SIDE_DEPTH 5          // how far the sides of a cell reach down
+#define STATIC_AMBIENT 0.5    // the global ambient light plus that of GL_LIGHT0
+#define STATIC_DIFFUSE 0.5    // the brightness of the sun
+#define LIGHT_RADIUS 8        // the dynamic lights are too dim beyond this
+
+/**
+ * Constructor. The terrain is initially empty.
+ */
+Terrain::Terrain()
+    : maze(NULL), chunksDrawn(0), litChunks(0), drawCalls(0), rebuilds(0)
+{
+}
+
+/**
+ * Destructor.
+ */
+Terrain::~Terrain()
+{
+    clear();
+}
+
+/**
+ * Divide the visible cells of the maze into chunks. The cells are told
+ * which chunk they belong to. The geometry is built when the terrain is
+ * first rendered.
+ */
+void Terrain::build(Maze *maze)
+{
+    clear();
+    this->maze = maze;
+    const int width = maze->getWidth();
+    const int height = maze->getHeight();
+
+    int across = (width + TERRAIN_CHUNK_SIZE - 1) / TERRAIN_CHUNK_SIZE;
+    int down = (height + TERRAIN_CHUNK_SIZE - 1) / TERRAIN_CHUNK_SIZE;
+    chunks.resize(across * down);
+
+    for (int i=0; i<height; i++) {
+        for (int j=0; j<width; j++) {
+            Cell *cell = maze->getCell(i, j);
+            if (!cell->isVisible()) {
+                continue;
+            }
+            int n = (i / TERRAIN_CHUNK_SIZE) * across + j / TERRAIN_CHUNK_SIZE;
+            chunks[n].cells.push_back(cell);
+            cell->setTerrain(this, n);
+        }
+    }
+
+    for (unsigned i=0; i<chunks.size(); i++) {
+        chunks[i].dirty = true;
+        chunks[i].colorDirty = false;
+    }
+    rebuilds = 0;
+}
+
+/**
+ * Remove all the chunks and detach the cells from the terrain.
+ */
+void Terrain::clear()
+{
+    for (unsigned i=0; i<chunks.size(); i++) {
+        for (unsigned j=0; j<chunks[i].cells.size(); j++) {
+            chunks[i].cells[j]->setTerrain(NULL, -1);
+        }
+    }
+    chunks.clear();
+    maze = NULL;
+}
+
+/**
+ * Mark the chunk so that its geometry is rebuilt before it is next drawn.
+ */
+void Terrain::markDirty(int chunk)
+{
+    chunks[chunk].dirty = true;
+}
+
+/**
+ * Mark the chunk of the cell, and the chunks of its neighbours, so that
+ * they are rebuilt before they are next drawn. The neighbours' sides depend
+ * on the cell's height.
+ */
+void Terrain::markCellDirty(Cell *cell)
+{
+    for (int k=0; k<MazeGrid::getNeighbourCount(); k++) {
+        Cell *nb = maze->getNeighbour(cell, k);
+        if (nb && (nb->getChunk() != -1)) {
+            markDirty(nb->getChunk());
+        }
+    }
+    markDirty(cell->getChunk());
+}
+
+/**
+ * Mark the chunk so that the colours of its cells are updated before it
+ * is next drawn.
+ */
+void Terrain::markColorDirty(int chunk)
+{
+    chunks[chunk].colorDirty = true;
+}
+
+/**
+ * Remove the dynamic lights.
+ */
+void Terrain::clearLights()
+{
+    lights.clear();
+}
+
+/**
+ * Add a dynamic light at the position in world space. The light's colour
+ * and attenuation are set by its owner. It is only applied to the chunks
+ * within its reach.
+ */
+void Terrain::addLight(GLenum id, vector4 pos)
+{
+    Light l;
+    l.id = id;
+    l.pos = pos;
+    lights.push_back(l);
+}
+
+/**
+ * Returns the direction the sun shines from, in world space.
+ */
+static vector4 getSun()
+{
+    vector4 sun(0.3, 1, 0.5);
+    return sun / sun.length();
+}
+
+/**
+ * Set up the OpenGL light as the sun that is baked into the terrain, so
+ * that the entities are lit in the same way. The camera's modelview matrix
+ * must be loaded, since the sun shines from a fixed direction in world
+ * space.
+ */
+void Terrain::placeSun(GLenum id)
+{
+    vector4 sun = getSun();
+    float pos[] = {(float) sun.x, (float) sun.y, (float) sun.z, 0};
+    glLightfv(id, GL_POSITION, pos);
+    float b = STATIC_DIFFUSE;
+    float color[] = {b, b, b, 1};
+    glLightfv(id, GL_DIFFUSE, color);
+}
+
+/**
+ * Draw the terrain. Dirty chunks are rebuilt first. The current modelview
+ * and projection matrices are used to skip chunks that cannot be seen, and
+ * the distance to the camera decides how much detail the others are drawn
+ * with.
+ */
+void Terrain::render()
+{
+    // find the planes of the view frustum from the combined matrix
+    float proj[16] = {0}, mv[16] = {0}, clip[16];
+    glGetFloatv(GL_PROJECTION_MATRIX, proj);
+    glGetFloatv(GL_MODELVIEW_MATRIX, mv);
+    for (int col=0; col<4; col++) {
+        for (int row=0; row<4; row++) {
+            clip[col*4+row] = 0;
+            for (int k=0; k<4; k++) {
+                clip[col*4+row] += proj[k*4+row] * mv[col*4+k];
+            }
+        }
+    }
+    float planes[6][4];
+    for (int p=0; p<6; p++) {
+        int row = p / 2;
+        float sign = (p % 2) ? -1 : 1;
+        for (int k=0; k<4; k++) {
+            planes[p][k] = clip[k*4+3] + sign * clip[k*4+row];
+        }
+    }
+
+    RenderState &state = RenderState::getInstance();
+    LevelOfDetail &lod = LevelOfDetail::getInstance();
+    chunksDrawn = 0;
+    litChunks = 0;
+    drawCalls = 0;
+
+    // the dynamic lights are placed in world space
+    for (unsigned i=0; i<lights.size(); i++) {
+        float pos[] = {(float) lights[i].pos.x, (float) lights[i].pos.y,
+                       (float) lights[i].pos.z, 1};
+        glLightfv(lights[i].id, GL_POSITION, pos);
+    }
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_NORMAL_ARRAY);
+
+    for (unsigned i=0; i<chunks.size(); i++) {
+        Chunk &c = chunks[i];
+
+        if (c.dirty) {
+            rebuild(c);
+        } else if (c.colorDirty) {
+            recolor(c);
+        }
+
+        if (c.triangles.empty() || isOutside(planes, c.min, c.max)) {
+            continue;
+        }
+        chunksDrawn++;
+
+        DetailLevel level = lod.getTerrainLevel(c.min, c.max);
+        if (level == LOD_TERRAIN_FLAT) {
+            renderFlat(c);
+            continue;
+        }
+        lod.addTriangles(level, c.triangles.size() / 3);
+
+        // the tops and sides, with their baked lighting
+        Vertex *v = &c.vertices[0];
+        glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+        glEnableClientState(GL_COLOR_ARRAY);
+        glVertexPointer(3, GL_FLOAT, sizeof(Vertex), v->pos);
+        glNormalPointer(GL_FLOAT, sizeof(Vertex), v->normal);
+        glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), v->tex);
+        glColorPointer(4, GL_FLOAT, sizeof(Vertex), v->color);
+        drawRuns(c);
+
+        // the dynamic lights are added on top
+        renderLights(c);
+
+        glDisableClientState(GL_COLOR_ARRAY);
+        glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+        state.forgetColor();
+
+        if (level != LOD_TERRAIN_FULL) {
+            continue;
+        }
+
+        // the outlines
+        v = &c.lineVertices[0];
+        state.disable(GL_TEXTURE_2D);
+        state.color(0, 0, 0);
+        glVertexPointer(3, GL_FLOAT, sizeof(Vertex), v->pos);
+        glNormalPointer(GL_FLOAT, sizeof(Vertex), v->normal);
+        glDrawElements(GL_LINES, c.lines.size(), GL_UNSIGNED_SHORT,
+                       &c.lines[0]);
+        drawCalls++;
+    }
+
+    glDisableClientState(GL_NORMAL_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    state.shadeModel(GL_SMOOTH);
+}
+
+/**
+ * Draw the triangles of the chunk, binding each texture once. The arrays
+ * must already be set up.
+ */
+void Terrain::drawRuns(Chunk &c)
+{
+    RenderState &state = RenderState::getInstance();
+    for (unsigned j=0; j<c.runs.size(); j++) {
+        Run &r = c.runs[j];
+        if (r.tex) {
+            state.enable(GL_TEXTURE_2D);
+            r.tex->bind();
+        } else {
+            state.disable(GL_TEXTURE_2D);
+        }
+        glDrawElements(GL_TRIANGLES, r.count, GL_UNSIGNED_SHORT,
+                       &c.triangles[r.first]);
+        drawCalls++;
+    }
+}
+
+/**
+ * Add the light of the dynamic lights that reach the chunk to what has
+ * already been drawn. The chunk is drawn again with OpenGL lighting using
+ * only those lights, and blended onto the baked lighting.
+ */
+void Terrain::renderLights(Chunk &c)
+{
+    RenderState &state = RenderState::getInstance();
+
+    bool any = false;
+    for (unsigned i=0; i<lights.size(); i++) {
+        if (isNear(lights[i].pos, c.min, c.max)) {
+            state.enable(lights[i].id);
+            any = true;
+        } else {
+            state.disable(lights[i].id);
+        }
+    }
+    if (!any) {
+        return;
+    }
+    litChunks++;
+
+    // the ambient light and the sun are already baked in
+    float ambient[4];
+    glGetFloatv(GL_LIGHT_MODEL_AMBIENT, ambient);
+    float none[] = {0, 0, 0, 1};
+    glLightModelfv(GL_LIGHT_MODEL_AMBIENT, none);
+    state.enable(GL_LIGHTING);
+    state.disable(GL_LIGHT0);
+    state.disable(GL_LIGHT1);
+
+    // only add to the pixels that were just drawn
+    state.enable(GL_BLEND);
+    state.blendFunc(GL_ONE, GL_ONE);
+    glDepthFunc(GL_EQUAL);
+    glDepthMask(GL_FALSE);
+
+    glColorPointer(4, GL_FLOAT, sizeof(Vertex), c.vertices[0].base);
+    drawRuns(c);
+
+    //return everything to the way it was
+    glLightModelfv(GL_LIGHT_MODEL_AMBIENT, ambient);
+    glDepthMask(GL_TRUE);
+    glDepthFunc(GL_LESS);
+    state.disable(GL_BLEND);
+    state.enable(GL_LIGHT0);
+    state.enable(GL_LIGHT1);
+    state.disable(GL_LIGHTING);
+    for (unsigned i=0; i<lights.size(); i++) {
+        state.enable(lights[i].id);
+    }
+}
+
+/**
+ * Draw only the tops of the cells in the chunk, flat shaded and without
+ * textures, in one call.
+ */
+void Terrain::renderFlat(Chunk &c)
+{
+    RenderState &state = RenderState::getInstance();
+    state.disable(GL_TEXTURE_2D);
+    state.shadeModel(GL_FLAT);
+
+    Vertex *v = &c.vertices[0];
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(3, GL_FLOAT, sizeof(Vertex), v->pos);
+    glNormalPointer(GL_FLOAT, sizeof(Vertex), v->normal);
+    glColorPointer(4, GL_FLOAT, sizeof(Vertex), v->color);
+    glDrawElements(GL_TRIANGLES, c.tops.size(), GL_UNSIGNED_SHORT,
+                   &c.tops[0]);
+    glDisableClientState(GL_COLOR_ARRAY);
+    state.forgetColor();
+
+    drawCalls++;
+    LevelOfDetail::getInstance().addTriangles(LOD_TERRAIN_FLAT,
+                                              c.tops.size() / 3);
+}
+
+/**
+ * Returns the number of chunks.
+ */
+int Terrain::getChunkCount()
+{
+    return chunks.size();
+}
+
+/**
+ * Returns the number of chunks drawn by the last render.
+ */
+int Terrain::getChunksDrawn()
+{
+    return chunksDrawn;
+}
+
+/**
+ * Returns the number of chunks that dynamic lights were applied to by the
+ * last render.
+ */
+int Terrain::getLitChunks()
+{
+    return litChunks;
+}
+
+/**
+ * Returns the number of draw calls made by the last render.
+ */
+int Terrain::getDrawCalls()
+{
+    return drawCalls;
+}
+
+/**
+ * Returns the number of times a chunk has been rebuilt since the terrain
+ * was built.
+ */
+int Terrain::getRebuildCount()
+{
+    return rebuilds;
+}
+
+/**
+ * Returns the number of triangles in the terrain, not counting chunks that
+ * have not been built yet.
+ */
+int Terrain::getTriangleCount()
+{
+    int n = 0;
+    for (unsigned i=0; i<chunks.size(); i++) {
+        n += chunks[i].triangles.size() / 3;
+    }
+    return n;
+}
+
+/**
+ * Returns the number of vertices in the terrain, not counting chunks that
+ * have not been built yet.
+ */
+int Terrain::getVertexCount()
+{
+    int n = 0;
+    for (unsigned i=0; i<chunks.size(); i++) {
+        n += chunks[i].vertices.size();
+    }
+    return n;
+}
+
+/**
+ * Rebuild the vertex arrays of the chunk from its cells.
+ */
+void Terrain::rebuild(Chunk &c)
+{
+    c.vertices.clear();
+    c.triangles.clear();
+    c.tops.clear();
+    c.lineVertices.clear();
+    c.lines.clear();
+    c.runs.clear();
+    c.spans.clear();
+
+    // group the cells by texture so that each texture is bound once
+    std::vector<Texture*> textures;
+    for (unsigned i=0; i<c.cells.size(); i++) {
+        Texture *tex = c.cells[i]->getTexture();
+        bool found = false;
+        for (unsigned j=0; j<textures.size(); j++) {
+            found = found || (textures[j] == tex);
+        }
+        if (!found) {
+            textures.push_back(tex);
+        }
+    }
+
+    for (unsigned t=0; t<textures.size(); t++) {
+        Run r;
+        r.tex = textures[t];
+        r.first = c.triangles.size();
+        for (unsigned i=0; i<c.cells.size(); i++) {
+            if (c.cells[i]->getTexture() == r.tex) {
+                Span s;
+                s.cell = c.cells[i];
+                s.first = c.vertices.size();
+                addCell(c, c.cells[i]);
+                s.count = c.vertices.size() - s.first;
+                c.spans.push_back(s);
+            }
+        }
+        r.count = c.triangles.size() - r.first;
+        c.runs.push_back(r);
+    }
+
+    for (unsigned i=0; i<c.cells.size(); i++) {
+        addOutline(c, c.cells[i]);
+    }
+
+    // find the bounding box
+    for (unsigned i=0; i<c.vertices.size(); i++) {
+        vector4 p(c.vertices[i].pos[0], c.vertices[i].pos[1],
+                  c.vertices[i].pos[2]);
+        if (i == 0) {
+            c.min = p;
+            c.max = p;
+        }
+        for (int k=0; k<3; k++) {
+            c.min[k] = (p[k] < c.min[k]) ? p[k] : c.min[k];
+            c.max[k] = (p[k] > c.max[k]) ? p[k] : c.max[k];
+        }
+    }
+
+    recolor(c);
+    c.dirty = false;
+    rebuilds++;
+}
+
+/**
+ * Copy the colours of the cells into the vertex array of the chunk.
+ */
+void Terrain::recolor(Chunk &c)
+{
+    for (unsigned i=0; i<c.spans.size(); i++) {
+        Span &s = c.spans[i];
+        vector4 color = s.cell->getColor();
+        for (int j=s.first; j<s.first+s.count; j++) {
+            Vertex &v = c.vertices[j];
+            v.base[0] = color.x;
+            v.base[1] = color.y;
+            v.base[2] = color.z;
+            v.base[3] = 1;
+            v.color[0] = color.x * v.light;
+            v.color[1] = color.y * v.light;
+            v.color[2] = color.z * v.light;
+            v.color[3] = 1;
+        }
+    }
+    c.colorDirty = false;
+}
+
+/**
+ * Add the triangles of the cell to the chunk.
+ */
+void Terrain::addCell(Chunk &c, Cell *cell)
+{
+    vector4 up(0, 1, 0);
+
+    // the corners of the hexagon
+    vector4 corner[7];
+    for (int i=0; i<7; i++) {
+        corner[i] = vector4(cos(i*M_PI/3.0), 0, sin(i*M_PI/3.0));
+    }
+
+    // the top is a fan of four triangles over its six corners
+    GLushort top[6];
+    for (int i=0; i<6; i++) {
+        top[i] = addVertex(c.vertices, cell, corner[i], up);
+    }
+    for (int i=4; i>=1; i--) {
+        c.triangles.push_back(top[i+1]);
+        c.triangles.push_back(top[i]);
+        c.triangles.push_back(top[0]);
+
+        // the tops are also kept on their own for drawing far away
+        c.tops.push_back(top[i+1]);
+        c.tops.push_back(top[i]);
+        c.tops.push_back(top[0]);
+    }
+
+    // each side that can be seen is a quad reaching down to the neighbour.
+    // The sides have their own vertices since their normals differ.
+    for (int i=0; i<6; i++) {
+        float depth = getSideDepth(cell, i);
+        if (depth <= 0) {
+            continue;
+        }
+
+        vector4 down(0, -depth, 0);
+        vector4 n0 = corner[i];
+        vector4 n1 = corner[i+1];
+        GLushort a = addVertex(c.vertices, cell, corner[i], n0);
+        GLushort b = addVertex(c.vertices, cell, corner[i+1], n1);
+        GLushort d = addVertex(c.vertices, cell, corner[i] + down, n0);
+        GLushort e = addVertex(c.vertices, cell, corner[i+1] + down, n1);
+
+        c.triangles.push_back(a);
+        c.triangles.push_back(b);
+        c.triangles.push_back(d);
+
+        c.triangles.push_back(d);
+        c.triangles.push_back(b);
+        c.triangles.push_back(e);
+    }
+}
+
+/**
+ * Add the outline of the cell to the chunk.
+ */
+void Terrain::addOutline(Chunk &c, Cell *cell)
+{
+    vector4 up(0, 1, 0);
+    vector4 offset(0, OUTLINE_OFFSET, 0);
+
+    GLushort first = c.lineVertices.size();
+    for (int i=0; i<6; i++) {
+        addVertex(c.lineVertices, cell,
+                  vector4(cos(i*M_PI/3.0), 0, sin(i*M_PI/3.0)) + offset, up);
+    }
+    for (int i=0; i<6; i++) {
+        c.lines.push_back(first + i);
+        c.lines.push_back(first + (i+1)%6);
+    }
+}
+
+/**
+ * Add a vertex at p relative to the cell to the array. Returns its index.
+ */
+GLushort Terrain::addVertex(std::vector<Vertex> &v, Cell *cell, vector4 p,
+                            vector4 n)
+{
+    vector4 w = cell->getPosition() + p;
+
+    Vertex vert;
+    vert.pos[0] = w.x;
+    vert.pos[1] = w.y;
+    vert.pos[2] = w.z;
+    vert.normal[0] = n.x;
+    vert.normal[1] = n.y;
+    vert.normal[2] = n.z;
+
+    // the texture is mapped in the cell's own coordinates, as it always was
+    vert.tex[0] = p.x;
+    vert.tex[1] = p.z;
+
+    vert.light = getStaticLight(n);
+    for (int k=0; k<4; k++) {
+        vert.base[k] = vert.color[k] = 1;
+    }
+    v.push_back(vert);
+    return v.size() - 1;
+}
+
+/**
+ * Returns the brightness of the static lighting on a surface with the
+ * normal n. This is the ambient light, and the sun, which is worked out in
+ * the same way as OpenGL lights the entities with it.
+ */
+float Terrain::getStaticLight(vector4 n)
+{
+    float d = n * getSun();
+    float light = STATIC_AMBIENT + STATIC_DIFFUSE * ((d > 0) ? d : 0);
+    return (light < 1) ? light : 1;
+}
+
+/**
+ * Returns how far side i of the cell, between corners i and i+1, must reach
+ * down to be seen. It is zero if the side is hidden.
+ */
+float Terrain::getSideDepth(Cell *cell, int i)
+{
+    vector4 p = cell->getPosition();
+
+    for (int k=0; k<MazeGrid::getNeighbourCount(); k++) {
+        Cell *nb = maze->getNeighbour(cell, k);
+        if (!nb) {
+            continue;
+        }
+        vector4 d = nb->getPosition() - p;
+
+        // the neighbour across side i is in the direction of the middle of
+        // the side
+        float a = atan2(d.z, d.x) / (M_PI/3.0) - 0.5;
+        int side = ((int) floor(a + 0.5) + 6) % 6;
+        if (side != i) {
+            continue;
+        }
+
+        if (!nb->isVisible()) {
+            break;
+        }
+
+        float depth = p.y - nb->getPosition().y;
+        return (depth < SIDE_DEPTH) ? depth : SIDE_DEPTH;
+    }
+
+    // there is nothing next to this side
+    return SIDE_DEPTH;
+}
+
+/**
+ * Returns true if the box is completely outside one of the planes of the
+ * view frustum. Each plane is given as four coefficients.
+ */
+bool Terrain::isOutside(float planes[6][4], vector4 min, vector4 max)
+{
+    for (int p=0; p<6; p++) {
+        // the corner of the box furthest along the plane's normal
+        float x = (planes[p][0] >= 0) ? max.x : min.x;
+        float y = (planes[p][1] >= 0) ? max.y : min.y;
+        float z = (planes[p][2] >= 0) ? max.z : min.z;
+        if (planes[p][0]*x + planes[p][1]*y + planes[p][2]*z + planes[p][3]
+            < 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Returns true if the box between min and max is within reach of a dynamic
+ * light at p.
+ */
+bool Terrain::isNear(vector4 p, vector4 min, vector4 max)
+{
+    float d2 = 0;
+    for (int k=0; k<3; k++) {
+        float d = 0;
+        if (p[k] < min[k]) {
+            d = min[k] - p[k];
+        } else if (p[k] > max[k]) {
+            d = p[k] - max[k];
+        }
+        d2 += d*d;
+    }
+    return d2 < LIGHT_RADIUS*LIGHT_RADIUS;
+}
@@ -0,0 +1,312 @@
+/************************************************************************
+ *
+ * terrain.h
+ * Terrain class
+ *
+ ************************************************************************/
+
+#ifndef TERRAIN_H
+#define TERRAIN_H
+
+#include "cell.h"
+#include "texture.h"
+
+#include <GL/gl.h>
+
+#include <vector>
+
+#define TERRAIN_CHUNK_SIZE 8  // chunks are this many cells along each side
+
+/**
+ * The Terrain draws the cells of a maze. The maze is divided into square
+ * chunks of cells, and the geometry of each chunk (the tops, sides and
+ * outlines of its cells) is baked into indexed vertex arrays in world space.
+ * A chunk is drawn with one call per texture plus one for the outlines,
+ * instead of a display list and matrix changes for every cell.
+ *
+ * Each cell is a hexagonal prism, but only the sides that can be seen are
+ * built: a side is left out where the neighbouring cell is at least as high,
+ * and otherwise it only reaches down to the top of the neighbour.
+ *
+ * When a cell changes height, it marks its chunk and the chunks of its
+ * neighbours dirty, and only those chunks are rebuilt before the next frame.
+ * Changes to a cell's colour only rewrite the colours of its chunk. Chunks
+ * outside the view are not drawn.
+ *
+ * Chunks further from the camera are drawn with less detail, as decided by
+ * the LevelOfDetail: without outlines, and further still, as flat shaded
+ * tops without textures or sides.
+ *
+ * The static lighting (the ambient light and the sun, a fixed light from
+ * above) is baked into the vertex colours, so the terrain is drawn without
+ * OpenGL lighting. The entities are lit by the same sun, with OpenGL
+ * lighting, so that they match the terrain wherever the camera is. Only the dynamic lights of
+ * the hero and the haggis are applied at runtime, in a second pass over the
+ * chunks they can reach.
+ */
+class Maze;
+
+class Terrain
+{
+public:
+    /**
+     * Constructor. The terrain is initially empty.
+     */
+    Terrain();
+
+    /**
+     * Destructor.
+     */
+    ~Terrain();
+
+    /**
+     * Divide the visible cells of the maze into chunks. The cells are told
+     * which chunk they belong to. The geometry is built when the terrain is
+     * first rendered.
+     */
+    void build(Maze *maze);
+
+    /**
+     * Remove all the chunks and detach the cells from the terrain.
+     */
+    void clear();
+
+    /**
+     * Mark the chunk so that its geometry is rebuilt before it is next
+     * drawn.
+     */
+    void markDirty(int chunk);
+
+    /**
+     * Mark the chunk of the cell, and the chunks of its neighbours, whose
+     * sides depend on the cell, so that they are rebuilt before they are
+     * next drawn. This is called when the cell changes height.
+     */
+    void markCellDirty(Cell *cell);
+
+    /**
+     * Mark the chunk so that the colours of its cells are updated before it
+     * is next drawn.
+     */
+    void markColorDirty(int chunk);
+
+    /**
+     * Remove the dynamic lights.
+     */
+    void clearLights();
+
+    /**
+     * Add a dynamic light at the position in world space. The light's
+     * colour and attenuation are set by its owner. It is only applied to the
+     * chunks within its reach.
+     */
+    void addLight(GLenum id, vector4 pos);
+
+    /**
+     * Set up the OpenGL light as the sun that is baked into the terrain, so
+     * that the entities are lit in the same way. The camera's modelview
+     * matrix must be loaded, since the sun shines from a fixed direction in
+     * world space.
+     */
+    static void placeSun(GLenum id);
+
+    /**
+     * Draw the terrain. Dirty chunks are rebuilt first. The current
+     * modelview and projection matrices are used to skip chunks that cannot
+     * be seen, and the distance to the camera decides how much detail the
+     * others are drawn with. OpenGL lighting must be disabled.
+     */
+    void render();
+
+    /**
+     * Returns the number of chunks.
+     */
+    int getChunkCount();
+
+    /**
+     * Returns the number of chunks drawn by the last render.
+     */
+    int getChunksDrawn();
+
+    /**
+     * Returns the number of chunks that dynamic lights were applied to by
+     * the last render.
+     */
+    int getLitChunks();
+
+    /**
+     * Returns the number of draw calls made by the last render.
+     */
+    int getDrawCalls();
+
+    /**
+     * Returns the number of times a chunk has been rebuilt since the
+     * terrain was built.
+     */
+    int getRebuildCount();
+
+    /**
+     * Returns the number of triangles in the terrain, not counting chunks
+     * that have not been built yet.
+     */
+    int getTriangleCount();
+
+    /**
+     * Returns the number of vertices in the terrain, not counting chunks
+     * that have not been built yet.
+     */
+    int getVertexCount();
+
+private:
+    /**
+     * A vertex in a chunk's vertex arrays.
+     */
+    struct Vertex
+    {
+        float pos[3];
+        float normal[3];
+        float tex[2];
+        float color[4];     // the colour of the cell with baked lighting
+        float base[4];      // the colour of the cell
+        float light;        // the brightness of the static lighting
+    };
+
+    /**
+     * A run of triangle indices that use the same texture.
+     */
+    struct Run
+    {
+        Texture *tex;
+        int first;
+        int count;
+    };
+
+    /**
+     * The vertices that belong to a cell, so that its colour can be changed.
+     */
+    struct Span
+    {
+        Cell *cell;
+        int first;
+        int count;
+    };
+
+    /**
+     * A square group of cells that is drawn together.
+     */
+    struct Chunk
+    {
+        std::vector<Cell*> cells;
+        std::vector<Vertex> vertices;
+        std::vector<GLushort> triangles;
+        std::vector<GLushort> tops;
+        std::vector<Vertex> lineVertices;
+        std::vector<GLushort> lines;
+        std::vector<Run> runs;
+        std::vector<Span> spans;
+        vector4 min, max;   // the bounding box in world space
+        bool dirty;
+        bool colorDirty;
+    };
+
+    /**
+     * A dynamic light.
+     */
+    struct Light
+    {
+        GLenum id;
+        vector4 pos;
+    };
+
+    /**
+     * The maze whose cells are drawn. It is NULL if the terrain is empty.
+     */
+    Maze *maze;
+
+    /**
+     * The chunks.
+     */
+    std::vector<Chunk> chunks;
+
+    /**
+     * The dynamic lights.
+     */
+    std::vector<Light> lights;
+
+    /**
+     * Statistics.
+     */
+    int chunksDrawn, litChunks, drawCalls, rebuilds;
+
+    /**
+     * Rebuild the vertex arrays of the chunk from its cells.
+     */
+    void rebuild(Chunk &c);
+
+    /**
+     * Draw the triangles of the chunk, binding each texture once. The
+     * arrays must already be set up.
+     */
+    void drawRuns(Chunk &c);
+
+    /**
+     * Add the light of the dynamic lights that reach the chunk to what has
+     * already been drawn. The chunk is drawn again with OpenGL lighting
+     * using only those lights, and blended onto the baked lighting.
+     */
+    void renderLights(Chunk &c);
+
+    /**
+     * Draw only the tops of the cells in the chunk, flat shaded and without
+     * textures, in one call.
+     */
+    void renderFlat(Chunk &c);
+
+    /**
+     * Copy the colours of the cells into the vertex array of the chunk.
+     */
+    void recolor(Chunk &c);
+
+    /**
+     * Add the triangles of the cell to the chunk.
+     */
+    void addCell(Chunk &c, Cell *cell);
+
+    /**
+     * Add the outline of the cell to the chunk.
+     */
+    void addOutline(Chunk &c, Cell *cell);
+
+    /**
+     * Add a vertex at p relative to the cell to the array. Returns its
+     * index.
+     */
+    GLushort addVertex(std::vector<Vertex> &v, Cell *cell, vector4 p,
+                       vector4 n);
+
+    /**
+     * Returns the brightness of the static lighting on a surface with the
+     * normal n. This is the ambient light, and the sun.
+     */
+    float getStaticLight(vector4 n);
+
+    /**
+     * Returns how far side i of the cell, between corners i and i+1, must
+     * reach down to be seen. It is zero if the side is hidden.
+     */
+    float getSideDepth(Cell *cell, int i);
+
+    /**
+     * Returns true if the box is completely outside one of the planes of
+     * the view frustum. Each plane is given as four coefficients.
+     */
+    bool isOutside(float planes[6][4], vector4 min, vector4 max);
+
+    /**
+     * Returns true if the box between min and max is within reach of a
+     * dynamic light at p.
+     */
+    bool isNear(vector4 p, vector4 min, vector4 max);
+};
+
+#endif //TERRAIN_H
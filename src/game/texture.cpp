@@ -6,6 +6,8 @@
  ************************************************************************/
 
 #include "texture.h"
+#include "textureatlas.h"
+#include "renderstate.h"
 #include "application.h"
 
 #include "SDL/SDL.h"
@@ -39,6 +41,17 @@ Texture* Texture::load(std::string path) throw(app_error)
     return new Texture(s);
 }
 
+/**
+ * Load a texture from the file into the shared TextureAtlas. This should
+ * be used for small images that are drawn together, like the user
+ * interface widgets. An app_error is thrown if the texture cannot be
+ * loaded. If SDL is not initialised it returns NULL.
+ */
+Texture* Texture::loadPacked(std::string path) throw(app_error)
+{
+    return TextureAtlas::getInstance().load(path);
+}
+
 /**
  * Load the texture into OpenGL.
  */
@@ -50,10 +63,11 @@ void Texture::initialise()
     }
 
     //enable texture mapping
-    glEnable(GL_TEXTURE_2D);
+    RenderState &state = RenderState::getInstance();
+    state.enable(GL_TEXTURE_2D);
     //create a new texture id
     glGenTextures(1, &id);
-    glBindTexture(GL_TEXTURE_2D, id);
+    state.bindTexture(id);
 
     //set pixel packing
     glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
@@ -85,18 +99,68 @@ void Texture::initialise()
  */
 float Texture::getAspectRatio()
 {
-    return (float) surf->w / (float) surf->h;
+    return (float) w / (float) h;
+}
+
+/**
+ * Convert a texture coordinate in [0, 1] into a coordinate in the OpenGL
+ * texture. For a texture that is not packed, this does nothing.
+ */
+vector4 Texture::getTexCoord(vector4 t)
+{
+    return vector4(s0 + t.x * (s1 - s0), t0 + t.y * (t1 - t0));
+}
+
+/**
+ * Returns the texture that owns the OpenGL texture. This is the atlas
+ * page for a packed texture, and the texture itself otherwise.
+ */
+Texture *Texture::getPage()
+{
+    return page;
 }
 
 /**
  * Constructor. The texture will be in charge of the surface from now on.
  */
 Texture::Texture(SDL_Surface *s)
-    : surf(s)
+    : surf(s), id(0), page(this), w(s->w), h(s->h), s0(0), t0(0), s1(1), t1(1)
 {
     initialise();
 }
 
+/**
+ * Constructor for an empty atlas page of the given size.
+ */
+Texture::Texture(int size)
+    : surf(NULL), id(0), page(this), w(size), h(size),
+      s0(0), t0(0), s1(1), t1(1)
+{
+    glGenTextures(1, &id);
+    RenderState::getInstance().bindTexture(id);
+
+    // packed images are drawn at about their own size, so they are not
+    // mipmapped, and clamping keeps the page edges from wrapping around
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, size, size, 0, GL_RGBA,
+                 GL_UNSIGNED_BYTE, NULL);
+}
+
+/**
+ * Constructor for a packed texture of size w x h, covering the region
+ * from (s0, t0) to (s1, t1) of the page.
+ */
+Texture::Texture(Texture *page, int w, int h, float s0, float t0, float s1,
+                 float t1)
+    : surf(NULL), id(page->id), page(page), w(w), h(h),
+      s0(s0), t0(t0), s1(s1), t1(t1)
+{
+}
+
 /**
  * Destructor.
  */
@@ -105,7 +169,13 @@ Texture::~Texture()
     if (surf)
     {
         SDL_FreeSurface(surf);
+    }
+
+    // packed textures share the page's OpenGL texture
+    if (page == this)
+    {
         glDeleteTextures(1, &id);
+        RenderState::getInstance().forgetTexture(id);
     }
 }
 
@@ -114,5 +184,5 @@ Texture::~Texture()
  */
 void Texture::bind()
 {
-    glBindTexture(GL_TEXTURE_2D, id);
+    RenderState::getInstance().bindTexture(id);
 }
@@ -9,6 +9,7 @@
 #define TEXTURE_H
 
 #include "application.h"
+#include "vector4.h"
 
 #include "SDL/SDL.h"
 #include <GL/gl.h>
@@ -16,7 +17,11 @@
 #include <string>
 
 /**
- * The Texture holds a texture bitmap for loading into OpenGL.
+ * The Texture holds a texture bitmap for loading into OpenGL. A texture may
+ * also be a region of a page in the TextureAtlas, in which case it shares
+ * the OpenGL texture with the other textures on that page. Texture
+ * coordinates in [0, 1] must be passed through getTexCoord() to find the
+ * region.
  */
 class Texture {
 public:
@@ -31,6 +36,14 @@ public:
      */
     static Texture* load(std::string path) throw(app_error);
 
+    /**
+     * Load a texture from the file into the shared TextureAtlas. This should
+     * be used for small images that are drawn together, like the user
+     * interface widgets. An app_error is thrown if the texture cannot be
+     * loaded.
+     */
+    static Texture* loadPacked(std::string path) throw(app_error);
+
     /**
      * Tell OpenGL this is the texture to be used next.
      */
@@ -42,14 +55,29 @@ public:
      */
     float getAspectRatio();
 
+    /**
+     * Convert a texture coordinate in [0, 1] into a coordinate in the OpenGL
+     * texture. For a texture that is not packed, this does nothing.
+     */
+    vector4 getTexCoord(vector4 t);
+
+    /**
+     * Returns the texture that owns the OpenGL texture. This is the atlas
+     * page for a packed texture, and the texture itself otherwise. Textures
+     * with the same page can be drawn without binding another texture.
+     */
+    Texture *getPage();
+
     /**
      * Load the texture into OpenGL.
      */
     void initialise();
 
 private:
+    friend class TextureAtlas;
+
     /**
-     * The texture surface.
+     * The texture surface. It is NULL for atlas pages and packed textures.
      */
     SDL_Surface *surf;
 
@@ -58,10 +86,37 @@ private:
      */
     Texture(SDL_Surface *s);
 
+    /**
+     * Constructor for an empty atlas page of the given size.
+     */
+    Texture(int size);
+
+    /**
+     * Constructor for a packed texture of size w x h, covering the region
+     * from (s0, t0) to (s1, t1) of the page.
+     */
+    Texture(Texture *page, int w, int h, float s0, float t0, float s1,
+            float t1);
+
     /**
      * The OpenGL texture name.
      */
     GLuint id;
+
+    /**
+     * The page that owns the OpenGL texture.
+     */
+    Texture *page;
+
+    /**
+     * The size of the image in pixels.
+     */
+    int w, h;
+
+    /**
+     * The region of the OpenGL texture covered by the image.
+     */
+    float s0, t0, s1, t1;
 };
 
 #endif //TEXTURE_H
@@ -0,0 +1,185 @@
+/************************************************************************
+ *
+ * textureatlas.cpp
+ * TextureAtlas class implementation
+ *
+ ************************************************************************/
+
+#include "textureatlas.h"
+
+#include "SDL/SDL.h"
+#include "SDL/SDL_image.h"
+#include <GL/gl.h>
+
+/**
+ * Returns the atlas shared by the game.
+ */
+TextureAtlas &TextureAtlas::getInstance()
+{
+    static TextureAtlas atlas;
+    return atlas;
+}
+
+/**
+ * Constructor. The atlas is initially empty.
+ */
+TextureAtlas::TextureAtlas()
+{
+}
+
+/**
+ * Destructor. The pages are deleted.
+ */
+TextureAtlas::~TextureAtlas()
+{
+    for (unsigned i=0; i<pages.size(); i++) {
+        if (pages[i].tex) {
+            delete pages[i].tex;
+        }
+    }
+}
+
+/**
+ * Load an image from the file into the atlas and return a texture for
+ * its region. An app_error is thrown if the image cannot be loaded. If
+ * SDL is not initialised it returns NULL.
+ */
+Texture *TextureAtlas::load(std::string path) throw(app_error)
+{
+    //no texture can be loaded if SDL not initialised
+    if (!SDL_WasInit(0)) {
+        return NULL;
+    }
+
+    // the image may already be packed
+    std::map<std::string, Region>::iterator i = regions.find(path);
+    if (i != regions.end()) {
+        return createTexture(i->second);
+    }
+
+    SDL_Surface *s = IMG_Load(path.c_str());
+    if (!s) {
+        std::string s = "Error loading texture " + path + ": ";
+        throw app_error(s + IMG_GetError());
+    }
+
+    Region r;
+    int x, y;
+    if (!allocate(s->w, s->h, r.page, x, y)) {
+        // too big to pack
+        return new Texture(s);
+    }
+
+    upload(s, r.page, x, y);
+
+    // sample the centres of the edge pixels so that filtering does not
+    // pick up the neighbouring images
+    r.w = s->w;
+    r.h = s->h;
+    r.s0 = (x + 0.5) / ATLAS_PAGE_SIZE;
+    r.t0 = (y + 0.5) / ATLAS_PAGE_SIZE;
+    r.s1 = (x + r.w - 0.5) / ATLAS_PAGE_SIZE;
+    r.t1 = (y + r.h - 0.5) / ATLAS_PAGE_SIZE;
+    regions[path] = r;
+
+    SDL_FreeSurface(s);
+
+    return createTexture(r);
+}
+
+/**
+ * Find space for an image of size w x h. Returns false if the image is
+ * too big for a page. Otherwise the page index and the position of the
+ * top-left corner of the space are returned in page, x and y. A new page
+ * is started when the last one is full.
+ */
+bool TextureAtlas::allocate(int w, int h, int &page, int &x, int &y)
+{
+    if ((w > ATLAS_PAGE_SIZE) || (h > ATLAS_PAGE_SIZE)) {
+        return false;
+    }
+
+    if (!pages.empty()) {
+        Page &p = pages.back();
+
+        // start a new shelf if the image does not fit on the end of this one
+        if (p.x + w > ATLAS_PAGE_SIZE) {
+            p.x = 0;
+            p.y += p.height + ATLAS_PADDING;
+            p.height = 0;
+        }
+
+        if (p.y + h <= ATLAS_PAGE_SIZE) {
+            page = pages.size() - 1;
+            x = p.x;
+            y = p.y;
+
+            p.x += w + ATLAS_PADDING;
+            if (h > p.height) {
+                p.height = h;
+            }
+            return true;
+        }
+    }
+
+    // the last page is full
+    Page p;
+    p.tex = NULL;
+    p.x = w + ATLAS_PADDING;
+    p.y = 0;
+    p.height = h;
+    pages.push_back(p);
+
+    page = pages.size() - 1;
+    x = 0;
+    y = 0;
+    return true;
+}
+
+/**
+ * Returns the number of pages.
+ */
+int TextureAtlas::getPageCount()
+{
+    return pages.size();
+}
+
+/**
+ * Copy the pixels of the surface into the page at (x, y).
+ */
+void TextureAtlas::upload(SDL_Surface *s, int page, int x, int y)
+{
+    Page &p = pages[page];
+    if (!p.tex) {
+        p.tex = new Texture(ATLAS_PAGE_SIZE);
+    }
+
+    // the page is RGBA, so RGB images get an opaque alpha channel
+    int bpp = s->format->BytesPerPixel;
+    std::vector<unsigned char> pixels(s->w * s->h * 4);
+    for (int j=0; j<s->h; j++) {
+        unsigned char *src = (unsigned char*) s->pixels + j * s->pitch;
+        unsigned char *dst = &pixels[j * s->w * 4];
+        for (int i=0; i<s->w; i++) {
+            dst[0] = src[0];
+            dst[1] = src[1];
+            dst[2] = src[2];
+            dst[3] = (bpp == 4) ? src[3] : 255;
+            src += bpp;
+            dst += 4;
+        }
+    }
+
+    p.tex->bind();
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, s->w, s->h, GL_RGBA,
+                    GL_UNSIGNED_BYTE, &pixels[0]);
+}
+
+/**
+ * Create a texture for the region.
+ */
+Texture *TextureAtlas::createTexture(Region &r)
+{
+    return new Texture(pages[r.page].tex, r.w, r.h, r.s0, r.t0, r.s1, r.t1);
+}
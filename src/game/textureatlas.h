@@ -0,0 +1,112 @@
+/************************************************************************
+ *
+ * textureatlas.h
+ * TextureAtlas class
+ *
+ ************************************************************************/
+
+#ifndef TEXTUREATLAS_H
+#define TEXTUREATLAS_H
+
+#include "texture.h"
+#include "application.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+#define ATLAS_PAGE_SIZE 1024  // width and height of a page in pixels
+#define ATLAS_PADDING 1       // pixels left empty between images
+
+/**
+ * The TextureAtlas packs small images into a few large OpenGL textures, the
+ * pages, so that widgets using different images can be drawn without
+ * binding another texture. Images are packed in shelves: rows of images
+ * that are as high as the tallest image in the row.
+ *
+ * Every image is only packed once. Loading the same file again returns a
+ * new Texture for the same region, which the caller may delete as usual.
+ * Images that are too big for a page are loaded as normal textures.
+ */
+class TextureAtlas
+{
+public:
+    /**
+     * Returns the atlas shared by the game.
+     */
+    static TextureAtlas &getInstance();
+
+    /**
+     * Constructor. The atlas is initially empty.
+     */
+    TextureAtlas();
+
+    /**
+     * Destructor. The pages are deleted.
+     */
+    ~TextureAtlas();
+
+    /**
+     * Load an image from the file into the atlas and return a texture for
+     * its region. An app_error is thrown if the image cannot be loaded. If
+     * SDL is not initialised it returns NULL.
+     */
+    Texture *load(std::string path) throw(app_error);
+
+    /**
+     * Find space for an image of size w x h. Returns false if the image is
+     * too big for a page. Otherwise the page index and the position of the
+     * top-left corner of the space are returned in page, x and y. A new page
+     * is started when the last one is full.
+     */
+    bool allocate(int w, int h, int &page, int &x, int &y);
+
+    /**
+     * Returns the number of pages.
+     */
+    int getPageCount();
+
+private:
+    /**
+     * A page of the atlas.
+     */
+    struct Page
+    {
+        Texture *tex;   // NULL until an image is copied onto the page
+        int x;          // the left edge of the free space in the shelf
+        int y;          // the top edge of the shelf
+        int height;     // the height of the shelf
+    };
+
+    /**
+     * A packed image.
+     */
+    struct Region
+    {
+        int page;
+        int w, h;
+        float s0, t0, s1, t1;
+    };
+
+    /**
+     * The pages.
+     */
+    std::vector<Page> pages;
+
+    /**
+     * The packed images, by file name.
+     */
+    std::map<std::string, Region> regions;
+
+    /**
+     * Copy the pixels of the surface into the page at (x, y).
+     */
+    void upload(SDL_Surface *s, int page, int x, int y);
+
+    /**
+     * Create a texture for the region.
+     */
+    Texture *createTexture(Region &r);
+};
+
+#endif //TEXTUREATLAS_H
@@ -0,0 +1,186 @@
+/************************************************************************
+ *
+ * thinker.cpp
+ * Thinker class implementation
+ *
+ ************************************************************************/
+
+#include "thinker.h"
+
+/**
+ * Constructor. The thinker uses the policy, which must be able to ponder,
+ * and takes its random numbers from the seed. The thread is started
+ * straight away, and waits until there is something to think about.
+ */
+Thinker::Thinker(Policy *policy, uint32_t seed)
+    : policy(policy), random(seed), busy(false), current(0), generation(0),
+      quit(false)
+{
+    lock = SDL_CreateMutex();
+    wake = SDL_CreateCond();
+    thread = SDL_CreateThread(run, this);
+}
+
+/**
+ * Destructor. This waits for a move being chosen to be finished, since the
+ * policy's search can't be interrupted.
+ */
+Thinker::~Thinker()
+{
+    SDL_LockMutex(lock);
+    quit = true;
+    queue.clear();
+    SDL_CondSignal(wake);
+    SDL_UnlockMutex(lock);
+
+    SDL_WaitThread(thread, NULL);
+    SDL_DestroyCond(wake);
+    SDL_DestroyMutex(lock);
+}
+
+/**
+ * Start thinking about the haggis' replies to the hero's moves from the
+ * state, which must be the hero's turn. The replies chosen for the last
+ * turn are forgotten, since they can't be needed again.
+ */
+void Thinker::ponder(const GameState &s)
+{
+    SDL_LockMutex(lock);
+    generation++;
+    queue.clear();
+    moves.clear();
+    queue.push_back(s);
+    SDL_CondSignal(wake);
+    SDL_UnlockMutex(lock);
+}
+
+/**
+ * Start thinking about the haggis' move in the state, which must be the
+ * haggis' turn, unless the move has already been chosen or is being
+ * chosen. Pondering on other positions stops.
+ */
+void Thinker::think(const GameState &s)
+{
+    const uint64_t key = s.hash();
+
+    SDL_LockMutex(lock);
+    if ((moves.find(key) == moves.end()) && !(busy && (current == key))) {
+        generation++;
+        queue.clear();
+        queue.push_back(s);
+        SDL_CondSignal(wake);
+    } else if (!queue.empty()) {
+        generation++;
+        queue.clear();
+    }
+    SDL_UnlockMutex(lock);
+}
+
+/**
+ * If the haggis' move in the state has been chosen, set m to it and return
+ * true. This never waits for the move to be chosen.
+ */
+bool Thinker::getMove(const GameState &s, Move &m)
+{
+    SDL_LockMutex(lock);
+    std::map<uint64_t, Move>::iterator it = moves.find(s.hash());
+    bool found = (it != moves.end());
+    if (found) {
+        m = it->second;
+    }
+    SDL_UnlockMutex(lock);
+
+    return found;
+}
+
+/**
+ * Returns true if the thinker has nothing left to think about.
+ */
+bool Thinker::isIdle()
+{
+    SDL_LockMutex(lock);
+    bool idle = !busy && queue.empty();
+    SDL_UnlockMutex(lock);
+
+    return idle;
+}
+
+/**
+ * The body of the thread.
+ */
+int Thinker::run(void *data)
+{
+    ((Thinker *) data)->loop();
+    return 0;
+}
+
+/**
+ * Think about the positions in the queue until told to stop. The lock is
+ * let go of while the policy chooses, so the game can carry on asking for
+ * moves and giving new positions.
+ */
+void Thinker::loop()
+{
+    SDL_LockMutex(lock);
+    while (!quit) {
+        if (queue.empty()) {
+            SDL_CondWait(wake, lock);
+            continue;
+        }
+
+        GameState s = queue.front();
+        queue.pop_front();
+        const uint64_t key = s.hash();
+        if (moves.find(key) != moves.end()) {
+            continue;
+        }
+        const int started = generation;
+        busy = true;
+        current = key;
+        SDL_UnlockMutex(lock);
+
+        Move m = policy->choose(s, random);
+
+        SDL_LockMutex(lock);
+        busy = false;
+        if (!s.heroTurn) {
+            moves[key] = m;
+        } else if (generation == started) {
+            expand(s, m);
+        }
+    }
+    SDL_UnlockMutex(lock);
+}
+
+/**
+ * Add the positions after the hero's likely move from the state, and after
+ * PONDER_REPLIES of its other moves, to the queue. The hero's turn is long
+ * enough for many searches, but each one takes a processor, so only a few
+ * replies are thought about. Positions where the game is over need no
+ * reply. The lock must be held.
+ */
+void Thinker::expand(const GameState &s, const Move &likely)
+{
+    std::vector<Move> heroMoves;
+    GameRules::getMoves(s, heroMoves);
+
+    GameState t = s;
+    GameRules::play(t, likely);
+    if (!GameRules::isOver(t)) {
+        queue.push_back(t);
+    }
+
+    int replies = 0;
+    for (unsigned int k=0; (k<heroMoves.size()) && (replies<PONDER_REPLIES);
+         k++) {
+        if (heroMoves[k] == likely) {
+            continue;
+        }
+        t = s;
+        GameRules::play(t, heroMoves[k]);
+        if (!GameRules::isOver(t)) {
+            queue.push_back(t);
+            replies++;
+        }
+    }
+}
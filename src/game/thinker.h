@@ -0,0 +1,159 @@
+/************************************************************************
+ *
+ * thinker.h
+ * Thinker class
+ *
+ ************************************************************************/
+
+#ifndef THINKER_H
+#define THINKER_H
+
+#include "policy.h"
+
+#include <SDL/SDL.h>
+
+#include <deque>
+#include <map>
+#include <vector>
+
+#define THINKER_THREADS 1  // the search threads of a policy run by a thinker
+#define PONDER_REPLIES 3   // the other hero moves whose replies are pondered
+
+/**
+ * The Thinker runs a policy on a thread of its own, so that the haggis can
+ * take as long as its search needs to choose a move without holding up the
+ * frames being drawn.
+ *
+ * While the hero is deciding what to do, the thinker ponders: it asks the
+ * policy what the hero is most likely to do, and then works out the
+ * haggis' reply to that move, followed by the replies to a few of the
+ * hero's other moves. It then waits, rather than keeping a processor busy
+ * for the rest of the hero's turn. As soon as the hero commits to a move,
+ * the thinker is told the position it leads to, and drops everything else
+ * to think about that, if it hasn't already. The haggis then picks up the
+ * reply when its turn comes, which it usually is by the time the hero's
+ * move has been animated.
+ *
+ * The replies are handed over through a table keyed by the hash of the
+ * position they answer, which is only touched with the thinker's lock
+ * held. The policy and the random numbers are only used by the thinker's
+ * thread.
+ */
+class Thinker
+{
+public:
+    /**
+     * Constructor. The thinker uses the policy, which must be able to
+     * ponder, and takes its random numbers from the seed. The policy must
+     * not be used by anything else while the thinker exists, and it is
+     * not deleted by the thinker. Since the thinker runs while frames are
+     * being drawn, the policy should search with no more than
+     * THINKER_THREADS threads, so that the drawing keeps a processor.
+     */
+    Thinker(Policy *policy, uint32_t seed);
+
+    /**
+     * Destructor. This waits for a move being chosen to be finished.
+     */
+    ~Thinker();
+
+    /**
+     * Start thinking about the haggis' replies to the hero's moves from
+     * the state, which must be the hero's turn. Anything that was being
+     * thought about before is dropped.
+     */
+    void ponder(const GameState &s);
+
+    /**
+     * Start thinking about the haggis' move in the state, which must be the
+     * haggis' turn, unless the move has already been chosen or is being
+     * chosen. Pondering on other positions stops.
+     */
+    void think(const GameState &s);
+
+    /**
+     * If the haggis' move in the state has been chosen, set m to it and
+     * return true. This never waits for the move to be chosen.
+     */
+    bool getMove(const GameState &s, Move &m);
+
+    /**
+     * Returns true if the thinker has nothing left to think about.
+     */
+    bool isIdle();
+
+private:
+    /**
+     * The policy that chooses the moves.
+     */
+    Policy *policy;
+
+    /**
+     * The random numbers for the policy.
+     */
+    Random random;
+
+    /**
+     * The thinker's thread.
+     */
+    SDL_Thread *thread;
+
+    /**
+     * The lock for everything below.
+     */
+    SDL_mutex *lock;
+
+    /**
+     * Signalled when there is something new to think about, or the thread
+     * should stop.
+     */
+    SDL_cond *wake;
+
+    /**
+     * The positions to think about, with the next first. A position where
+     * it is the hero's turn is pondered: the positions after the hero's
+     * moves are added to the queue.
+     */
+    std::deque<GameState> queue;
+
+    /**
+     * The moves that have been chosen, by the hash of their position.
+     */
+    std::map<uint64_t, Move> moves;
+
+    /**
+     * True while a move is being chosen, when current is the hash of its
+     * position.
+     */
+    bool busy;
+    uint64_t current;
+
+    /**
+     * Counts the calls to ponder() and think(), so that a pondering that
+     * finishes after the hero has moved is not carried on with.
+     */
+    int generation;
+
+    /**
+     * True when the thread should stop.
+     */
+    bool quit;
+
+    /**
+     * The body of the thread.
+     */
+    static int run(void *data);
+
+    /**
+     * Think about the positions in the queue until told to stop.
+     */
+    void loop();
+
+    /**
+     * Add the positions after the hero's likely move from the state, and
+     * after PONDER_REPLIES of its other moves, to the queue.
+     */
+    void expand(const GameState &s, const Move &likely);
+};
+
+#endif //THINKER_H
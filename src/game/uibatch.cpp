@@ -0,0 +1,262 @@
+/************************************************************************
+ *
+ * uibatch.cpp
+ * UIBatch class implementation
+ *
+ ************************************************************************/
+
+#include "uibatch.h"
+#include "renderstate.h"
+
+#include <GL/gl.h>
+
+#include <algorithm>
+
+/**
+ * Returns the batch used by the user interface.
+ */
+UIBatch &UIBatch::getInstance()
+{
+    static UIBatch batch;
+    return batch;
+}
+
+/**
+ * Constructor. The batch is initially empty.
+ */
+UIBatch::UIBatch()
+    : aspect(1), quadCount(0), drawCalls(0)
+{
+}
+
+/**
+ * Add a quad with its bottom-left corner at pos relative to the current
+ * origin. The whole texture is mapped onto the quad. The texture may be
+ * NULL, in which case the quad is filled with the colour.
+ */
+void UIBatch::addQuad(Texture *tex, vector4 pos, vector4 size,
+                      float r, float g, float b, float a)
+{
+    Quad q;
+    q.tex = NULL;
+    q.outline = false;
+    q.s0 = q.t0 = 0;
+    q.s1 = q.t1 = 1;
+    if (tex) {
+        // quads are grouped by atlas page, not by image
+        q.tex = tex->getPage();
+        vector4 t0 = tex->getTexCoord(vector4(0, 0));
+        vector4 t1 = tex->getTexCoord(vector4(1, 1));
+        q.s0 = t0.x;
+        q.t0 = t0.y;
+        q.s1 = t1.x;
+        q.t1 = t1.y;
+    }
+    q.x0 = origin.x + pos.x;
+    q.y0 = origin.y + pos.y;
+    q.x1 = q.x0 + size.x;
+    q.y1 = q.y0 + size.y;
+    q.color[0] = r;
+    q.color[1] = g;
+    q.color[2] = b;
+    q.color[3] = a;
+    q.layer = 0;
+    quads.push_back(q);
+}
+
+/**
+ * Add a rectangle outline with its bottom-left corner at pos relative to
+ * the current origin.
+ */
+void UIBatch::addOutline(vector4 pos, vector4 size, float r, float g, float b)
+{
+    addQuad(NULL, pos, size, r, g, b);
+    quads.back().outline = true;
+}
+
+/**
+ * Move the origin by pos.
+ */
+void UIBatch::pushOrigin(vector4 pos)
+{
+    origins.push_back(origin);
+    origin += pos;
+}
+
+/**
+ * Move the origin back to where it was before the last pushOrigin().
+ */
+void UIBatch::popOrigin()
+{
+    origin = origins.back();
+    origins.pop_back();
+}
+
+/**
+ * Set the aspect ratio of the root window.
+ */
+void UIBatch::setAspect(float aspect)
+{
+    this->aspect = aspect;
+}
+
+/**
+ * Orders quads by layer, then outlines after fills, then by texture.
+ */
+bool UIBatch::less(const Quad &a, const Quad &b)
+{
+    if (a.layer != b.layer) {
+        return a.layer < b.layer;
+    }
+    if (a.outline != b.outline) {
+        return b.outline;
+    }
+    return a.tex < b.tex;
+}
+
+/**
+ * Sort the quads and fill in the vertex array and the groups.
+ */
+void UIBatch::build()
+{
+    // A quad must be drawn after every earlier quad that it overlaps. If the
+    // earlier quad is drawn differently, the quad goes on a later layer so
+    // that sorting by texture cannot swap them.
+    for (unsigned i=0; i<quads.size(); i++) {
+        Quad &q = quads[i];
+        for (unsigned j=0; j<i; j++) {
+            Quad &p = quads[j];
+            if ((q.x0 < p.x1) && (p.x0 < q.x1) &&
+                (q.y0 < p.y1) && (p.y0 < q.y1)) {
+                bool same = (q.tex == p.tex) && (q.outline == p.outline);
+                q.layer = std::max(q.layer, same ? p.layer : p.layer+1);
+            }
+        }
+    }
+
+    // stable, so that quads in the same group stay in the order they were
+    // added
+    std::stable_sort(quads.begin(), quads.end(), less);
+
+    vertices.clear();
+    groups.clear();
+
+    for (unsigned i=0; i<quads.size(); i++) {
+        Quad &q = quads[i];
+
+        if (groups.empty() || (groups.back().tex != q.tex) ||
+            (groups.back().outline != q.outline)) {
+            Group g;
+            g.tex = q.tex;
+            g.outline = q.outline;
+            g.first = vertices.size();
+            g.count = 0;
+            groups.push_back(g);
+        }
+
+        // the corners in counter-clockwise order, with the texture upside
+        // down since images are stored top row first
+        float corners[4][4] = {
+            {q.x0, q.y0, q.s0, q.t1},
+            {q.x1, q.y0, q.s1, q.t1},
+            {q.x1, q.y1, q.s1, q.t0},
+            {q.x0, q.y1, q.s0, q.t0}
+        };
+
+        // outlines are drawn as four lines, fills as one quad
+        int n = q.outline ? 8 : 4;
+        for (int k=0; k<n; k++) {
+            int c = q.outline ? ((k+1)/2)%4 : k;
+            Vertex v;
+            v.x = corners[c][0];
+            v.y = corners[c][1];
+            v.s = corners[c][2];
+            v.t = corners[c][3];
+            for (int l=0; l<4; l++) {
+                v.color[l] = q.color[l];
+            }
+            vertices.push_back(v);
+        }
+        groups.back().count += n;
+    }
+}
+
+/**
+ * Draw everything in the batch and empty it.
+ */
+void UIBatch::flush()
+{
+    quadCount = quads.size();
+    drawCalls = 0;
+
+    if (quads.empty()) {
+        return;
+    }
+
+    build();
+
+    // set up the projection once for the whole batch
+    glMatrixMode(GL_PROJECTION);
+    glPushMatrix();
+    glLoadIdentity();
+    glOrtho(0, aspect, 0, 1, 1, -1);
+    glMatrixMode(GL_MODELVIEW);
+    glPushMatrix();
+    glLoadIdentity();
+
+    RenderState &state = RenderState::getInstance();
+    state.disable(GL_DEPTH_TEST);
+    state.enable(GL_BLEND);
+    state.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    glTexEnvf(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, GL_MODULATE);
+
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(Vertex), &vertices[0].x);
+    glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), &vertices[0].s);
+    glColorPointer(4, GL_FLOAT, sizeof(Vertex), vertices[0].color);
+
+    for (unsigned i=0; i<groups.size(); i++) {
+        Group &g = groups[i];
+        if (g.tex) {
+            state.enable(GL_TEXTURE_2D);
+            g.tex->bind();
+        } else {
+            state.disable(GL_TEXTURE_2D);
+        }
+        glDrawArrays(g.outline ? GL_LINES : GL_QUADS, g.first, g.count);
+    }
+    drawCalls = groups.size();
+
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    state.forgetColor();
+
+    state.disable(GL_TEXTURE_2D);
+    state.disable(GL_BLEND);
+
+    glPopMatrix();
+    glMatrixMode(GL_PROJECTION);
+    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+
+    quads.clear();
+}
+
+/**
+ * Returns the number of quads and outlines drawn by the last flush.
+ */
+int UIBatch::getQuadCount()
+{
+    return quadCount;
+}
+
+/**
+ * Returns the number of draw calls made by the last flush.
+ */
+int UIBatch::getDrawCalls()
+{
+    return drawCalls;
+}
@@ -0,0 +1,166 @@
+/************************************************************************
+ *
+ * uibatch.h
+ * UIBatch class
+ *
+ ************************************************************************/
+
+#ifndef UIBATCH_H
+#define UIBATCH_H
+
+#include "vector4.h"
+#include "texture.h"
+
+#include <vector>
+
+/**
+ * The UIBatch collects the quads drawn by the user interface widgets during a
+ * render pass and draws them all at once from a single vertex array. Quads
+ * that share a texture, or an atlas page, are drawn together, unless that would
+ * change the order of quads that overlap. The projection matrix is only set up once per flush.
+ *
+ * Widgets add quads in their own coordinate system. Window::render() keeps
+ * track of the window origins with pushOrigin() and popOrigin(), and the root
+ * window flushes the batch at the end of each pass.
+ */
+class UIBatch
+{
+public:
+    /**
+     * Returns the batch used by the user interface.
+     */
+    static UIBatch &getInstance();
+
+    /**
+     * Constructor. The batch is initially empty.
+     */
+    UIBatch();
+
+    /**
+     * Add a quad with its bottom-left corner at pos relative to the current
+     * origin. The whole texture is mapped onto the quad. The texture may be
+     * NULL, in which case the quad is filled with the colour.
+     */
+    void addQuad(Texture *tex, vector4 pos, vector4 size,
+                 float r, float g, float b, float a = 1);
+
+    /**
+     * Add a rectangle outline with its bottom-left corner at pos relative to
+     * the current origin.
+     */
+    void addOutline(vector4 pos, vector4 size, float r, float g, float b);
+
+    /**
+     * Move the origin by pos. This is called by Window::render() for every
+     * window.
+     */
+    void pushOrigin(vector4 pos);
+
+    /**
+     * Move the origin back to where it was before the last pushOrigin().
+     */
+    void popOrigin();
+
+    /**
+     * Set the aspect ratio of the root window. It is used to set up the
+     * projection when the batch is flushed.
+     */
+    void setAspect(float aspect);
+
+    /**
+     * Draw everything in the batch and empty it.
+     */
+    void flush();
+
+    /**
+     * Returns the number of quads and outlines drawn by the last flush.
+     */
+    int getQuadCount();
+
+    /**
+     * Returns the number of draw calls made by the last flush.
+     */
+    int getDrawCalls();
+
+private:
+    /**
+     * A quad or outline waiting to be drawn.
+     */
+    struct Quad
+    {
+        Texture *tex;   // the page of the texture
+        bool outline;
+        float x0, y0, x1, y1;
+        float s0, t0, s1, t1;
+        float color[4];
+        int layer;
+    };
+
+    /**
+     * A vertex in the vertex array.
+     */
+    struct Vertex
+    {
+        float x, y;
+        float s, t;
+        float color[4];
+    };
+
+    /**
+     * A run of vertices that are drawn with one call.
+     */
+    struct Group
+    {
+        Texture *tex;
+        bool outline;
+        int first;
+        int count;
+    };
+
+    /**
+     * Orders quads by layer, then outlines after fills, then by texture.
+     */
+    static bool less(const Quad &a, const Quad &b);
+
+    /**
+     * The quads added since the last flush.
+     */
+    std::vector<Quad> quads;
+
+    /**
+     * The vertex array. It is kept between flushes to avoid reallocating it.
+     */
+    std::vector<Vertex> vertices;
+
+    /**
+     * The draw calls for the vertex array.
+     */
+    std::vector<Group> groups;
+
+    /**
+     * The stack of window origins.
+     */
+    std::vector<vector4> origins;
+
+    /**
+     * The current origin.
+     */
+    vector4 origin;
+
+    /**
+     * The aspect ratio of the root window.
+     */
+    float aspect;
+
+    /**
+     * Statistics for the last flush.
+     */
+    int quadCount, drawCalls;
+
+    /**
+     * Sort the quads and fill in the vertex array and the groups.
+     */
+    void build();
+};
+
+#endif //UIBATCH_H
@@ -6,6 +6,7 @@
  ************************************************************************/
 
 #include "waitaction.h"
+#include "gamerules.h"
 
 #include <cmath>
 
@@ -26,7 +27,7 @@ WaitAction::WaitAction(Player *player)
 {
     initial = player->getRotation();
     t = 0;
-    T = 0.5; // wait for half a second
+    T = WAIT_TIME;
 }
 
 /**
@@ -52,3 +53,12 @@ bool WaitAction::update(float dt)
         return true;
     }
 }
+
+/**
+ * Set m to a wait, and return true.
+ */
+bool WaitAction::getMove(Move &m) const
+{
+    m = Move(Move::WAIT);
+    return true;
+}
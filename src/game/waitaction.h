@@ -11,11 +11,14 @@
 #include "action.h"
 #include "player.h"
 #include "cell.h"
+#include "pool.h"
+
+#define WAIT_TIME 0.5  // the number of seconds a wait lasts
 
 /**
  * The WaitAction class causes the player to do nothing for a turn.
  */
-class WaitAction : public Action
+class WaitAction : public Action, public Pooled<WaitAction>
 {
 public:
     /**
@@ -39,6 +42,11 @@ public:
      */
     virtual bool update(float dt);
 
+    /**
+     * Set m to a wait, and return true.
+     */
+    virtual bool getMove(Move &m) const;
+
 private:
     /**
      * The player that is being moved.
@@ -6,9 +6,9 @@
  ************************************************************************/
 
 #include "walkaction.h"
+#include "gamerules.h"
 
 #define VEL 10.0 // animation speed
-#define ENERGY 1 // amount of energy needed to walk
 
 /**
  * Returns true if the player can perform a walk action. This checks
@@ -16,7 +16,7 @@
  */
 bool WalkAction::canWalk(Player *player)
 {
-    return (player->getEnergy() >= ENERGY);
+    return (player->getEnergy() >= WALK_ENERGY);
 }
 
 /**
@@ -29,13 +29,14 @@ void WalkAction::markSelectable(Player *player, Maze *maze)
         return;
     }
 
-    for(std::vector<Cell*>::iterator i = player->getCell()->neighbours.begin();
-        i != player->getCell()->neighbours.end(); i++)
+    for(int k = 0; k < MazeGrid::getNeighbourCount(); k++)
     {
-        //can't walk on walls or where another player is.
-        if((*i)->getWall() || (*i)->hasPlayer() || !(*i)->isVisible())
+        Cell *c = maze->getNeighbour(player->getCell(), k);
+
+        //can't walk off the maze, on walls or where another player is.
+        if(!c || c->getWall() || c->hasPlayer() || !c->isVisible())
             continue;
-        (*i)->setSelectable(true);
+        maze->setSelectable(c);
     }
 }
 
@@ -78,10 +79,11 @@ bool WalkAction::update(float dt)
 
     if (t >= T)
     {
-        // the animation has finished
+        // the animation has finished. The energy is taken before the
+        // player enters the cell so that any item there is applied last.
         player->setPosition(initial);
+        player->setEnergy(player->getEnergy() - WALK_ENERGY);
         player->setCell(dest, true);
-        player->setEnergy(player->getEnergy() - ENERGY);
         return false;
     }
     else
@@ -91,3 +93,14 @@ bool WalkAction::update(float dt)
 
     return true;
 }
+
+/**
+ * Set m to the walk to the destination, and return true.
+ */
+bool WalkAction::getMove(Move &m) const
+{
+    int i, j;
+    dest->getMazePosition(i, j);
+    m = Move(Move::WALK, i, j);
+    return true;
+}
@@ -12,11 +12,13 @@
 #include "player.h"
 #include "cell.h"
 #include "maze.h"
+#include "pool.h"
+#include "rules.h"
 
 /**
  * The WalkAction class moves a player from one cell to another.
  */
-class WalkAction : public Action {
+class WalkAction : public Action, public Pooled<WalkAction> {
 public:
 
     /**
@@ -47,6 +49,11 @@ public:
      */
     virtual bool update(float dt);
 
+    /**
+     * Set m to the walk to the destination, and return true.
+     */
+    virtual bool getMove(Move &m) const;
+
 private:
     /**
      * The player that is being moved.
@@ -6,19 +6,26 @@
  ************************************************************************/
 
 #include "window.h"
+#include "uibatch.h"
+#include "renderstate.h"
 
 #include <iostream>
 #include <vector>
+#include <map>
 
 #include <GL/gl.h>
 #include <GL/glu.h>
 #include "SDL/SDL.h"
 
+int Window::lastProjection = -1;
+Window *Window::renderRoot = NULL;
+
 /**
  * Constructor. The window position and size are set to the zero vector.
  */
 Window::Window()
-    : parent(NULL), proj(ORTHOGRAPHIC), enabled(true), pass(RENDER_PASS_1)
+    : parent(NULL), proj(ORTHOGRAPHIC), enabled(true), pass(RENDER_PASS_1),
+      hitsValid(false)
 {
 }
 
@@ -33,7 +40,9 @@ Window::~Window()
  * Render the contents of the window. This will not affect the screen
  * outside the window. Subclasses should override the draw() method, not
  * this method. If the window is disabled, no rendering will be performed.
- * The rendering pass is either 1 or 2.
+ * The rendering pass is either 1 or 2. A subclass that does override it
+ * must also override rendersChildren() to return true, or the override is
+ * never called when the window has a parent.
  */
 void Window::render(int pass, float dt)
 {
@@ -42,45 +51,173 @@ void Window::render(int pass, float dt)
         return;
     }
 
-    // set the projection matrix
-
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
-
-    // find the root window to calculate the aspect ratio
-    Window *root = this;
-    while (root->getParent()) {
-        root = root->getParent();
+    // find the root window to calculate the aspect ratio; the windows below
+    // it are rendered from its lists, so they only search if they are
+    // rendered on their own
+    Window *root = renderRoot;
+    if (!root) {
+        root = this;
+        while (root->getParent()) {
+            root = root->getParent();
+        }
     }
     float aspect = root->getSize().x / root->getSize().y;
 
-    if (proj == PERSPECTIVE) {
-        glEnable(GL_DEPTH_TEST);
-        gluPerspective(40, aspect, 1.0, 600.0);
-    } else {
-        glDisable(GL_DEPTH_TEST);
-        glOrtho(0, aspect, 0, 1, 1, -1);
+    // the widgets are batched and drawn by the root at the end of the pass
+    UIBatch &batch = UIBatch::getInstance();
+    if (root == this) {
+        forgetProjection();
+        batch.setAspect(aspect);
+        renderRoot = this;
     }
 
-    // draw the window
+    // the windows to draw in this pass are compiled into a list the first
+    // time, and the list is kept until the tree changes
+    std::map<int, std::vector<RenderItem> >::iterator l =
+        renderLists.find(pass);
+    if (l == renderLists.end()) {
+        std::vector<RenderItem> list;
+        RenderItem item;
+        item.win = this;
+        item.parent = -1;
+        item.kind = (getRenderPasses() & pass) ? RenderItem::DRAW :
+            RenderItem::POSITION;
+        list.push_back(item);
+        compile(pass, list, 0);
+
+        l = renderLists.insert(std::make_pair(pass, list)).first;
+    }
+    std::vector<RenderItem> &list = l->second;
 
-    // translate the coordinate system to the window space
+    // the list is in the order of the tree, so each window's parent comes
+    // before it
     glMatrixMode(GL_MODELVIEW);
-    glPushMatrix();
-    glTranslatef(getPosition().x, getPosition().y, getPosition().z);
+    for (unsigned i=0; i<list.size(); i++) {
+        RenderItem &item = list[i];
+        vector4 base;
+        if (item.parent >= 0) {
+            base = list[item.parent].origin;
+        }
 
-    // draw this window if we are in the correct render pass
-    if (getRenderPasses() & pass) {
-        draw(dt);
+        // translate the coordinate system to the window space
+        glPushMatrix();
+        if (item.kind == RenderItem::RENDER) {
+            glTranslatef(base.x, base.y, base.z);
+            batch.pushOrigin(base);
+            item.win->render(pass, dt);
+        } else {
+            item.origin = base + item.win->getPosition();
+            glTranslatef(item.origin.x, item.origin.y, item.origin.z);
+            batch.pushOrigin(item.origin);
+
+            // draw the window if it is in this render pass
+            if (item.kind == RenderItem::DRAW) {
+                item.win->loadProjection(aspect);
+                item.win->draw(dt);
+            }
+        }
+        batch.popOrigin();
+        glPopMatrix();
+    }
+
+    if (root == this) {
+        batch.flush();
+        renderRoot = NULL;
     }
+}
 
-    // render all the child windows
+/**
+ * Add the enabled windows below this one to the render list for the pass.
+ * parent is the index of this window's entry. Windows that render their
+ * own children are added without their children, and windows that are not
+ * drawn in the pass are only added if something below them is.
+ */
+void Window::compile(int pass, std::vector<RenderItem> &list, int parent)
+{
     for (std::vector<Window*>::iterator i=childs.begin(); i != childs.end();
          i++) {
-        (*i)->render(pass, dt);
+        Window *child = *i;
+        if (!child->isEnabled()) {
+            continue;
+        }
+
+        RenderItem item;
+        item.win = child;
+        item.parent = parent;
+        if (child->rendersChildren()) {
+            item.kind = RenderItem::RENDER;
+            list.push_back(item);
+            continue;
+        }
+
+        item.kind = (child->getRenderPasses() & pass) ? RenderItem::DRAW :
+            RenderItem::POSITION;
+        int index = list.size();
+        list.push_back(item);
+        child->compile(pass, list, index);
+
+        if ((item.kind == RenderItem::POSITION) &&
+            ((int) list.size() == index + 1)) {
+            list.pop_back();
+        }
+    }
+}
+
+/**
+ * Throw away the render lists of this window and of all the windows above
+ * it, since they include this window.
+ */
+void Window::invalidateRenderLists()
+{
+    for (Window *w = this; w; w = w->getParent()) {
+        w->renderLists.clear();
+    }
+}
+
+/**
+ * Set the projection matrix for the window, unless the last window drawn
+ * already set the same one.
+ */
+void Window::loadProjection(float aspect)
+{
+    if (proj == lastProjection) {
+        return;
+    }
+
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+
+    if (proj == PERSPECTIVE) {
+        RenderState::getInstance().enable(GL_DEPTH_TEST);
+        gluPerspective(40, aspect, 1.0, 600.0);
+    } else {
+        RenderState::getInstance().disable(GL_DEPTH_TEST);
+        glOrtho(0, aspect, 0, 1, 1, -1);
     }
 
-    glPopMatrix();
+    glMatrixMode(GL_MODELVIEW);
+    lastProjection = proj;
+}
+
+/**
+ * Returns true if the window overrides render() to draw itself and its
+ * children. Such windows are rendered by calling render(), instead of
+ * being compiled into their parent's render lists. Every subclass that
+ * overrides render() must override this to return true.
+ */
+bool Window::rendersChildren()
+{
+    return false;
+}
+
+/**
+ * Forget which projection matrix was set last, so that the next window
+ * to be rendered sets it again. This must be called after anything else
+ * changes the projection matrix.
+ */
+void Window::forgetProjection()
+{
+    lastProjection = -1;
 }
 
 /**
@@ -121,23 +258,19 @@ bool Window::handleMouseEvent(MouseEvent event)
         return false;
     }
 
-    //Send the event to all the children first.
-    //If any window processes it, the rest don't have to.
-    bool bHandled = false;
-
-    for (std::vector<Window*>::iterator i=childs.begin();
-	 (i != childs.end()) && (!bHandled); i++) {
-        bHandled =
-	    (*i)->handleMouseEvent(MouseEvent(event, (*i)->getPosition()));
-    }
+    //Find the windows under the mouse. The children come before their
+    //parents, so if any window processes it, the rest don't have to.
+    std::vector<HitEntry> hits;
+    findHits(event.getPosition(), hits);
 
-    if(!bHandled) {
-        // now let this class handle the MouseEvent if it hasn't been handled
-        // already
-        return onHandleMouseEvent(event);
-    } else {
-        return true; // the event was handled by a child
+    for (unsigned i=0; i<hits.size(); i++) {
+        if (hits[i].win->isEnabled() &&
+            hits[i].win->onHandleMouseEvent(MouseEvent(event,
+                                                       hits[i].offset))) {
+            return true;
+        }
     }
+    return false;
 }
 
 /**
@@ -160,22 +293,79 @@ bool Window::handleButtonEvent(ButtonEvent event)
         return false;
     }
 
-    //Send the event to all the children first.
-    //If any window processes it, the rest don't have to.
-    bool bHandled = false;
+    //Find the windows under the mouse. The children come before their
+    //parents, so if any window processes it, the rest don't have to.
+    std::vector<HitEntry> hits;
+    findHits(event.getPosition(), hits);
+
+    for (unsigned i=0; i<hits.size(); i++) {
+        if (hits[i].win->isEnabled() &&
+            hits[i].win->onHandleButtonEvent(ButtonEvent(event,
+                                                         hits[i].offset))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Add the windows that can receive events at p, relative to this window,
+ * to hits, in the order they should receive them. The index of the windows
+ * is built first if it has been thrown away.
+ */
+void Window::findHits(vector4 p, std::vector<HitEntry> &hits)
+{
+    if (!hitsValid) {
+        hitIndex.clear(getSize());
+        indexChildren(hitIndex, vector4(), vector4(), getSize());
+        hitIndex.add(this, vector4(), vector4(), getSize());
+        hitsValid = true;
+    }
+
+    hitIndex.find(p, hits);
+}
 
-    for (std::vector<Window*>::iterator i=childs.begin();
-	 (i != childs.end()) && (!bHandled); i++) {
-        bHandled =
-	    (*i)->handleButtonEvent(ButtonEvent(event, (*i)->getPosition()));
+/**
+ * Add the enabled windows below this one to the index, each after its own
+ * children. offset is the position of this window relative to the window
+ * that owns the index, and events only reach the part of a window that is
+ * inside min and max, the area of its parent.
+ */
+void Window::indexChildren(HitIndex &index, vector4 offset, vector4 min,
+                           vector4 max)
+{
+    for (std::vector<Window*>::iterator i=childs.begin(); i != childs.end();
+         i++) {
+        Window *child = *i;
+        if (!child->isEnabled()) {
+            continue;
+        }
+
+        // the part of the child inside its parent
+        vector4 o = offset + child->getPosition();
+        vector4 cmin = o;
+        vector4 cmax = o + child->getSize();
+        cmin.x = (min.x > cmin.x) ? min.x : cmin.x;
+        cmin.y = (min.y > cmin.y) ? min.y : cmin.y;
+        cmax.x = (max.x < cmax.x) ? max.x : cmax.x;
+        cmax.y = (max.y < cmax.y) ? max.y : cmax.y;
+        if ((cmin.x >= cmax.x) || (cmin.y >= cmax.y)) {
+            continue;
+        }
+
+        child->indexChildren(index, o, cmin, cmax);
+        index.add(child, o, cmin, cmax);
     }
+}
 
-    if(!bHandled) {
-        // now let this class handle the ButtonEvent if it hasn't been handled
-        // already
-        return onHandleButtonEvent(event);
-    } else {
-        return true; // the event was handled by a child
+/**
+ * Throw away the hit indices of this window and of all the windows above
+ * it, since they include this window.
+ */
+void Window::invalidateHitIndex()
+{
+    for (Window *w = this; w; w = w->getParent()) {
+        w->hitsValid = false;
     }
 }
 
@@ -191,6 +381,8 @@ void Window::addChild(Window *child)
 
     childs.push_back(child);
     child->parent = this;
+    invalidateRenderLists();
+    invalidateHitIndex();
 }
 
 /**
@@ -211,6 +403,8 @@ bool Window::removeChild(Window *child)
          i++) {
         if (*i == child) {
             childs.erase(i);
+            invalidateRenderLists();
+            invalidateHitIndex();
             child->parent = NULL;
             return true;
         }
@@ -288,6 +482,7 @@ vector4 Window::getAbsolutePosition()
 void Window::setPosition(vector4 pos)
 {
     this->pos = pos;
+    invalidateHitIndex();
 }
 
 /**
@@ -306,6 +501,7 @@ vector4 Window::getSize()
 void Window::setSize(vector4 size)
 {
     this->size = size;
+    invalidateHitIndex();
 }
 
 /**
@@ -323,6 +519,8 @@ bool Window::isEnabled()
 void Window::setEnabled(bool enabled)
 {
     this->enabled = enabled;
+    invalidateRenderLists();
+    invalidateHitIndex();
 }
 
 /**
@@ -340,6 +538,7 @@ int Window::getRenderPasses()
 void Window::setRenderPasses(int pass)
 {
     this->pass = pass;
+    invalidateRenderLists();
 
     // recursively set the children's renderpasses
     for (std::vector<Window*>::iterator i=childs.begin(); i != childs.end();
@@ -12,8 +12,10 @@
 #include "mouseevent.h"
 #include "buttonevent.h"
 #include "vector4.h"
+#include "hitindex.h"
 
 #include <vector>
+#include <map>
 
 #define RENDER_PASS_1 1
 #define RENDER_PASS_2 2
@@ -31,6 +33,14 @@
  *
  * When using Windows, you must be careful not to call the addChild() or
  * removeChild() methods when the window tree is being transversed.
+ *
+ * For each render pass, the windows to draw are compiled into a flat list,
+ * so that rendering does not walk the whole tree. The lists are thrown away
+ * by addChild(), removeChild(), setEnabled() and setRenderPasses().
+ *
+ * Similarly, mouse and button events are delivered using an index of the
+ * areas of the enabled windows, which is thrown away by addChild(),
+ * removeChild(), setEnabled(), setPosition() and setSize().
  */
 class Window
 {
@@ -50,6 +60,12 @@ public:
      * outside the window. Subclasses should override the draw() method, not
      * this method. If the window is disabled, no rendering will be performed.
      * The rendering pass is either 1 or 2.
+     *
+     * A subclass that does override this method must also override
+     * rendersChildren() to return true. Otherwise, when the window has a
+     * parent, it is compiled into the parent's render lists and only its
+     * draw() is called, so the override never runs. The override must call
+     * Window::render() exactly once if the children are to be drawn.
      */
     virtual void render(int pass, float dt);
 
@@ -174,11 +190,26 @@ protected:
      */
     void setProjection(projection p);
 
+    /**
+     * Forget which projection matrix was set last, so that the next window
+     * to be rendered sets it again. This must be called after anything else
+     * changes the projection matrix.
+     */
+    static void forgetProjection();
+
     /**
      * Draw the window contents. This should be extended by subclasses.
      */
     virtual void draw(float dt);
 
+    /**
+     * Returns true if the window overrides render() to draw itself and its
+     * children. Such windows are rendered by calling render(), instead of
+     * being compiled into their parent's render lists. Every subclass that
+     * overrides render() must override this to return true.
+     */
+    virtual bool rendersChildren();
+
     /**
      * This is called by the handleMouseEvent method. It is specific to
      * each child class and therefore the implementation can be found in
@@ -194,6 +225,93 @@ protected:
     virtual bool onHandleButtonEvent(ButtonEvent event);
 
 private:
+    /**
+     * An entry in a render list.
+     */
+    struct RenderItem
+    {
+        /**
+         * POSITION windows are not drawn in the pass, but their children
+         * are. RENDER windows are rendered by calling their render().
+         */
+        enum {POSITION, DRAW, RENDER} kind;
+
+        Window *win;
+
+        /**
+         * The index of the entry of the window's parent, or -1 for the
+         * window that the list belongs to.
+         */
+        int parent;
+
+        /**
+         * The position of the window relative to the parent of the window
+         * that the list belongs to. It is updated each time the list is
+         * rendered.
+         */
+        vector4 origin;
+    };
+
+    /**
+     * The render lists of this window, for each pass bitmask that it has
+     * been rendered with.
+     */
+    std::map<int, std::vector<RenderItem> > renderLists;
+
+    /**
+     * Add the enabled windows below this one to the render list for the
+     * pass. parent is the index of this window's entry. Windows that render
+     * their own children are added without their children, and windows that
+     * are not drawn in the pass are only added if something below them is.
+     */
+    void compile(int pass, std::vector<RenderItem> &list, int parent);
+
+    /**
+     * Throw away the render lists of this window and of all the windows
+     * above it, since they include this window.
+     */
+    void invalidateRenderLists();
+
+    /**
+     * Add the windows that can receive events at p, relative to this
+     * window, to hits, in the order they should receive them. The index of
+     * the windows is built first if it has been thrown away.
+     */
+    void findHits(vector4 p, std::vector<HitEntry> &hits);
+
+    /**
+     * Add the enabled windows below this one to the index, each after its
+     * own children. offset is the position of this window relative to the
+     * window that owns the index, and events only reach the part of a
+     * window that is inside min and max, the area of its parent.
+     */
+    void indexChildren(HitIndex &index, vector4 offset, vector4 min,
+                       vector4 max);
+
+    /**
+     * Throw away the hit indices of this window and of all the windows
+     * above it, since they include this window.
+     */
+    void invalidateHitIndex();
+
+    /**
+     * Set the projection matrix for the window, unless the last window
+     * drawn already set the same one.
+     */
+    void loadProjection(float aspect);
+
+    /**
+     * The projection that was set by the last window rendered, or -1 if it
+     * is not known. Windows with the same projection share the matrix.
+     */
+    static int lastProjection;
+
+    /**
+     * The root window being rendered, or NULL if none is. The windows below
+     * it use it instead of searching for the root.
+     */
+    static Window *renderRoot;
+
     /**
      * The position of the window relative to the parent window.
      */
@@ -229,6 +347,13 @@ private:
      * A bitmask of render passes where the window should be rendered.
      */
     int pass;
+
+    /**
+     * The index of the areas of this window and the windows below it, and
+     * whether it is up to date.
+     */
+    HitIndex hitIndex;
+    bool hitsValid;
 };
 
 #endif //WINDOW_H
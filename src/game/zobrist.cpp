@@ -0,0 +1,72 @@
+/************************************************************************
+ *
+ * zobrist.cpp
+ * Zobrist class implementation
+ *
+ ************************************************************************/
+
+#include "zobrist.h"
+
+/**
+ * The kinds of features.
+ */
+enum {WALL_KEY = 1, ITEM_KEY, PLAYER_KEY, STAT_KEY, TURN_KEY};
+
+/**
+ * Returns the key of a wall of the height on the cell at (i, j), which is
+ * 0 if the height is 0.
+ */
+uint64_t Zobrist::wallKey(int i, int j, int height)
+{
+    return height ? key(WALL_KEY, i, j, height) : 0;
+}
+
+/**
+ * Returns the key of an item of the type on the cell at (i, j).
+ */
+uint64_t Zobrist::itemKey(int i, int j, int type)
+{
+    return key(ITEM_KEY, i, j, type);
+}
+
+/**
+ * Returns the key of the player being on the cell at (i, j).
+ */
+uint64_t Zobrist::playerKey(Side side, int i, int j)
+{
+    return key(PLAYER_KEY, i, j, side);
+}
+
+/**
+ * Returns the key of the player's statistic having the value.
+ */
+uint64_t Zobrist::statKey(Side side, Stat stat, int value)
+{
+    return key(STAT_KEY, side, stat, value);
+}
+
+/**
+ * Returns the key of it being the turn, which is 0 for the hero's turn so
+ * that a maze's hash is that of the hero's turn.
+ */
+uint64_t Zobrist::turnKey(int turn)
+{
+    return turn ? key(TURN_KEY, turn, 0, 0) : 0;
+}
+
+/**
+ * Returns the key of a feature, from its kind and up to three numbers that
+ * say which one it is. The numbers are packed into one, with 10 bits for
+ * each of a and b, which is enough for the biggest maze, and 6 bits for c,
+ * and mixed with the finaliser of the splitmix generator. The mixing is a
+ * one to one function, so different features never have the same key.
+ */
+uint64_t Zobrist::key(int kind, int a, int b, int c)
+{
+    uint64_t z = (((uint64_t) kind << 26) | ((uint64_t) a << 16) |
+                  ((uint64_t) b << 6) | (uint64_t) c);
+    z += 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
@@ -0,0 +1,114 @@
+/************************************************************************
+ *
+ * zobrist.h
+ * Zobrist class
+ *
+ ************************************************************************/
+
+#ifndef ZOBRIST_H
+#define ZOBRIST_H
+
+#include <stdint.h>
+
+/**
+ * A Zobrist is a hash of the state of a game in a maze that is kept up to
+ * date as the game is played, rather than worked out again when it is
+ * needed. Every feature of the state, such as a wall of height 2 on a
+ * cell, or the haggis having 5 grenades, has a random 64 bit key, and the
+ * hash is the exclusive or of the keys of the features the state has. A
+ * change to the state only needs the keys of the features it takes away
+ * and adds to be toggled, so it takes the same time however big the maze
+ * is.
+ *
+ * The features are the wall heights of the cells, the items that have not
+ * been spent, the cells of the players and the values of their statistics,
+ * and whose turn it is. The keys are not kept in a table, but are made
+ * when they are needed by mixing the number of the feature, which is as
+ * quick as a lookup and needs no setting up.
+ */
+class Zobrist
+{
+public:
+    /**
+     * The players, whose features have keys of their own.
+     */
+    enum Side {HERO, HAGGIS};
+
+    /**
+     * The statistics of a player.
+     */
+    enum Stat {HEALTH, ENERGY, AMMO};
+
+    /**
+     * Constructor. The hash is that of an empty maze.
+     */
+    Zobrist()
+        : hash(0)
+    {
+    }
+
+    /**
+     * Returns the hash.
+     */
+    uint64_t getHash() const
+    {
+        return hash;
+    }
+
+    /**
+     * Add the key if it is not in the hash, or take it out if it is.
+     */
+    void toggle(uint64_t key)
+    {
+        hash ^= key;
+    }
+
+    /**
+     * Set the hash back to that of an empty maze.
+     */
+    void clear()
+    {
+        hash = 0;
+    }
+
+    /**
+     * Returns the key of a wall of the height on the cell at (i, j), which
+     * is 0 if the height is 0.
+     */
+    static uint64_t wallKey(int i, int j, int height);
+
+    /**
+     * Returns the key of an item of the type on the cell at (i, j).
+     */
+    static uint64_t itemKey(int i, int j, int type);
+
+    /**
+     * Returns the key of the player being on the cell at (i, j).
+     */
+    static uint64_t playerKey(Side side, int i, int j);
+
+    /**
+     * Returns the key of the player's statistic having the value. Each
+     * value has a key of its own, since there are only MAX_STAT + 1 of them.
+     */
+    static uint64_t statKey(Side side, Stat stat, int value);
+
+    /**
+     * Returns the key of it being the turn, which is 0 for the hero's turn.
+     */
+    static uint64_t turnKey(int turn);
+
+private:
+    /**
+     * The hash.
+     */
+    uint64_t hash;
+
+    /**
+     * Returns the key of a feature, from its kind and up to three numbers
+     * that say which one it is.
+     */
+    static uint64_t key(int kind, int a, int b, int c);
+};
+
+#endif //ZOBRIST_H
@@ -8,6 +8,7 @@
  ************************************************************************/
 
 #include "game.h"
+#include "mazebenchmark.h"
 #include "test.h"
 
 #include <cppunit/extensions/TestFactoryRegistry.h>
@@ -17,10 +18,10 @@
 #include <cstring>
 using namespace std;
 
-bool shouldTest(int argc, char *argv[])
+bool hasOption(int argc, char *argv[], const char *option)
 {
     for (int i=1; i<argc; i++) {
-        if (strcmp(argv[i], "--test") == 0) {
+        if (strcmp(argv[i], option) == 0) {
             return true;
         }
     }
@@ -37,10 +38,19 @@ int runTests()
     return !runner.run();
 }
 
+int runLayoutBenchmark()
+{
+    MazeBenchmark benchmark(1000);
+    benchmark.run(cout);
+    return 0;
+}
+
 int runGame(int argc, char *argv[])
 {
     Game game(argc, argv);
-    game.setFPSLimit(50.0);
+
+    //the benchmark runs as fast as it can
+    game.setFPSLimit(game.isBenchmark() ? 1000.0 : 50.0);
 
     try {
         game.run();
@@ -55,8 +65,10 @@ int runGame(int argc, char *argv[])
 
 int main(int argc, char *argv[])
 {
-    if (shouldTest(argc, argv)) {
+    if (hasOption(argc, argv, "--test")) {
         return runTests();
+    } else if (hasOption(argc, argv, "--layout-benchmark")) {
+        return runLayoutBenchmark();
     } else {
         return runGame(argc, argv);
     }
@@ -0,0 +1,33 @@
+/************************************************************************
+ *
+ * apperror.cpp
+ * app_error class implementation
+ *
+ ************************************************************************/
+
+#include "apperror.h"
+
+/**
+ * Default constructor for the application error class. Takes a string
+ * error message as a parameter.
+ */
+app_error::app_error(std::string err)
+{
+    msg = err;
+}
+
+/**
+ * Destructor.
+ */
+app_error::~app_error() throw()
+{
+    //nothing to destruct
+}
+
+/**
+ * Returns the value of the error message.
+ */
+std::string app_error::what()
+{
+    return msg;
+}
@@ -0,0 +1,42 @@
+/************************************************************************
+ *
+ * apperror.h
+ * app_error class
+ *
+ ************************************************************************/
+
+#ifndef APPERROR_H
+#define APPERROR_H
+
+#include <stdexcept>
+#include <string>
+
+/**
+ * A fatal error has occured in the application.
+ */
+class app_error : public std::exception
+{
+public:
+    /**
+     * Constructor. The error message will be printed to stderr.
+     */
+    app_error(std::string err);
+
+    /**
+     * Destructor.
+     */
+    virtual ~app_error() throw();
+
+    /**
+     * Returns the error message.
+     */
+    virtual std::string what();
+
+private:
+    /**
+     * The error message.
+     */
+    std::string msg;
+};
+
+#endif //APPERROR_H
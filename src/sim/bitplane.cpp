@@ -0,0 +1,300 @@
+/************************************************************************
+ *
+ * bitplane.cpp
+ * BitPlane class implementation
+ *
+ ************************************************************************/
+
+#include "bitplane.h"
+
+/**
+ * Returns the number of bits set in the word.
+ */
+static int countBits(BitWord w)
+{
+    int n = 0;
+    while (w) {
+        w &= w - 1;
+        n++;
+    }
+    return n;
+}
+
+/**
+ * Constructor. All the bits are clear.
+ */
+BitPlane::BitPlane(int width, int height)
+{
+    resize(width, height);
+}
+
+/**
+ * Change the size of the plane. All the bits are cleared.
+ */
+void BitPlane::resize(int width, int height)
+{
+    this->width = width;
+    this->height = height;
+    words = (width + BITS_PER_WORD - 1) / BITS_PER_WORD;
+
+    int used = width % BITS_PER_WORD;
+    lastMask = used ? ((((BitWord) 1) << used) - 1) : ~((BitWord) 0);
+
+    bits.assign(words*height, 0);
+}
+
+/**
+ * Returns the number of columns.
+ */
+int BitPlane::getWidth() const
+{
+    return width;
+}
+
+/**
+ * Returns the number of rows.
+ */
+int BitPlane::getHeight() const
+{
+    return height;
+}
+
+/**
+ * Clear all the bits.
+ */
+void BitPlane::clear()
+{
+    bits.assign(bits.size(), 0);
+}
+
+/**
+ * Set the bits of all the cells. The bits past the last column are left
+ * clear.
+ */
+void BitPlane::fill()
+{
+    bits.assign(bits.size(), ~((BitWord) 0));
+    for (int i=0; (i<height) && (words>0); i++) {
+        bits[i*words + words - 1] &= lastMask;
+    }
+}
+
+/**
+ * Returns the number of bits that are set.
+ */
+int BitPlane::count() const
+{
+    int n = 0;
+    for (unsigned k=0; k<bits.size(); k++) {
+        n += countBits(bits[k]);
+    }
+    return n;
+}
+
+/**
+ * Returns true if no bits are set.
+ */
+bool BitPlane::isEmpty() const
+{
+    for (unsigned k=0; k<bits.size(); k++) {
+        if (bits[k]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Sets (i, j) to the first cell whose bit is set, in row-major order.
+ * Returns false if no bits are set.
+ */
+bool BitPlane::findFirst(int &i, int &j) const
+{
+    for (unsigned k=0; k<bits.size(); k++) {
+        if (bits[k]) {
+            BitWord w = bits[k];
+            int b = 0;
+            while (!(w & 1)) {
+                w >>= 1;
+                b++;
+            }
+            i = k / words;
+            j = (k % words)*BITS_PER_WORD + b;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Sets (i, j) to cell n of the cells whose bits are set, counting from 0 in
+ * row-major order. Returns false if fewer than n+1 bits are set. Whole
+ * words are skipped until the one holding the cell is found.
+ */
+bool BitPlane::findNth(int n, int &i, int &j) const
+{
+    for (unsigned k=0; k<bits.size(); k++) {
+        int c = countBits(bits[k]);
+        if (n >= c) {
+            n -= c;
+            continue;
+        }
+
+        BitWord w = bits[k];
+        int b = 0;
+        while (true) {
+            if (w & 1) {
+                if (n == 0) {
+                    break;
+                }
+                n--;
+            }
+            w >>= 1;
+            b++;
+        }
+        i = k / words;
+        j = (k % words)*BITS_PER_WORD + b;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Keep only the cells that are also set in p.
+ */
+BitPlane &BitPlane::operator&=(const BitPlane &p)
+{
+    for (unsigned k=0; k<bits.size(); k++) {
+        bits[k] &= p.bits[k];
+    }
+    return *this;
+}
+
+/**
+ * Add the cells that are set in p.
+ */
+BitPlane &BitPlane::operator|=(const BitPlane &p)
+{
+    for (unsigned k=0; k<bits.size(); k++) {
+        bits[k] |= p.bits[k];
+    }
+    return *this;
+}
+
+/**
+ * Returns true if the planes have the same bits set.
+ */
+bool BitPlane::operator==(const BitPlane &p) const
+{
+    return (width == p.width) && (height == p.height) && (bits == p.bits);
+}
+
+/**
+ * Returns true if the planes have different bits set.
+ */
+bool BitPlane::operator!=(const BitPlane &p) const
+{
+    return !(*this == p);
+}
+
+/**
+ * Clear the bits that are set in p.
+ */
+void BitPlane::subtract(const BitPlane &p)
+{
+    for (unsigned k=0; k<bits.size(); k++) {
+        bits[k] &= ~p.bits[k];
+    }
+}
+
+/**
+ * Set dest to these cells and all their neighbours. A cell's neighbours in
+ * its own row are one column either side. A cell in an even row touches
+ * the same column and the one before in the rows above and below, and a
+ * cell in an odd row touches the same column and the one after.
+ */
+void BitPlane::expand(BitPlane &dest) const
+{
+    if ((dest.width != width) || (dest.height != height)) {
+        dest.resize(width, height);
+    }
+    if (words == 0) {
+        return;
+    }
+
+    for (int i=0; i<height; i++) {
+        const BitWord *s = &bits[i*words];
+        BitWord *d = &dest.bits[i*words];
+
+        // the row itself and its neighbours either side
+        for (int k=0; k<words; k++) {
+            BitWord up = (s[k] << 1) |
+                ((k > 0) ? (s[k-1] >> (BITS_PER_WORD-1)) : 0);
+            BitWord down = (s[k] >> 1) |
+                ((k+1 < words) ? (s[k+1] << (BITS_PER_WORD-1)) : 0);
+            d[k] = s[k] | up | down;
+        }
+
+        // the cells in the rows above and below
+        for (int a=i-1; a<=i+1; a+=2) {
+            if ((a < 0) || (a >= height)) {
+                continue;
+            }
+            const BitWord *t = &bits[a*words];
+            for (int k=0; k<words; k++) {
+                BitWord shifted;
+                if (a % 2 == 0) {
+                    shifted = (t[k] >> 1) |
+                        ((k+1 < words) ? (t[k+1] << (BITS_PER_WORD-1)) : 0);
+                } else {
+                    shifted = (t[k] << 1) |
+                        ((k > 0) ? (t[k-1] >> (BITS_PER_WORD-1)) : 0);
+                }
+                d[k] |= t[k] | shifted;
+            }
+        }
+
+        d[words-1] &= lastMask;
+    }
+}
+
+/**
+ * Add the cells that can be reached from the cells already set by stepping
+ * between neighbours whose bits are set in passable. Each pass grows the
+ * region by one step in every direction at once.
+ */
+void BitPlane::floodFill(const BitPlane &passable)
+{
+    BitPlane next;
+    while (true) {
+        expand(next);
+        next &= passable;
+        next |= *this;
+        if (next == *this) {
+            return;
+        }
+        bits.swap(next.bits);
+    }
+}
+
+/**
+ * Returns the words of row i. The bits past the last column must be left
+ * clear.
+ */
+const BitWord *BitPlane::getRow(int i) const
+{
+    return &bits[i*words];
+}
+
+BitWord *BitPlane::getRow(int i)
+{
+    return &bits[i*words];
+}
+
+/**
+ * Returns the number of words in each row.
+ */
+int BitPlane::getWordsPerRow() const
+{
+    return words;
+}
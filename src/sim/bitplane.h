@@ -0,0 +1,162 @@
+/************************************************************************
+ *
+ * bitplane.h
+ * BitPlane class
+ *
+ ************************************************************************/
+
+#ifndef BITPLANE_H
+#define BITPLANE_H
+
+#include <stdint.h>
+
+#include <vector>
+
+typedef uint64_t BitWord;
+
+#define BITS_PER_WORD 64  // the number of cells in each word of a plane
+
+/**
+ * A BitPlane holds one bit for each cell of a maze, such as whether the
+ * cell is a wall. Each row of the maze is packed into 64 bit words, with
+ * column j in bit j % 64 of word j / 64, so that set operations on whole
+ * planes handle 64 cells at a time.
+ *
+ * The neighbours of a set of cells are found for a whole row at a time by
+ * shifting it and its neighbouring rows, following the layout of the maze
+ * in which odd rows are shifted by half a cell towards higher columns.
+ * This makes flood fills and move generation cheap enough to be done many
+ * times a turn.
+ */
+class BitPlane
+{
+public:
+    /**
+     * Constructor. All the bits are clear.
+     */
+    BitPlane(int width = 0, int height = 0);
+
+    /**
+     * Change the size of the plane. All the bits are cleared.
+     */
+    void resize(int width, int height);
+
+    /**
+     * Returns the number of columns.
+     */
+    int getWidth() const;
+
+    /**
+     * Returns the number of rows.
+     */
+    int getHeight() const;
+
+    /**
+     * Returns the bit of the cell in row i and column j.
+     */
+    bool get(int i, int j) const
+    {
+        return (bits[i*words + j/BITS_PER_WORD] >>
+                (j % BITS_PER_WORD)) & 1;
+    }
+
+    /**
+     * Set the bit of the cell in row i and column j.
+     */
+    void set(int i, int j, bool on = true)
+    {
+        BitWord bit = ((BitWord) 1) << (j % BITS_PER_WORD);
+        if (on) {
+            bits[i*words + j/BITS_PER_WORD] |= bit;
+        } else {
+            bits[i*words + j/BITS_PER_WORD] &= ~bit;
+        }
+    }
+
+    /**
+     * Clear all the bits.
+     */
+    void clear();
+
+    /**
+     * Set the bits of all the cells.
+     */
+    void fill();
+
+    /**
+     * Returns the number of bits that are set.
+     */
+    int count() const;
+
+    /**
+     * Returns true if no bits are set.
+     */
+    bool isEmpty() const;
+
+    /**
+     * Sets (i, j) to the first cell whose bit is set, in row-major order.
+     * Returns false if no bits are set.
+     */
+    bool findFirst(int &i, int &j) const;
+
+    /**
+     * Sets (i, j) to cell n of the cells whose bits are set, counting from
+     * 0 in row-major order. Returns false if fewer than n+1 bits are set.
+     */
+    bool findNth(int n, int &i, int &j) const;
+
+    /**
+     * Set operations. The planes must be the same size.
+     */
+    BitPlane &operator&=(const BitPlane &p);
+    BitPlane &operator|=(const BitPlane &p);
+    bool operator==(const BitPlane &p) const;
+    bool operator!=(const BitPlane &p) const;
+
+    /**
+     * Clear the bits that are set in p.
+     */
+    void subtract(const BitPlane &p);
+
+    /**
+     * Set dest to these cells and all their neighbours. dest must not be
+     * this plane.
+     */
+    void expand(BitPlane &dest) const;
+
+    /**
+     * Add the cells that can be reached from the cells already set by
+     * stepping between neighbours whose bits are set in passable.
+     */
+    void floodFill(const BitPlane &passable);
+
+    /**
+     * Returns the words of row i. The bits past the last column must be
+     * left clear.
+     */
+    const BitWord *getRow(int i) const;
+    BitWord *getRow(int i);
+
+    /**
+     * Returns the number of words in each row.
+     */
+    int getWordsPerRow() const;
+
+private:
+    /**
+     * The size of the plane, and the number of words in a row.
+     */
+    int width, height, words;
+
+    /**
+     * The bits that are used in the last word of each row.
+     */
+    BitWord lastMask;
+
+    /**
+     * The words of the rows, one row after the other.
+     */
+    std::vector<BitWord> bits;
+};
+
+#endif //BITPLANE_H
@@ -0,0 +1,76 @@
+/************************************************************************
+ *
+ * chasepolicy.cpp
+ * ChasePolicy class implementation
+ *
+ ************************************************************************/
+
+#include "chasepolicy.h"
+#include "hexcoord.h"
+#include "rules.h"
+
+/**
+ * Tells the search which cells the player can walk through on its way to
+ * the opponent: the empty cells, and the opponent's own cell.
+ */
+struct Approachable
+{
+    const GameState &s;
+    const PlayerState &target;
+
+    Approachable(const GameState &s, const PlayerState &target)
+        : s(s), target(target)
+    {
+    }
+
+    bool operator()(int i, int j) const
+    {
+        return GameRules::canEnter(s, i, j) ||
+            ((i == target.i) && (j == target.j));
+    }
+};
+
+/**
+ * Returns the move for the player whose turn it is.
+ */
+Move ChasePolicy::choose(const GameState &s, Random &)
+{
+    const PlayerState &me = s.heroTurn ? s.hero : s.haggis;
+    const PlayerState &opponent = s.heroTurn ? s.haggis : s.hero;
+    if ((me.i < 0) || (opponent.i < 0)) {
+        return Move(Move::WAIT);
+    }
+
+    // throw a grenade if the opponent is in range
+    HexCoord here = HexCoord::fromMaze(me.i, me.j);
+    if (GameRules::canThrow(me) &&
+        (here.distance(HexCoord::fromMaze(opponent.i, opponent.j)) <=
+         GRENADE_RANGE)) {
+        return Move(Move::GRENADE, opponent.i, opponent.j);
+    }
+
+    if (!GameRules::canWalk(me)) {
+        return Move(Move::WAIT);
+    }
+
+    // follow the path back from the opponent to the first step
+    MazeGrid grid(s.getWidth(), s.getHeight());
+    grid.search(me.i, me.j, Approachable(s, opponent), order, parents);
+
+    const int start = grid.getIndex(me.i, me.j);
+    int step = grid.getIndex(opponent.i, opponent.j);
+    if (parents[step] == -1) {
+        return Move(Move::WAIT);
+    }
+    while (parents[step] != start) {
+        step = parents[step];
+    }
+
+    int i = step / s.getWidth();
+    int j = step % s.getWidth();
+    if (s.hasPlayer(i, j)) {
+        // the opponent is next to us, but there is nothing to throw
+        return Move(Move::WAIT);
+    }
+    return Move(Move::WALK, i, j);
+}
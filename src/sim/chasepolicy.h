@@ -0,0 +1,36 @@
+/************************************************************************
+ *
+ * chasepolicy.h
+ * ChasePolicy class
+ *
+ ************************************************************************/
+
+#ifndef CHASEPOLICY_H
+#define CHASEPOLICY_H
+
+#include "policy.h"
+
+#include <vector>
+
+/**
+ * The ChasePolicy is a scripted player that hunts its opponent. It throws
+ * a grenade at the opponent whenever it is in range, and otherwise walks
+ * towards it along the shortest path. If there is no way to reach the
+ * opponent, or no energy to walk, it waits. It plays either player.
+ */
+class ChasePolicy : public Policy
+{
+public:
+    /**
+     * Returns the move for the player whose turn it is.
+     */
+    virtual Move choose(const GameState &s, Random &random);
+
+private:
+    /**
+     * The results of the search, kept to save allocating them each turn.
+     */
+    std::vector<int> order, parents;
+};
+
+#endif //CHASEPOLICY_H
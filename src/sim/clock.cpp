@@ -0,0 +1,22 @@
+/************************************************************************
+ *
+ * clock.cpp
+ * Clock class implementation
+ *
+ ************************************************************************/
+
+#include "clock.h"
+
+#include <time.h>
+
+/**
+ * Returns the number of milliseconds since an arbitrary time that does not
+ * change while the program runs. The monotonic clock is used, so that
+ * setting the system's time does not move the deadlines of a search.
+ */
+uint32_t Clock::getTicks()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint32_t) now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
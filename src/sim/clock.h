@@ -0,0 +1,28 @@
+/************************************************************************
+ *
+ * clock.h
+ * Clock class
+ *
+ ************************************************************************/
+
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <stdint.h>
+
+/**
+ * The Clock gives the time in milliseconds, like SDL_GetTicks(), for the
+ * parts of the game that run without SDL. The ticks wrap around after
+ * about 49 days, so times should be compared by their difference.
+ */
+class Clock
+{
+public:
+    /**
+     * Returns the number of milliseconds since an arbitrary time that
+     * does not change while the program runs.
+     */
+    static uint32_t getTicks();
+};
+
+#endif //CLOCK_H
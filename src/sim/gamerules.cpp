@@ -0,0 +1,227 @@
+/************************************************************************
+ *
+ * gamerules.cpp
+ * GameRules class implementation
+ *
+ ************************************************************************/
+
+#include "gamerules.h"
+#include "hexcoord.h"
+#include "rules.h"
+
+/**
+ * Set a player statistic, clamped into the allowed range as Player does.
+ */
+static void setStat(signed char &stat, int value)
+{
+    stat = (value < 0) ? 0 : ((value > MAX_STAT) ? MAX_STAT : value);
+}
+
+/**
+ * Move the player onto the cell at (i, j), after taking the energy for the
+ * move, and pick up any item there.
+ */
+static void enter(GameState &s, PlayerState &p, int i, int j, int energy)
+{
+    setStat(p.energy, p.energy - energy);
+    p.i = i;
+    p.j = j;
+
+    int item = s.getItem(i, j);
+    if (item < 0) {
+        return;
+    }
+    GameState::Plane plane =
+        (GameState::Plane) (GameState::ITEM_HEALTH + item);
+    s.set(plane, i, j, false);
+    s.set(GameState::REVEALED, i, j, false);
+
+    if (plane == GameState::ITEM_HEALTH) {
+        setStat(p.health, p.health + HEALTH_INCREASE);
+    } else if (plane == GameState::ITEM_GRENADE) {
+        setStat(p.ammo, p.ammo + AMMO_INCREASE);
+    } else if (plane == GameState::ITEM_ENERGY) {
+        setStat(p.energy, p.energy + ENERGY_INCREASE);
+    } else if (plane == GameState::ITEM_TRAP) {
+        setStat(p.health, p.health - HEALTH_DECREASE);
+    }
+}
+
+/**
+ * Returns true if the player has enough energy to walk.
+ */
+bool GameRules::canWalk(const PlayerState &p)
+{
+    return p.energy >= WALK_ENERGY;
+}
+
+/**
+ * Returns true if the player has enough energy to jump.
+ */
+bool GameRules::canJump(const PlayerState &p)
+{
+    return p.energy >= JUMP_ENERGY;
+}
+
+/**
+ * Returns true if the player has a grenade to throw.
+ */
+bool GameRules::canThrow(const PlayerState &p)
+{
+    return p.ammo >= 1;
+}
+
+/**
+ * Returns true if the player has enough energy to use psychic powers.
+ */
+bool GameRules::canPsychic(const PlayerState &p)
+{
+    return p.energy >= PSYCHIC_ENERGY;
+}
+
+/**
+ * Returns true if a player can move onto the cell at (i, j): it is part of
+ * the maze, it is not a wall and no player is on it.
+ */
+bool GameRules::canEnter(const GameState &s, int i, int j)
+{
+    return (i >= 0) && (i < s.getHeight()) && (j >= 0) && (j < s.getWidth()) &&
+        ((s.getEnterable(i) >> j) & 1);
+}
+
+/**
+ * Set moves to the moves that the player whose turn it is can make. These
+ * are the cells that WalkAction, JumpAction, GrenadeAction and
+ * PsychicAction mark selectable. Waiting is always the first.
+ *
+ * The cells that can be entered are taken from the state's bit planes a
+ * row at a time, for the rows within a jump of the player, so each cell
+ * only needs one bit tested. This is called for every step of the
+ * playouts, so the rows are kept on the stack rather than in a BitPlane.
+ */
+void GameRules::getMoves(const GameState &s, std::vector<Move> &moves)
+{
+    const PlayerState &p = s.heroTurn ? s.hero : s.haggis;
+
+    moves.clear();
+    moves.push_back(Move(Move::WAIT));
+    if (p.i < 0) {
+        return;
+    }
+
+    // rows[JUMP_RANGE + di] is the row di rows from the player's
+    BitWord rows[2*JUMP_RANGE + 1];
+    for (int di=-JUMP_RANGE; di<=JUMP_RANGE; di++) {
+        int i = p.i + di;
+        rows[JUMP_RANGE + di] =
+            ((i >= 0) && (i < s.getHeight())) ? s.getEnterable(i) : 0;
+    }
+    const int width = s.getWidth();
+
+    // the first ring of offsets holds the neighbours of the cell
+    const GridOffset *offsets = HexCoord::getOffsets(p.i);
+    const int neighbours = HexCoord::getDiscSize(1);
+    for (int k=1; k<neighbours; k++) {
+        int i = p.i + offsets[k].di;
+        int j = p.j + offsets[k].dj;
+        if ((j >= 0) && (j < width) &&
+            ((rows[JUMP_RANGE + offsets[k].di] >> j) & 1)) {
+            if (canWalk(p)) {
+                moves.push_back(Move(Move::WALK, i, j));
+            }
+            if (canPsychic(p)) {
+                moves.push_back(Move(Move::PSYCHIC, i, j));
+            }
+        }
+    }
+
+    if (canJump(p)) {
+        const int count = HexCoord::getDiscSize(JUMP_RANGE);
+        for (int k=1; k<count; k++) {
+            int i = p.i + offsets[k].di;
+            int j = p.j + offsets[k].dj;
+            if ((j >= 0) && (j < width) &&
+                ((rows[JUMP_RANGE + offsets[k].di] >> j) & 1)) {
+                moves.push_back(Move(Move::JUMP, i, j));
+            }
+        }
+    }
+
+    if (canThrow(p)) {
+        const int count = HexCoord::getDiscSize(GRENADE_RANGE);
+        for (int k=1; k<count; k++) {
+            int i = p.i + offsets[k].di;
+            int j = p.j + offsets[k].dj;
+            if ((i >= 0) && (i < s.getHeight()) &&
+                (j >= 0) && (j < s.getWidth())) {
+                moves.push_back(Move(Move::GRENADE, i, j));
+            }
+        }
+    }
+}
+
+/**
+ * Play the move for the player whose turn it is, and pass the turn to the
+ * other player. The move is not checked; costs that can't be paid in full
+ * leave the statistic at 0, as they do in the game.
+ */
+void GameRules::play(GameState &s, const Move &m)
+{
+    PlayerState &p = s.heroTurn ? s.hero : s.haggis;
+    PlayerState &opponent = s.heroTurn ? s.haggis : s.hero;
+
+    switch (m.type) {
+    case Move::WALK:
+        enter(s, p, m.i, m.j, WALK_ENERGY);
+        break;
+
+    case Move::JUMP:
+        enter(s, p, m.i, m.j, JUMP_ENERGY);
+        break;
+
+    case Move::GRENADE:
+        setStat(p.ammo, p.ammo - 1);
+        if (s.getWallHeight(m.i, m.j)) {
+            s.setWallHeight(m.i, m.j, s.getWallHeight(m.i, m.j) - 1);
+        } else if ((opponent.i == m.i) && (opponent.j == m.j)) {
+            setStat(opponent.health, opponent.health - GRENADE_DAMAGE);
+        }
+        break;
+
+    case Move::PSYCHIC:
+        // PsychicAction needs the energy, but does not use it up
+        if (s.getItem(m.i, m.j) >= 0) {
+            s.set(GameState::REVEALED, m.i, m.j);
+        }
+        break;
+
+    case Move::WAIT:
+        break;
+    }
+
+    s.heroTurn = !s.heroTurn;
+}
+
+/**
+ * Returns true if the player is dead: its health or its energy is 0.
+ */
+bool GameRules::isDead(const PlayerState &p)
+{
+    return (p.health <= 0) || (p.energy <= 0);
+}
+
+/**
+ * Returns true if the game is over because a player is dead.
+ */
+bool GameRules::isOver(const GameState &s)
+{
+    return isDead(s.hero) || isDead(s.haggis);
+}
+
+/**
+ * Returns true if the hero has won, which it has if the haggis is dead.
+ */
+bool GameRules::heroWon(const GameState &s)
+{
+    return isDead(s.haggis);
+}
@@ -0,0 +1,109 @@
+/************************************************************************
+ *
+ * gamerules.h
+ * GameRules class
+ *
+ ************************************************************************/
+
+#ifndef GAMERULES_H
+#define GAMERULES_H
+
+#include "gamestate.h"
+
+#include <vector>
+
+/**
+ * A move that a player can make in its turn, with the cell it is aimed at.
+ */
+struct Move
+{
+    enum Type {WAIT, WALK, JUMP, GRENADE, PSYCHIC};
+
+    Type type;
+    int i, j;
+
+    /**
+     * Constructor.
+     */
+    Move(Type type = WAIT, int i = -1, int j = -1)
+        : type(type), i(i), j(j)
+    {
+    }
+
+    /**
+     * Returns true if the moves are the same.
+     */
+    bool operator==(const Move &m) const
+    {
+        return (type == m.type) && (i == m.i) && (j == m.j);
+    }
+};
+
+/**
+ * The GameRules play moves on a GameState, with the same costs and effects
+ * as the actions have on a Level, but without any animation. The moves a
+ * player may make are the ones the actions would mark selectable. This is
+ * what lets games be played without being drawn, and many times faster.
+ *
+ * The rule constants are shared with the actions, so the two can't drift
+ * apart.
+ */
+class GameRules
+{
+public:
+    /**
+     * Returns true if the player has enough energy to walk.
+     */
+    static bool canWalk(const PlayerState &p);
+
+    /**
+     * Returns true if the player has enough energy to jump.
+     */
+    static bool canJump(const PlayerState &p);
+
+    /**
+     * Returns true if the player has a grenade to throw.
+     */
+    static bool canThrow(const PlayerState &p);
+
+    /**
+     * Returns true if the player has enough energy to use psychic powers.
+     */
+    static bool canPsychic(const PlayerState &p);
+
+    /**
+     * Returns true if a player can move onto the cell at (i, j): it is part
+     * of the maze, it is not a wall and no player is on it.
+     */
+    static bool canEnter(const GameState &s, int i, int j);
+
+    /**
+     * Set moves to the moves that the player whose turn it is can make.
+     * Waiting is always the first.
+     */
+    static void getMoves(const GameState &s, std::vector<Move> &moves);
+
+    /**
+     * Play the move for the player whose turn it is, and pass the turn to
+     * the other player. The move is not checked; costs that can't be paid
+     * in full leave the statistic at 0, as they do in the game.
+     */
+    static void play(GameState &s, const Move &m);
+
+    /**
+     * Returns true if the player is dead: its health or its energy is 0.
+     */
+    static bool isDead(const PlayerState &p);
+
+    /**
+     * Returns true if the game is over because a player is dead.
+     */
+    static bool isOver(const GameState &s);
+
+    /**
+     * Returns true if the hero has won, which it has if the haggis is dead.
+     */
+    static bool heroWon(const GameState &s);
+};
+
+#endif //GAMERULES_H
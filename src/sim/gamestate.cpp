@@ -0,0 +1,236 @@
+/************************************************************************
+ *
+ * gamestate.cpp
+ * GameState class implementation
+ *
+ ************************************************************************/
+
+#include "gamestate.h"
+#include "rules.h"
+#include "apperror.h"
+
+#include <string.h>
+#include <assert.h>
+
+#define FNV_OFFSET 14695981039346656037ULL
+#define FNV_PRIME 1099511628211ULL
+
+/**
+ * Add the bytes of the data to a 64 bit FNV-1a hash.
+ */
+static uint64_t hashBytes(uint64_t h, const void *data, int size)
+{
+    const unsigned char *p = (const unsigned char *) data;
+    for (int k=0; k<size; k++) {
+        h = (h ^ p[k]) * FNV_PRIME;
+    }
+    return h;
+}
+
+/**
+ * Constructor. The state is for an empty maze.
+ */
+GameState::GameState()
+    : heroTurn(true), width(0), height(0)
+{
+    hero.i = hero.j = haggis.i = haggis.j = -1;
+    hero.health = hero.energy = hero.ammo = 0;
+    haggis.health = haggis.energy = haggis.ammo = 0;
+    memset(planes, 0, sizeof(planes));
+}
+
+/**
+ * Load the state from a stream in the same format as a maze file, with the
+ * players on their starting cells with full statistics and the hero to
+ * move. The wall heights are taken from random, as Maze::load() does.
+ */
+void GameState::load(std::istream &in, std::string name, Random &random)
+{
+    in >> width;
+    in >> height;
+    if (!in || (width < 1) || (width > GAME_STATE_MAX_SIZE) ||
+        (height < 1) || (height > GAME_STATE_MAX_SIZE)) {
+        throw app_error(name + std::string(" contains invalid data."));
+    }
+
+    resize(width, height);
+    hero.i = hero.j = haggis.i = haggis.j = -1;
+    for (int i=0; i<height; i++) {
+        for (int j=0; j<width; j++) {
+            int ctype = -1;
+            in >> ctype;
+
+            set(VISIBLE, i, j, ctype != 0);
+            if (ctype == 2) {
+                setWallHeight(i, j, random.nextInt(MAX_WALL_HEIGHT)+1);
+            } else if (ctype == 3) {
+                hero.i = i;
+                hero.j = j;
+            } else if (ctype == 4) {
+                haggis.i = i;
+                haggis.j = j;
+            } else if ((ctype >= 5) && (ctype <= 8)) {
+                // the item types are in the same order as their planes
+                set((Plane) (ITEM_HEALTH + ctype - 5), i, j);
+            } else if ((ctype != 0) && (ctype != 1)) {
+                throw app_error(name + std::string(" contains invalid data."));
+            }
+        }
+    }
+
+    if ((hero.i < 0) || (haggis.i < 0)) {
+        throw app_error(name + std::string(" has no player start."));
+    }
+
+    hero.health = hero.energy = hero.ammo = MAX_STAT;
+    haggis.health = haggis.energy = haggis.ammo = MAX_STAT;
+    heroTurn = true;
+}
+
+/**
+ * Change the size of the maze, which must be no more than
+ * GAME_STATE_MAX_SIZE cells in each direction. All the planes are cleared,
+ * and the players are left as they are.
+ */
+void GameState::resize(int width, int height)
+{
+    assert((width <= GAME_STATE_MAX_SIZE) && (height <= GAME_STATE_MAX_SIZE));
+    this->width = width;
+    this->height = height;
+    memset(planes, 0, sizeof(planes));
+}
+
+/**
+ * Returns the number of columns.
+ */
+int GameState::getWidth() const
+{
+    return width;
+}
+
+/**
+ * Returns the number of rows.
+ */
+int GameState::getHeight() const
+{
+    return height;
+}
+
+/**
+ * Returns the height of the wall on the cell at (i, j), or 0 if there is
+ * no wall.
+ */
+int GameState::getWallHeight(int i, int j) const
+{
+    return (get(WALL_HIGH, i, j) ? 2 : 0) + (get(WALL_LOW, i, j) ? 1 : 0);
+}
+
+/**
+ * Set the height of the wall on the cell at (i, j), from 0 to 3.
+ */
+void GameState::setWallHeight(int i, int j, int h)
+{
+    assert((h >= 0) && (h <= 3));
+    set(WALL_LOW, i, j, h & 1);
+    set(WALL_HIGH, i, j, h & 2);
+}
+
+/**
+ * Returns the type of the item on the cell at (i, j) that has not been
+ * picked up, or -1 if there is none.
+ */
+int GameState::getItem(int i, int j) const
+{
+    for (int p=ITEM_HEALTH; p<=ITEM_TRAP; p++) {
+        if (get((Plane) p, i, j)) {
+            return p - ITEM_HEALTH;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Returns true if the hero or the haggis is on the cell at (i, j).
+ */
+bool GameState::hasPlayer(int i, int j) const
+{
+    return ((hero.i == i) && (hero.j == j)) ||
+        ((haggis.i == i) && (haggis.j == j));
+}
+
+/**
+ * Set a plane of the cells to the bits of a plane of this state. A row of
+ * the state fits in one word, which is laid out as the plane lays out its
+ * rows, so the rows are copied whole.
+ */
+void GameState::getPlane(Plane p, BitPlane &dest) const
+{
+    dest.resize(width, height);
+    if (width == 0) {
+        return;
+    }
+    for (int i=0; i<height; i++) {
+        dest.getRow(i)[0] = planes[p][i];
+    }
+}
+
+/**
+ * Set a plane of the cells to the cells a player could stand on: they are
+ * part of the maze and they are not walls. The players are not counted.
+ */
+void GameState::getWalkable(BitPlane &dest) const
+{
+    dest.resize(width, height);
+    if (width == 0) {
+        return;
+    }
+    for (int i=0; i<height; i++) {
+        dest.getRow(i)[0] = planes[VISIBLE][i] &
+            ~(planes[WALL_LOW][i] | planes[WALL_HIGH][i]);
+    }
+}
+
+/**
+ * Returns a 64 bit FNV-1a hash of the whole state. Only the rows that are
+ * used are hashed.
+ */
+uint64_t GameState::hash() const
+{
+    uint64_t h = FNV_OFFSET;
+    h = hashBytes(h, &width, sizeof(width));
+    h = hashBytes(h, &height, sizeof(height));
+    for (int p=0; p<PLANES; p++) {
+        h = hashBytes(h, planes[p], height*sizeof(BitWord));
+    }
+    h = hashBytes(h, &hero, sizeof(hero));
+    h = hashBytes(h, &haggis, sizeof(haggis));
+    h = hashBytes(h, &heroTurn, sizeof(heroTurn));
+    return h;
+}
+
+/**
+ * Returns true if the states are the same.
+ */
+bool GameState::operator==(const GameState &s) const
+{
+    if ((width != s.width) || (height != s.height) ||
+        (heroTurn != s.heroTurn) ||
+        memcmp(&hero, &s.hero, sizeof(hero)) ||
+        memcmp(&haggis, &s.haggis, sizeof(haggis))) {
+        return false;
+    }
+    for (int p=0; p<PLANES; p++) {
+        if (memcmp(planes[p], s.planes[p], height*sizeof(BitWord))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Returns true if the states are different.
+ */
+bool GameState::operator!=(const GameState &s) const
+{
+    return !(*this == s);
+}
@@ -0,0 +1,204 @@
+/************************************************************************
+ *
+ * gamestate.h
+ * GameState class
+ *
+ ************************************************************************/
+
+#ifndef GAMESTATE_H
+#define GAMESTATE_H
+
+#include "bitplane.h"
+#include "random.h"
+
+#include <istream>
+#include <string>
+
+#define GAME_STATE_MAX_SIZE 64  // the most rows and columns a state can hold
+
+/**
+ * The position and statistics of a player.
+ */
+struct PlayerState
+{
+    signed char i, j;               // the player's cell, or -1 if none
+    signed char health, energy, ammo;
+};
+
+/**
+ * A GameState is a snapshot of everything that the rules of the game
+ * depend on: the shape of the maze, the walls and their heights, the items
+ * that have not been picked up, the players and whose turn it is. It holds
+ * no pointers to the maze or its cells, and nothing about how they are
+ * drawn, so that it can be copied with a plain assignment, compared and
+ * hashed, which is what a search over many possible games needs.
+ *
+ * Each property of the cells is kept as a plane of bits, one word for each
+ * row, laid out like a BitPlane. The wall heights of 1 to 3 are held in two
+ * planes, and each type of item has its own plane. A state is a fixed 4KB,
+ * so the maze must be no more than GAME_STATE_MAX_SIZE cells in each
+ * direction.
+ *
+ * The state knows nothing of the Level it may have been taken from, so
+ * that it can be built and played without the game's graphics; a
+ * StateBridge moves states in and out of a level. A state can also be
+ * loaded straight from a maze file, without creating a Maze, for games
+ * that are played without being drawn.
+ */
+class GameState
+{
+public:
+    /**
+     * The planes of bits.
+     */
+    enum Plane {
+        VISIBLE,        // the cell is part of the maze
+        WALL_LOW,       // the low bit of the wall height
+        WALL_HIGH,      // the high bit of the wall height
+        ITEM_HEALTH,    // the cell has an item of each type; these are in
+        ITEM_ENERGY,    // the same order as Item::ItemType
+        ITEM_GRENADE,
+        ITEM_TRAP,
+        REVEALED,       // the item on the cell can be seen
+        PLANES
+    };
+
+    /**
+     * Constructor. The state is for an empty maze.
+     */
+    GameState();
+
+    /**
+     * Load the state from a stream in the same format as a maze file, with
+     * the players on their starting cells with full statistics and the hero
+     * to move. The wall heights are taken from random, as Maze::load()
+     * does. name is used in error messages.
+     */
+    void load(std::istream &in, std::string name, Random &random);
+
+    /**
+     * Change the size of the maze, which must be no more than
+     * GAME_STATE_MAX_SIZE cells in each direction. All the planes are
+     * cleared, and the players are left as they are.
+     */
+    void resize(int width, int height);
+
+    /**
+     * Returns the number of columns.
+     */
+    int getWidth() const;
+
+    /**
+     * Returns the number of rows.
+     */
+    int getHeight() const;
+
+    /**
+     * Returns the bit of the cell at (i, j) in the plane.
+     */
+    bool get(Plane p, int i, int j) const
+    {
+        return (planes[p][i] >> j) & 1;
+    }
+
+    /**
+     * Set the bit of the cell at (i, j) in the plane.
+     */
+    void set(Plane p, int i, int j, bool on = true)
+    {
+        BitWord bit = ((BitWord) 1) << j;
+        if (on) {
+            planes[p][i] |= bit;
+        } else {
+            planes[p][i] &= ~bit;
+        }
+    }
+
+    /**
+     * Returns the cells of row i that a player could move onto, one bit for
+     * each column: they are part of the maze, they are not walls and no
+     * player is on them. The row must be in the maze.
+     */
+    BitWord getEnterable(int i) const
+    {
+        BitWord row = planes[VISIBLE][i] &
+            ~(planes[WALL_LOW][i] | planes[WALL_HIGH][i]);
+        if (hero.i == i) {
+            row &= ~(((BitWord) 1) << hero.j);
+        }
+        if (haggis.i == i) {
+            row &= ~(((BitWord) 1) << haggis.j);
+        }
+        return row;
+    }
+
+    /**
+     * Returns the height of the wall on the cell at (i, j), or 0 if there
+     * is no wall.
+     */
+    int getWallHeight(int i, int j) const;
+
+    /**
+     * Set the height of the wall on the cell at (i, j), from 0 to 3.
+     */
+    void setWallHeight(int i, int j, int h);
+
+    /**
+     * Returns the type of the item on the cell at (i, j) that has not been
+     * picked up, or -1 if there is none.
+     */
+    int getItem(int i, int j) const;
+
+    /**
+     * Returns true if the hero or the haggis is on the cell at (i, j).
+     */
+    bool hasPlayer(int i, int j) const;
+
+    /**
+     * Set a plane of the cells to the bits of a plane of this state.
+     */
+    void getPlane(Plane p, BitPlane &dest) const;
+
+    /**
+     * Set a plane of the cells to the cells a player could stand on: they
+     * are part of the maze and they are not walls. The players are not
+     * counted.
+     */
+    void getWalkable(BitPlane &dest) const;
+
+    /**
+     * Returns a 64 bit hash of the whole state, which is long enough for
+     * states to be told apart by their hashes alone.
+     */
+    uint64_t hash() const;
+
+    /**
+     * Returns true if the states are the same.
+     */
+    bool operator==(const GameState &s) const;
+    bool operator!=(const GameState &s) const;
+
+    /**
+     * The hero and the haggis.
+     */
+    PlayerState hero, haggis;
+
+    /**
+     * True if it is the hero's turn, and false if it is the haggis's.
+     */
+    bool heroTurn;
+
+private:
+    /**
+     * The size of the maze.
+     */
+    int width, height;
+
+    /**
+     * The rows of each plane. Only the first height rows are used, and the
+     * bits past the last column are clear.
+     */
+    BitWord planes[PLANES][GAME_STATE_MAX_SIZE];
+};
+
+#endif //GAMESTATE_H
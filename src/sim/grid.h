@@ -0,0 +1,215 @@
+/************************************************************************
+ *
+ * grid.h
+ * Grid template and grid topologies
+ *
+ ************************************************************************/
+
+#ifndef GRID_H
+#define GRID_H
+
+#include <vector>
+
+/**
+ * The change in grid position from one cell to another, as the change in
+ * row di and column dj.
+ */
+struct GridOffset
+{
+    int di, dj;
+};
+
+/**
+ * The topology of the maze: hexagonal cells in rows, with the odd rows
+ * shifted by half a cell towards higher columns. A cell's neighbours in
+ * the rows above and below depend on whether its own row is odd.
+ */
+struct HexTopology
+{
+    enum { NEIGHBOURS = 6 };
+
+    /**
+     * Returns the offsets to the neighbours of a cell in row i. They are
+     * the cells one step away in HexCoord's offset tables, so the layout
+     * is only given in one place.
+     */
+    static const GridOffset *getNeighbours(int i);
+};
+
+/**
+ * Square cells, which are joined to the four cells they share a side with.
+ */
+struct Square4Topology
+{
+    enum { NEIGHBOURS = 4 };
+
+    /**
+     * Returns the offsets to the neighbours of a cell in row i.
+     */
+    static const GridOffset *getNeighbours(int)
+    {
+        static const GridOffset offsets[NEIGHBOURS] = {
+            { 1,  0}, { 0,  1}, {-1,  0}, { 0, -1}
+        };
+        return offsets;
+    }
+};
+
+/**
+ * Square cells, which are joined to the eight cells they share a side or a
+ * corner with.
+ */
+struct Square8Topology
+{
+    enum { NEIGHBOURS = 8 };
+
+    /**
+     * Returns the offsets to the neighbours of a cell in row i.
+     */
+    static const GridOffset *getNeighbours(int)
+    {
+        static const GridOffset offsets[NEIGHBOURS] = {
+            { 1,  0}, { 1,  1}, { 0,  1}, {-1,  1},
+            {-1,  0}, {-1, -1}, { 0, -1}, { 1, -1}
+        };
+        return offsets;
+    }
+};
+
+/**
+ * A Grid knows how the cells of a rectangular grid are joined. The way
+ * cells are joined is given by the Topology, which has the number of
+ * neighbours of a cell and tables of offsets to them. The neighbours are
+ * worked out from the tables when they are needed, so nothing is stored
+ * for each cell, and since the topology is fixed at compile time the loops
+ * over the neighbours have a constant count.
+ *
+ * Cells are identified by their row i and column j, or by their index
+ * i*width + j. Searches that are written against the Grid work for any
+ * topology.
+ */
+template <class Topology>
+class Grid
+{
+public:
+    /**
+     * Constructor. The grid has the given number of columns and rows.
+     */
+    Grid(int width = 0, int height = 0)
+        : width(width), height(height)
+    {
+    }
+
+    /**
+     * Change the size of the grid.
+     */
+    void resize(int width, int height)
+    {
+        this->width = width;
+        this->height = height;
+    }
+
+    /**
+     * Returns the number of columns.
+     */
+    int getWidth() const
+    {
+        return width;
+    }
+
+    /**
+     * Returns the number of rows.
+     */
+    int getHeight() const
+    {
+        return height;
+    }
+
+    /**
+     * Returns the number of neighbours a cell has, counting those that
+     * would be off the edge of the grid.
+     */
+    static int getNeighbourCount()
+    {
+        return Topology::NEIGHBOURS;
+    }
+
+    /**
+     * Returns true if (i, j) is in the grid.
+     */
+    bool contains(int i, int j) const
+    {
+        return (i >= 0) && (i < height) && (j >= 0) && (j < width);
+    }
+
+    /**
+     * Returns the index of the cell at (i, j).
+     */
+    int getIndex(int i, int j) const
+    {
+        return i*width + j;
+    }
+
+    /**
+     * Sets (ni, nj) to neighbour k of the cell at (i, j). Returns false if
+     * the neighbour is off the edge of the grid.
+     */
+    bool getNeighbour(int i, int j, int k, int &ni, int &nj) const
+    {
+        const GridOffset &o = Topology::getNeighbours(i)[k];
+        ni = i + o.di;
+        nj = j + o.dj;
+        return contains(ni, nj);
+    }
+
+    /**
+     * Do a breadth-first search from the cell at (i, j) through the cells
+     * for which passable(ni, nj) is true. The index of every cell reached
+     * is added to order, nearest first, not counting the start. parents is
+     * set to the index of the cell each cell was reached from, or -1 for
+     * cells that were not reached. The start is its own parent.
+     */
+    template <class Passable>
+    void search(int i, int j, const Passable &passable,
+                std::vector<int> &order, std::vector<int> &parents) const
+    {
+        order.clear();
+        parents.assign(width*height, -1);
+
+        int start = getIndex(i, j);
+        parents[start] = start;
+        order.push_back(start);
+
+        // the order list is also the queue of the search
+        for (unsigned next=0; next<order.size(); next++) {
+            int ci = order[next] / width;
+            int cj = order[next] % width;
+            for (int k=0; k<Topology::NEIGHBOURS; k++) {
+                int ni, nj;
+                if (!getNeighbour(ci, cj, k, ni, nj)) {
+                    continue;
+                }
+                int n = getIndex(ni, nj);
+                if ((parents[n] == -1) && passable(ni, nj)) {
+                    parents[n] = order[next];
+                    order.push_back(n);
+                }
+            }
+        }
+
+        order.erase(order.begin());
+    }
+
+private:
+    /**
+     * The size of the grid.
+     */
+    int width, height;
+};
+
+/**
+ * The grid that the cells of a maze are in.
+ */
+typedef Grid<HexTopology> MazeGrid;
+
+#endif //GRID_H
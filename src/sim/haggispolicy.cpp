@@ -0,0 +1,149 @@
+/************************************************************************
+ *
+ * haggispolicy.cpp
+ * HaggisPolicy class implementation
+ *
+ ************************************************************************/
+
+#include "haggispolicy.h"
+#include "hexcoord.h"
+#include "bitplane.h"
+#include "rules.h"
+
+/**
+ * Constructor.
+ */
+HaggisPolicy::HaggisPolicy()
+{
+}
+
+/**
+ * Forget the path the haggis was following.
+ */
+void HaggisPolicy::reset()
+{
+    path.clear();
+}
+
+/**
+ * Returns the haggis' move.
+ */
+Move HaggisPolicy::choose(const GameState &s, Random &random)
+{
+    const PlayerState &me = s.haggis;
+    const PlayerState &hero = s.hero;
+
+    if (me.i < 0) {
+        //the haggis is not in the maze
+        return Move(Move::WAIT);
+    }
+
+    //if the haggis can see the hero, there is a 50% chance that it will shoot him
+    if (GameRules::canThrow(me) && (hero.i >= 0)) {
+        if(random.nextInt(2)) {
+            HexCoord here = HexCoord::fromMaze(me.i, me.j);
+            if(here.distance(HexCoord::fromMaze(hero.i, hero.j)) <= GRENADE_RANGE) {
+                return Move(Move::GRENADE, hero.i, hero.j);
+            }
+        }
+    }
+
+    if (!GameRules::canWalk(me))
+    {
+        return Move(Move::WAIT);
+    }
+
+    if(path.empty())
+    {
+        findPath(s, random);
+	if(path.empty())
+	{
+	    //the haggis is stuck
+	    return Move(Move::WAIT);
+	}
+    }
+
+    //go to next cell
+    int next = path.back();
+    path.pop_back();
+    int i = next / s.getWidth();
+    int j = next % s.getWidth();
+
+    //check that the player is not on this cell
+    if(s.hasPlayer(i, j))
+    {
+	//try to jump over the player.
+	if(path.empty())
+	{
+	    //decide to wait
+	    return Move(Move::WAIT);
+	}
+
+	//jump over the player
+	next = path.back();
+	path.pop_back();
+	return Move(Move::JUMP, next / s.getWidth(), next % s.getWidth());
+    }
+
+    return Move(Move::WALK, i, j);
+}
+
+/**
+ * Finds a random destination and the path to get there. The cells the
+ * haggis can walk to are found a whole step at a time on bit planes: each
+ * step is the last one expanded onto its neighbours, keeping the walkable
+ * cells that haven't been reached yet. The players are not counted, since
+ * they will have moved by the time the haggis gets there.
+ */
+void HaggisPolicy::findPath(const GameState &s, Random &random)
+{
+    BitPlane walkable;
+    s.getWalkable(walkable);
+
+    //find the cells that are each number of steps from the haggis
+    std::vector<BitPlane> steps(1, BitPlane(s.getWidth(), s.getHeight()));
+    steps[0].set(s.haggis.i, s.haggis.j);
+    BitPlane reached = steps[0];
+    BitPlane next;
+    while (true) {
+        steps.back().expand(next);
+        next &= walkable;
+        next.subtract(reached);
+        if (next.isEmpty()) {
+            break;
+        }
+        reached |= next;
+        steps.push_back(next);
+    }
+    reached.subtract(steps[0]);
+
+    //make sure the haggis can get somewhere
+    path.clear();
+    int visitable = reached.count();
+    if(visitable < 2)
+    {
+	return;
+    }
+
+    //choose a random destination
+    int i, j;
+    reached.findNth(random.nextInt(visitable), i, j);
+
+    //find the path to get there, going back a step at a time
+    MazeGrid grid(s.getWidth(), s.getHeight());
+    int d = steps.size() - 1;
+    while (!steps[d].get(i, j)) {
+        d--;
+    }
+    for (; d>0; d--) {
+        path.push_back(grid.getIndex(i, j));
+        for (int k=0; k<MazeGrid::getNeighbourCount(); k++) {
+            int ni, nj;
+            if (grid.getNeighbour(i, j, k, ni, nj) && steps[d-1].get(ni, nj)) {
+                i = ni;
+                j = nj;
+                break;
+            }
+        }
+    }
+}
@@ -0,0 +1,57 @@
+/************************************************************************
+ *
+ * haggispolicy.h
+ * HaggisPolicy class
+ *
+ ************************************************************************/
+
+#ifndef HAGGISPOLICY_H
+#define HAGGISPOLICY_H
+
+#include "policy.h"
+
+#include <vector>
+
+/**
+ * The HaggisPolicy is the haggis' AI. If the hero is within range, there
+ * is an even chance that the haggis throws a grenade at it. Otherwise the
+ * haggis picks a random cell it can walk to, and walks there one step at a
+ * time, jumping over the hero if it is in the way.
+ *
+ * The Haggis uses it to decide its moves in the game, and the Simulator
+ * uses it to play the haggis in games that are not drawn. It always plays
+ * the haggis, whoever's turn the state says it is.
+ */
+class HaggisPolicy : public Policy
+{
+public:
+    /**
+     * Constructor.
+     */
+    HaggisPolicy();
+
+    /**
+     * Forget the path the haggis was following.
+     */
+    virtual void reset();
+
+    /**
+     * Returns the haggis' move.
+     */
+    virtual Move choose(const GameState &s, Random &random);
+
+private:
+    /**
+     * The cells of the path the haggis is following, as row*width+column,
+     * with the next step at the back.
+     */
+    std::vector<int> path;
+
+    /**
+     * Choose a random destination the haggis can walk to, and set the path
+     * to get there.
+     */
+    void findPath(const GameState &s, Random &random);
+};
+
+#endif //HAGGISPOLICY_H
@@ -0,0 +1,119 @@
+/************************************************************************
+ *
+ * hexcoord.cpp
+ * HexCoord class implementation
+ *
+ ************************************************************************/
+
+#include "hexcoord.h"
+
+#include <cassert>
+#include <cstdlib>
+
+/**
+ * The offsets to the cells around a cell in an even row, nearest first.
+ */
+static const GridOffset evenOffsets[] = {
+    // 0 steps
+    { 0,  0},
+    // 1 step
+    { 1, -1}, { 1,  0}, { 0,  1}, {-1,  0}, {-1, -1}, { 0, -1},
+    // 2 steps
+    { 2, -1}, { 2,  0}, { 2,  1}, { 1,  1}, { 0,  2}, {-1,  1},
+    {-2,  1}, {-2,  0}, {-2, -1}, {-1, -2}, { 0, -2}, { 1, -2},
+    // 3 steps
+    { 3, -2}, { 3, -1}, { 3,  0}, { 3,  1}, { 2,  2}, { 1,  2},
+    { 0,  3}, {-1,  2}, {-2,  2}, {-3,  1}, {-3,  0}, {-3, -1},
+    {-3, -2}, {-2, -2}, {-1, -3}, { 0, -3}, { 1, -3}, { 2, -2},
+    // 4 steps
+    { 4, -2}, { 4, -1}, { 4,  0}, { 4,  1}, { 4,  2}, { 3,  2},
+    { 2,  3}, { 1,  3}, { 0,  4}, {-1,  3}, {-2,  3}, {-3,  2},
+    {-4,  2}, {-4,  1}, {-4,  0}, {-4, -1}, {-4, -2}, {-3, -3},
+    {-2, -3}, {-1, -4}, { 0, -4}, { 1, -4}, { 2, -3}, { 3, -3}
+};
+
+/**
+ * The offsets to the cells around a cell in an odd row, nearest first.
+ */
+static const GridOffset oddOffsets[] = {
+    // 0 steps
+    { 0,  0},
+    // 1 step
+    { 1,  0}, { 1,  1}, { 0,  1}, {-1,  1}, {-1,  0}, { 0, -1},
+    // 2 steps
+    { 2, -1}, { 2,  0}, { 2,  1}, { 1,  2}, { 0,  2}, {-1,  2},
+    {-2,  1}, {-2,  0}, {-2, -1}, {-1, -1}, { 0, -2}, { 1, -1},
+    // 3 steps
+    { 3, -1}, { 3,  0}, { 3,  1}, { 3,  2}, { 2,  2}, { 1,  3},
+    { 0,  3}, {-1,  3}, {-2,  2}, {-3,  2}, {-3,  1}, {-3,  0},
+    {-3, -1}, {-2, -2}, {-1, -2}, { 0, -3}, { 1, -2}, { 2, -2},
+    // 4 steps
+    { 4, -2}, { 4, -1}, { 4,  0}, { 4,  1}, { 4,  2}, { 3,  3},
+    { 2,  3}, { 1,  4}, { 0,  4}, {-1,  4}, {-2,  3}, {-3,  3},
+    {-4,  2}, {-4,  1}, {-4,  0}, {-4, -1}, {-4, -2}, {-3, -2},
+    {-2, -3}, {-1, -3}, { 0, -4}, { 1, -3}, { 2, -3}, { 3, -2}
+};
+
+/**
+ * Constructor.
+ */
+HexCoord::HexCoord(int q, int r)
+    : q(q), r(r)
+{
+}
+
+/**
+ * Returns the axial coordinates of the cell in row i and column j of the
+ * maze. The odd rows are shifted by half a cell towards higher columns.
+ */
+HexCoord HexCoord::fromMaze(int i, int j)
+{
+    return HexCoord(j - (i - (i & 1))/2, i);
+}
+
+/**
+ * Sets (i, j) to the row and column of the maze at these coordinates.
+ */
+void HexCoord::toMaze(int &i, int &j) const
+{
+    i = r;
+    j = q + (r - (r & 1))/2;
+}
+
+/**
+ * Returns the number of steps between the cells at these coordinates and h.
+ */
+int HexCoord::distance(const HexCoord &h) const
+{
+    int dq = q - h.q;
+    int dr = r - h.r;
+    return (abs(dq) + abs(dr) + abs(dq + dr))/2;
+}
+
+/**
+ * Returns the table of offsets to the cells around a cell in row i of the
+ * maze.
+ */
+const GridOffset *HexCoord::getOffsets(int i)
+{
+    return (i & 1) ? oddOffsets : evenOffsets;
+}
+
+/**
+ * Returns the offsets to the neighbours of a cell in row i, which are the
+ * cells one step away in the offset tables.
+ */
+const GridOffset *HexTopology::getNeighbours(int i)
+{
+    return HexCoord::getOffsets(i) + 1;
+}
+
+/**
+ * Returns the number of cells at most radius steps from a cell, including
+ * the cell itself.
+ */
+int HexCoord::getDiscSize(int radius)
+{
+    assert((radius >= 0) && (radius <= HEX_MAX_RADIUS));
+    return 1 + 3*radius*(radius + 1);
+}
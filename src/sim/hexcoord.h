@@ -0,0 +1,70 @@
+/************************************************************************
+ *
+ * hexcoord.h
+ * HexCoord class
+ *
+ ************************************************************************/
+
+#ifndef HEXCOORD_H
+#define HEXCOORD_H
+
+#include "grid.h"
+
+#define HEX_MAX_RADIUS 4  // the largest range covered by the offset tables
+
+/**
+ * A HexCoord is the position of a cell in axial coordinates. The maze
+ * stores its cells in rows, with the odd rows shifted by half a cell, which
+ * makes distances awkward to work out. In axial coordinates, the six
+ * neighbours of every cell are at the same offsets, and the distance
+ * between two cells is the number of steps between them.
+ *
+ * The cells within a range of a cell are found with offset tables instead
+ * of by testing distances. The tables list the maze offsets of the cells in
+ * rings around a cell, nearest first, with one table for cells in even rows
+ * and one for cells in odd rows. The first getDiscSize(n) offsets are the
+ * cells at most n steps away, and the offsets from getDiscSize(n-1) up to
+ * that are the cells exactly n steps away.
+ */
+class HexCoord
+{
+public:
+    int q, r;
+
+    /**
+     * Constructor.
+     */
+    HexCoord(int q = 0, int r = 0);
+
+    /**
+     * Returns the axial coordinates of the cell in row i and column j of
+     * the maze.
+     */
+    static HexCoord fromMaze(int i, int j);
+
+    /**
+     * Sets (i, j) to the row and column of the maze at these coordinates.
+     */
+    void toMaze(int &i, int &j) const;
+
+    /**
+     * Returns the number of steps between the cells at these coordinates
+     * and h.
+     */
+    int distance(const HexCoord &h) const;
+
+    /**
+     * Returns the table of offsets to the cells around a cell in row i of
+     * the maze. It has getDiscSize(HEX_MAX_RADIUS) entries.
+     */
+    static const GridOffset *getOffsets(int i);
+
+    /**
+     * Returns the number of cells at most radius steps from a cell,
+     * including the cell itself. The radius must not be more than
+     * HEX_MAX_RADIUS.
+     */
+    static int getDiscSize(int radius);
+};
+
+#endif //HEXCOORD_H
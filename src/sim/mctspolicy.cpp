@@ -0,0 +1,122 @@
+/************************************************************************
+ *
+ * mctspolicy.cpp
+ * MctsPolicy class implementation
+ *
+ ************************************************************************/
+
+#include "mctspolicy.h"
+#include "mctstree.h"
+#include "thread.h"
+#include "clock.h"
+
+#include <vector>
+
+/**
+ * The work given to a search thread: a tree of its own, and when to stop.
+ */
+struct MctsWorker
+{
+    MctsTree *tree;
+    uint32_t deadline;
+    int maxIterations;
+};
+
+/**
+ * The body of a search thread.
+ */
+static int runSearch(void *data)
+{
+    MctsWorker *w = (MctsWorker *) data;
+    w->tree->search(w->deadline, w->maxIterations);
+    return 0;
+}
+
+/**
+ * Constructor. The search uses the number of threads, or one for each
+ * processor if it is 0, and stops after budget milliseconds. If
+ * maxIterations is not 0, each thread also stops after that many
+ * iterations, and a budget of 0 means only that limit is used.
+ */
+MctsPolicy::MctsPolicy(int threads, int budget, int maxIterations)
+    : threads(threads), budget(budget), maxIterations(maxIterations),
+      iterations(0)
+{
+    if (this->threads < 1) {
+        this->threads = Thread::getProcessorCount();
+    }
+    if ((budget == 0) && (maxIterations == 0)) {
+        this->budget = MCTS_BUDGET;
+    }
+}
+
+/**
+ * Returns the move for the player whose turn it is. Each tree is seeded
+ * from the game's random numbers, so with an iteration limit the same game
+ * always gets the same move. The first thread's search runs on the calling
+ * thread.
+ */
+Move MctsPolicy::choose(const GameState &s, Random &random)
+{
+    const uint32_t deadline = budget ? Clock::getTicks() + budget : 0;
+
+    std::vector<MctsTree*> trees(threads);
+    std::vector<MctsWorker> workers(threads);
+    std::vector<Thread> handles(threads);
+    for (int k=0; k<threads; k++) {
+        trees[k] = new MctsTree(s, random.next());
+        workers[k].tree = trees[k];
+        workers[k].deadline = deadline;
+        workers[k].maxIterations = maxIterations;
+    }
+
+    for (int k=1; k<threads; k++) {
+        handles[k].start(runSearch, &workers[k]);
+    }
+    runSearch(&workers[0]);
+    for (int k=1; k<threads; k++) {
+        handles[k].join();
+    }
+
+    //add up the trees' visits to each first move, and take the most tried
+    const std::vector<Move> &moves = trees[0]->getRootMoves();
+    std::vector<int> visits(moves.size(), 0);
+    iterations = 0;
+    for (int k=0; k<threads; k++) {
+        for (unsigned int m=0; m<moves.size(); m++) {
+            visits[m] += trees[k]->getRootVisits(m);
+        }
+        iterations += trees[k]->getIterations();
+    }
+
+    int best = 0;
+    for (unsigned int m=1; m<moves.size(); m++) {
+        if (visits[m] > visits[best]) {
+            best = m;
+        }
+    }
+    Move move = moves[best];
+
+    for (int k=0; k<threads; k++) {
+        delete trees[k];
+    }
+
+    return move;
+}
+
+/**
+ * Returns true, since each search starts afresh from the state it is given.
+ */
+bool MctsPolicy::canPonder() const
+{
+    return true;
+}
+
+/**
+ * Returns the number of iterations run for the last move, over all the
+ * threads.
+ */
+int MctsPolicy::getIterations() const
+{
+    return iterations;
+}
@@ -0,0 +1,81 @@
+/************************************************************************
+ *
+ * mctspolicy.h
+ * MctsPolicy class
+ *
+ ************************************************************************/
+
+#ifndef MCTSPOLICY_H
+#define MCTSPOLICY_H
+
+#include "policy.h"
+
+#define MCTS_BUDGET 400  // the milliseconds a move may take, within WAIT_TIME
+
+/**
+ * The MctsPolicy chooses moves with a Monte Carlo tree search over every
+ * move the player can make: waiting, walking, jumping, throwing grenades and
+ * using psychic powers, with what each costs in energy and ammunition.
+ *
+ * The search is root parallel: each thread searches a tree of its own from
+ * the same state, with random numbers of its own, and when the time is up
+ * the number of times each first move was tried is added up over all the
+ * trees. The most tried move is played. The threads share nothing while
+ * they search, so no locking is needed.
+ *
+ * A move takes at most the time budget, which is shorter than a wait, so
+ * the haggis has decided before the hero's wait has finished. A limit on
+ * the number of iterations can be given instead, so that the moves only
+ * depend on the random numbers and not on the speed of the machine.
+ */
+class MctsPolicy : public Policy
+{
+public:
+    /**
+     * Constructor. The search uses the number of threads, or one for each
+     * processor if it is 0, and stops after budget milliseconds. If
+     * maxIterations is not 0, each thread also stops after that many
+     * iterations, and a budget of 0 means only that limit is used.
+     */
+    MctsPolicy(int threads = 0, int budget = MCTS_BUDGET,
+               int maxIterations = 0);
+
+    /**
+     * Returns the move for the player whose turn it is.
+     */
+    virtual Move choose(const GameState &s, Random &random);
+
+    /**
+     * Returns true, since each search starts afresh.
+     */
+    virtual bool canPonder() const;
+
+    /**
+     * Returns the number of iterations run for the last move, over all the
+     * threads.
+     */
+    int getIterations() const;
+
+private:
+    /**
+     * The number of threads to search with.
+     */
+    int threads;
+
+    /**
+     * The milliseconds a move may take.
+     */
+    int budget;
+
+    /**
+     * The most iterations each thread may run for a move.
+     */
+    int maxIterations;
+
+    /**
+     * The number of iterations run for the last move.
+     */
+    int iterations;
+};
+
+#endif //MCTSPOLICY_H
@@ -0,0 +1,259 @@
+/************************************************************************
+ *
+ * mctstree.cpp
+ * MctsTree class implementation
+ *
+ ************************************************************************/
+
+#include "mctstree.h"
+#include "clock.h"
+#include "rules.h"
+
+#include <math.h>
+
+/**
+ * Constructor. The search starts from the state, for the player whose turn
+ * it is, and its random moves are taken from the seed.
+ */
+MctsTree::MctsTree(const GameState &root, uint32_t seed)
+    : root(root), random(seed), iterations(0)
+{
+    bool added;
+    findNode(root, added);
+    expand(0, root);
+
+    for (unsigned int k=0; k<nodes[0].edges.size(); k++) {
+        rootMoves.push_back(nodes[0].edges[k].move);
+    }
+}
+
+/**
+ * Run iterations until the time from Clock::getTicks() reaches deadline, or
+ * maxIterations have been run. A deadline of 0 means there is no time
+ * limit, and maxIterations of 0 means there is no limit on the number of
+ * iterations. The clock is only read every few iterations, since reading it
+ * takes about as long as an iteration.
+ */
+void MctsTree::search(uint32_t deadline, int maxIterations)
+{
+    if (GameRules::isOver(root) || (rootMoves.size() < 2)) {
+        //there is nothing to choose between
+        return;
+    }
+
+    int n = 0;
+    while ((maxIterations == 0) || (n < maxIterations)) {
+        if ((deadline != 0) && (n % 16 == 0) &&
+            ((int32_t) (Clock::getTicks() - deadline) >= 0)) {
+            break;
+        }
+        iterate();
+        n++;
+    }
+}
+
+/**
+ * Returns the moves that can be made from the root, in the order given by
+ * GameRules::getMoves().
+ */
+const std::vector<Move> &MctsTree::getRootMoves() const
+{
+    return rootMoves;
+}
+
+/**
+ * Returns the number of times root move k has been tried.
+ */
+int MctsTree::getRootVisits(int k) const
+{
+    return nodes[0].edges[k].visits;
+}
+
+/**
+ * Returns the number of iterations that have been run.
+ */
+int MctsTree::getIterations() const
+{
+    return iterations;
+}
+
+/**
+ * Returns the number of positions in the tree.
+ */
+int MctsTree::getNodeCount() const
+{
+    return nodes.size();
+}
+
+/**
+ * Returns the chance that the haggis wins from the state. A game that is
+ * not over is scored by the difference between the players' health and
+ * energy, since a player dies when either runs out.
+ */
+double MctsTree::evaluate(const GameState &s)
+{
+    if (GameRules::isOver(s)) {
+        return GameRules::heroWon(s) ? 0 : 1;
+    }
+
+    int haggis = s.haggis.health + s.haggis.energy;
+    int hero = s.hero.health + s.hero.energy;
+    return 0.5 + (haggis - hero) / (8.0 * MAX_STAT);
+}
+
+/**
+ * Run one iteration: follow the tree down until it reaches a position that
+ * is new, or the end of the game, then score it, and count the score for
+ * every move on the way down.
+ */
+void MctsTree::iterate()
+{
+    GameState s = root;
+    int node = 0;
+    double value;
+    steps.clear();
+
+    while (true) {
+        if (GameRules::isOver(s)) {
+            value = evaluate(s);
+            break;
+        }
+
+        //moves that lead back to earlier positions can go round in
+        //circles, so the tree is only followed so far
+        if (steps.size() >= MCTS_MAX_DEPTH) {
+            value = playout(s);
+            break;
+        }
+
+        if (!nodes[node].expanded) {
+            expand(node, s);
+        }
+
+        Step step;
+        step.node = node;
+        step.edge = select(node);
+        step.heroMoved = s.heroTurn;
+        steps.push_back(step);
+        GameRules::play(s, nodes[node].edges[step.edge].move);
+
+        int child = nodes[node].edges[step.edge].child;
+        if (child < 0) {
+            bool added;
+            child = findNode(s, added);
+            if (child < 0) {
+                //the tree is full
+                value = playout(s);
+                break;
+            }
+            nodes[node].edges[step.edge].child = child;
+            if (added) {
+                value = playout(s);
+                break;
+            }
+        }
+        node = child;
+    }
+
+    for (unsigned int k=0; k<steps.size(); k++) {
+        Node &n = nodes[steps[k].node];
+        Edge &e = n.edges[steps[k].edge];
+        n.visits++;
+        e.visits++;
+        e.wins += steps[k].heroMoved ? 1 - value : value;
+    }
+    iterations++;
+}
+
+/**
+ * List the moves of the node from its state.
+ */
+void MctsTree::expand(int node, const GameState &s)
+{
+    GameRules::getMoves(s, moves);
+
+    Node &n = nodes[node];
+    n.edges.resize(moves.size());
+    for (unsigned int k=0; k<moves.size(); k++) {
+        n.edges[k].move = moves[k];
+        n.edges[k].child = -1;
+        n.edges[k].visits = 0;
+        n.edges[k].wins = 0;
+    }
+    n.expanded = true;
+}
+
+/**
+ * Returns the index of the edge of the node to follow. Moves that have
+ * never been tried come first, starting from a random one so that the
+ * order of the moves doesn't matter; after that, the move with the best
+ * upper confidence bound is taken.
+ */
+int MctsTree::select(int node)
+{
+    const Node &n = nodes[node];
+    const int size = n.edges.size();
+
+    const int start = random.nextInt(size);
+    for (int k=0; k<size; k++) {
+        int e = (start + k) % size;
+        if (n.edges[e].visits == 0) {
+            return e;
+        }
+    }
+
+    const double logVisits = log((double) n.visits);
+    int best = 0;
+    double bestScore = -1;
+    for (int e=0; e<size; e++) {
+        const Edge &edge = n.edges[e];
+        double score = edge.wins / edge.visits +
+            MCTS_EXPLORATION * sqrt(logVisits / edge.visits);
+        if (score > bestScore) {
+            best = e;
+            bestScore = score;
+        }
+    }
+    return best;
+}
+
+/**
+ * Returns the node for the state, adding it to the tree if it is not there
+ * yet. Returns -1 if the tree is full.
+ */
+int MctsTree::findNode(const GameState &s, bool &added)
+{
+    const uint64_t key = s.hash();
+    std::map<uint64_t, int>::iterator it = table.find(key);
+    if (it != table.end()) {
+        added = false;
+        return it->second;
+    }
+
+    if (nodes.size() >= MCTS_MAX_NODES) {
+        added = false;
+        return -1;
+    }
+
+    Node n;
+    n.visits = 0;
+    n.expanded = false;
+    nodes.push_back(n);
+    table[key] = nodes.size() - 1;
+
+    added = true;
+    return nodes.size() - 1;
+}
+
+/**
+ * Play random moves from the state, and return the chance that the haggis
+ * wins from where they end.
+ */
+double MctsTree::playout(GameState &s)
+{
+    for (int d=0; (d < MCTS_ROLLOUT_DEPTH) && !GameRules::isOver(s); d++) {
+        GameRules::getMoves(s, moves);
+        GameRules::play(s, moves[random.nextInt(moves.size())]);
+    }
+    return evaluate(s);
+}
@@ -0,0 +1,188 @@
+/************************************************************************
+ *
+ * mctstree.h
+ * MctsTree class
+ *
+ ************************************************************************/
+
+#ifndef MCTSTREE_H
+#define MCTSTREE_H
+
+#include "gamerules.h"
+#include "random.h"
+
+#include <map>
+#include <vector>
+
+#define MCTS_EXPLORATION 1.4     // how much unexplored moves are favoured
+#define MCTS_ROLLOUT_DEPTH 20    // the moves played at random from a leaf
+#define MCTS_MAX_NODES 50000     // the most positions a tree holds
+#define MCTS_MAX_DEPTH 60        // the deepest the tree is followed
+
+/**
+ * An MctsTree is a Monte Carlo tree search from one state of the game. Each
+ * iteration walks down the tree, choosing moves by how well they have done
+ * so far and how little they have been tried, adds the first position it
+ * reaches that is not in the tree yet, plays random moves from there for a
+ * while, and counts the outcome for every move on the way down.
+ *
+ * The same position can be reached by different orders of moves, such as
+ * a walk there and back and a wait. Positions are kept in a transposition
+ * table by the hash of their state, so each is only in the tree once and
+ * shares what has been learnt about it. The statistics are kept on the
+ * moves rather than the positions, so that a position with several parents
+ * still scores each of them properly.
+ *
+ * A tree is used by one thread. Searching on several threads is done with
+ * a tree for each, and their counts for the first moves are added up.
+ */
+class MctsTree
+{
+public:
+    /**
+     * Constructor. The search starts from the state, for the player whose
+     * turn it is, and its random moves are taken from the seed.
+     */
+    MctsTree(const GameState &root, uint32_t seed);
+
+    /**
+     * Run iterations until the time from Clock::getTicks() reaches deadline,
+     * or maxIterations have been run. A deadline of 0 means there is no
+     * time limit, and maxIterations of 0 means there is no limit on the
+     * number of iterations, but there must be one or the other.
+     */
+    void search(uint32_t deadline, int maxIterations);
+
+    /**
+     * Returns the moves that can be made from the root, in the order given
+     * by GameRules::getMoves().
+     */
+    const std::vector<Move> &getRootMoves() const;
+
+    /**
+     * Returns the number of times root move k has been tried.
+     */
+    int getRootVisits(int k) const;
+
+    /**
+     * Returns the number of iterations that have been run.
+     */
+    int getIterations() const;
+
+    /**
+     * Returns the number of positions in the tree.
+     */
+    int getNodeCount() const;
+
+    /**
+     * Returns the chance that the haggis wins from the state, as scored at
+     * the end of a random playout: 1 or 0 if the game is over, and
+     * otherwise between 0.25 and 0.75 depending on which player has more
+     * health and energy left.
+     */
+    static double evaluate(const GameState &s);
+
+private:
+    /**
+     * A move from a position, and how well it has done.
+     */
+    struct Edge
+    {
+        Move move;
+        int child;      // the position it leads to, or -1 if not known yet
+        int visits;
+        double wins;    // for the player making the move
+    };
+
+    /**
+     * A position in the tree.
+     */
+    struct Node
+    {
+        int visits;
+        bool expanded;  // true once the edges have been listed
+        std::vector<Edge> edges;
+    };
+
+    /**
+     * The state the search starts from.
+     */
+    GameState root;
+
+    /**
+     * The moves that can be made from the root.
+     */
+    std::vector<Move> rootMoves;
+
+    /**
+     * The positions, with the root first.
+     */
+    std::vector<Node> nodes;
+
+    /**
+     * The transposition table, from the hash of a position's state to its
+     * index in nodes.
+     */
+    std::map<uint64_t, int> table;
+
+    /**
+     * The random numbers for the playouts and for breaking ties.
+     */
+    Random random;
+
+    /**
+     * The moves of the playouts, kept to save allocating them each move.
+     */
+    std::vector<Move> moves;
+
+    /**
+     * The number of iterations run.
+     */
+    int iterations;
+
+    /**
+     * A step of the way down the tree: the node, the edge followed from it,
+     * and whether the hero made the move.
+     */
+    struct Step
+    {
+        int node;
+        int edge;
+        bool heroMoved;
+    };
+
+    /**
+     * The way down the tree of the current iteration, kept to save
+     * allocating it each time.
+     */
+    std::vector<Step> steps;
+
+    /**
+     * Run one iteration.
+     */
+    void iterate();
+
+    /**
+     * List the moves of the node from its state.
+     */
+    void expand(int node, const GameState &s);
+
+    /**
+     * Returns the index of the edge of the node to follow.
+     */
+    int select(int node);
+
+    /**
+     * Returns the node for the state, adding it to the tree if it is not
+     * there yet. Returns -1 if the tree is full.
+     */
+    int findNode(const GameState &s, bool &added);
+
+    /**
+     * Play random moves from the state, and return the chance that the
+     * haggis wins from where they end.
+     */
+    double playout(GameState &s);
+};
+
+#endif //MCTSTREE_H
@@ -0,0 +1,52 @@
+/************************************************************************
+ *
+ * policy.h
+ * Policy class
+ *
+ ************************************************************************/
+
+#ifndef POLICY_H
+#define POLICY_H
+
+#include "gamerules.h"
+#include "random.h"
+
+/**
+ * A Policy decides the moves of a player in games that are played on a
+ * GameState. It may remember things between its turns in a game, such as a
+ * path it is following, so each game needs a policy of its own, or reset()
+ * must be called between games. Any random choices are taken from the
+ * random numbers of the game, so a game played again with the same seed
+ * makes the same moves.
+ */
+class Policy
+{
+public:
+    /**
+     * Destructor.
+     */
+    virtual ~Policy() {}
+
+    /**
+     * Forget anything remembered from an earlier game.
+     */
+    virtual void reset() {}
+
+    /**
+     * Returns the move for the player whose turn it is.
+     */
+    virtual Move choose(const GameState &s, Random &random) = 0;
+
+    /**
+     * Returns true if the policy can be asked for moves ahead of time, on
+     * another thread, including in positions that are never reached. This
+     * is only safe if it remembers nothing between moves, and only worth
+     * it if its moves take long to choose.
+     */
+    virtual bool canPonder() const
+    {
+        return false;
+    }
+};
+
+#endif //POLICY_H
@@ -0,0 +1,30 @@
+/************************************************************************
+ *
+ * random.cpp
+ * Random class implementation
+ *
+ ************************************************************************/
+
+#include "random.h"
+
+/**
+ * Constructor. The stream starts from the seed.
+ */
+Random::Random(uint32_t seed)
+{
+    setSeed(seed);
+}
+
+/**
+ * Start the stream again from the seed. The seed is mixed so that seeds
+ * that are close together, like the numbers of successive games, give
+ * streams that are not alike.
+ */
+void Random::setSeed(uint32_t seed)
+{
+    uint64_t z = seed + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    z ^= z >> 31;
+    state = z ? z : 1;
+}
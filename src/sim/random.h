@@ -0,0 +1,61 @@
+/************************************************************************
+ *
+ * random.h
+ * Random class
+ *
+ ************************************************************************/
+
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <stdint.h>
+
+/**
+ * A Random is a stream of pseudo-random numbers that belongs to one game.
+ * The same seed always gives the same numbers, so a game can be played
+ * again exactly, and since each game has its own stream, games played at
+ * the same time on different threads don't share any state.
+ *
+ * The numbers come from a 64 bit xorshift generator, with the output
+ * multiplied by a constant to hide the patterns in its low bits.
+ */
+class Random
+{
+public:
+    /**
+     * Constructor. The stream starts from the seed.
+     */
+    Random(uint32_t seed = 1);
+
+    /**
+     * Start the stream again from the seed.
+     */
+    void setSeed(uint32_t seed);
+
+    /**
+     * Returns the next 32 random bits.
+     */
+    uint32_t next()
+    {
+        state ^= state >> 12;
+        state ^= state << 25;
+        state ^= state >> 27;
+        return (uint32_t) ((state * 2685821657736338717ULL) >> 32);
+    }
+
+    /**
+     * Returns a random number from 0 to n-1. n must be positive.
+     */
+    int nextInt(int n)
+    {
+        return (int) (((uint64_t) next() * (uint64_t) n) >> 32);
+    }
+
+private:
+    /**
+     * The state of the generator. It is never 0.
+     */
+    uint64_t state;
+};
+
+#endif //RANDOM_H
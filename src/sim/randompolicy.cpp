@@ -0,0 +1,17 @@
+/************************************************************************
+ *
+ * randompolicy.cpp
+ * RandomPolicy class implementation
+ *
+ ************************************************************************/
+
+#include "randompolicy.h"
+
+/**
+ * Returns a random move for the player whose turn it is.
+ */
+Move RandomPolicy::choose(const GameState &s, Random &random)
+{
+    GameRules::getMoves(s, moves);
+    return moves[random.nextInt(moves.size())];
+}
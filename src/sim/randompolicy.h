@@ -0,0 +1,35 @@
+/************************************************************************
+ *
+ * randompolicy.h
+ * RandomPolicy class
+ *
+ ************************************************************************/
+
+#ifndef RANDOMPOLICY_H
+#define RANDOMPOLICY_H
+
+#include "policy.h"
+
+#include <vector>
+
+/**
+ * The RandomPolicy makes any of the moves the rules allow with equal
+ * chance. It is the weakest opponent, and plays either player.
+ */
+class RandomPolicy : public Policy
+{
+public:
+    /**
+     * Returns a random move for the player whose turn it is.
+     */
+    virtual Move choose(const GameState &s, Random &random);
+
+private:
+    /**
+     * The moves to choose from. This is kept to save allocating it each
+     * turn.
+     */
+    std::vector<Move> moves;
+};
+
+#endif //RANDOMPOLICY_H
@@ -0,0 +1,26 @@
+/************************************************************************
+ *
+ * rules.h
+ * The numbers the rules of the game are made of
+ *
+ ************************************************************************/
+
+#ifndef RULES_H
+#define RULES_H
+
+#define MAX_STAT 16         // the largest value of a player attribute
+#define MAX_WALL_HEIGHT 3   // the maximum wall height
+
+#define WALK_ENERGY 1       // the energy needed to walk
+#define JUMP_RANGE 3        // the number of steps a jump can cover
+#define JUMP_ENERGY 5       // the energy needed to jump
+#define GRENADE_RANGE 3     // the number of steps a grenade can be thrown
+#define GRENADE_DAMAGE 4    // the health a player loses when hit
+#define PSYCHIC_ENERGY 1    // the energy needed to use psychic powers
+
+#define HEALTH_INCREASE 4   // by how much the health item increases health
+#define ENERGY_INCREASE 4   // by how much the energy item increases energy
+#define AMMO_INCREASE 1     // by how much the grenade item increases ammo
+#define HEALTH_DECREASE 4   // by how much the trap item decreases health
+
+#endif //RULES_H
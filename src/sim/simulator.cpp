@@ -0,0 +1,206 @@
+/************************************************************************
+ *
+ * simulator.cpp
+ * Simulator class implementation
+ *
+ ************************************************************************/
+
+#include "simulator.h"
+#include "gamerules.h"
+#include "haggispolicy.h"
+#include "randompolicy.h"
+#include "chasepolicy.h"
+#include "mctspolicy.h"
+#include "thread.h"
+#include "clock.h"
+
+#include <vector>
+
+/**
+ * The work given to a worker thread, and the results it gives back.
+ */
+struct SimulationWorker
+{
+    const Simulator *simulator;
+    Simulator::HeroType hero;
+    Simulator::HaggisType haggis;
+    uint32_t first;     // the seed of the worker's first game
+    int games;
+    Simulator::Stats stats;
+};
+
+/**
+ * The body of a worker thread. It plays its games with policies of its
+ * own.
+ */
+static int runWorker(void *data)
+{
+    SimulationWorker *w = (SimulationWorker *) data;
+
+    Policy *hero = Simulator::makeHero(w->hero);
+    Policy *haggis = Simulator::makeHaggis(w->haggis);
+    Random random;
+    for (int g=0; g<w->games; g++) {
+        hero->reset();
+        haggis->reset();
+        random.setSeed(w->first + g);
+        w->simulator->play(*hero, *haggis, random, w->stats);
+    }
+    delete hero;
+    delete haggis;
+
+    return 0;
+}
+
+/**
+ * Constructor. No games have been played.
+ */
+Simulator::Stats::Stats()
+    : games(0), heroWins(0), haggisWins(0), draws(0), moves(0), seconds(0)
+{
+}
+
+/**
+ * Add the results of other games. The times are not added.
+ */
+void Simulator::Stats::add(const Stats &s)
+{
+    games += s.games;
+    heroWins += s.heroWins;
+    haggisWins += s.haggisWins;
+    draws += s.draws;
+    moves += s.moves;
+}
+
+/**
+ * Returns the number of games played per second.
+ */
+double Simulator::Stats::getGamesPerSecond() const
+{
+    return (seconds > 0) ? games / seconds : 0;
+}
+
+/**
+ * Constructor. Every game starts from the state, and a game that has not
+ * been won after maxMoves moves is a draw. Game n is played with the random
+ * numbers from seed + n.
+ */
+Simulator::Simulator(const GameState &start, HeroType hero, int maxMoves,
+                     uint32_t seed)
+    : start(start), hero(hero), haggis(SCRIPTED_HAGGIS), maxMoves(maxMoves),
+      seed(seed)
+{
+}
+
+/**
+ * Set the haggis AI to play with. It is the scripted one unless this is
+ * called.
+ */
+void Simulator::setHaggis(HaggisType type)
+{
+    haggis = type;
+}
+
+/**
+ * Play one game between the policies with the random numbers, and add its
+ * result to stats. The game is over as soon as a player is dead, whoever's
+ * turn it was.
+ */
+Simulator::Result Simulator::play(Policy &hero, Policy &haggis,
+                                  Random &random, Stats &stats) const
+{
+    GameState s = start;
+
+    int moves = 0;
+    while (!GameRules::isOver(s) && (moves < maxMoves)) {
+        Policy &p = s.heroTurn ? hero : haggis;
+        GameRules::play(s, p.choose(s, random));
+        moves++;
+    }
+
+    stats.games++;
+    stats.moves += moves;
+    if (!GameRules::isOver(s)) {
+        stats.draws++;
+        return DRAW;
+    } else if (GameRules::heroWon(s)) {
+        stats.heroWins++;
+        return HERO_WON;
+    } else {
+        stats.haggisWins++;
+        return HAGGIS_WON;
+    }
+}
+
+/**
+ * Play the games, shared out between the worker threads, and return their
+ * results. The time taken is the time until the last worker finished.
+ */
+Simulator::Stats Simulator::run(int games, int threads) const
+{
+    if (threads < 1) {
+        threads = 1;
+    }
+
+    std::vector<SimulationWorker> workers(threads);
+    std::vector<Thread> handles(threads);
+
+    uint32_t startTime = Clock::getTicks();
+    uint32_t next = seed;
+    for (int k=0; k<threads; k++) {
+        workers[k].simulator = this;
+        workers[k].hero = hero;
+        workers[k].haggis = haggis;
+        workers[k].first = next;
+        workers[k].games = games / threads + ((k < games % threads) ? 1 : 0);
+        next += workers[k].games;
+        handles[k].start(runWorker, &workers[k]);
+    }
+
+    Stats total;
+    for (int k=0; k<threads; k++) {
+        handles[k].join();
+        total.add(workers[k].stats);
+    }
+    total.seconds = (Clock::getTicks() - startTime) / 1000.0;
+
+    return total;
+}
+
+/**
+ * Returns the number of processors, which is the number of threads that
+ * makes the best use of the machine.
+ */
+int Simulator::getProcessorCount()
+{
+    return Thread::getProcessorCount();
+}
+
+/**
+ * Returns a new hero policy of the type. It is the caller's responsibility
+ * to delete it.
+ */
+Policy *Simulator::makeHero(HeroType type)
+{
+    if (type == CHASE_HERO) {
+        return new ChasePolicy();
+    } else {
+        return new RandomPolicy();
+    }
+}
+
+/**
+ * Returns a new haggis policy of the type. It is the caller's
+ * responsibility to delete it. The MCTS haggis searches on the worker's
+ * own thread for a fixed number of iterations, since the games are already
+ * played in parallel, and so that its moves don't depend on the speed of
+ * the machine.
+ */
+Policy *Simulator::makeHaggis(HaggisType type)
+{
+    if (type == MCTS_HAGGIS) {
+        return new MctsPolicy(1, 0, MCTS_SIMULATION_ITERATIONS);
+    } else {
+        return new HaggisPolicy();
+    }
+}
@@ -0,0 +1,144 @@
+/************************************************************************
+ *
+ * simulator.h
+ * Simulator class
+ *
+ ************************************************************************/
+
+#ifndef SIMULATOR_H
+#define SIMULATOR_H
+
+#include "gamestate.h"
+#include "policy.h"
+
+#define MCTS_SIMULATION_ITERATIONS 200  // a simulated MCTS haggis' search
+
+/**
+ * The Simulator plays whole games between the haggis' AI and a hero
+ * policy, using the GameRules instead of a Level, so no window, rendering
+ * or animation is needed. It is used to measure how strong the AI is
+ * against different heroes, and how quickly games can be played.
+ *
+ * Many games are played at once, one for each worker thread. Each worker
+ * has its own policies and game state, so the workers share nothing until
+ * their results are added up at the end. Each game has its own random
+ * numbers, seeded from the simulator's seed and the number of the game, so
+ * the results are the same however many threads play them.
+ */
+class Simulator
+{
+public:
+    /**
+     * The hero policies the simulator can play against.
+     */
+    enum HeroType {RANDOM_HERO, CHASE_HERO};
+
+    /**
+     * The haggis AIs the simulator can play with.
+     */
+    enum HaggisType {SCRIPTED_HAGGIS, MCTS_HAGGIS};
+
+    /**
+     * The outcome of a game.
+     */
+    enum Result {HERO_WON, HAGGIS_WON, DRAW};
+
+    /**
+     * The results of a number of games.
+     */
+    struct Stats
+    {
+        int games;
+        int heroWins, haggisWins, draws;
+        long moves;         // the moves made in all the games
+        double seconds;     // the time taken to play them
+
+        /**
+         * Constructor. No games have been played.
+         */
+        Stats();
+
+        /**
+         * Add the results of other games. The times are not added.
+         */
+        void add(const Stats &s);
+
+        /**
+         * Returns the number of games played per second.
+         */
+        double getGamesPerSecond() const;
+    };
+
+    /**
+     * Constructor. Every game starts from the state, and a game that has not
+     * been won after maxMoves moves is a draw. Game n is played with the
+     * random numbers from seed + n.
+     */
+    Simulator(const GameState &start, HeroType hero, int maxMoves = 1000,
+              uint32_t seed = 1);
+
+    /**
+     * Set the haggis AI to play with. It is the scripted one unless this is
+     * called.
+     */
+    void setHaggis(HaggisType type);
+
+    /**
+     * Play one game between the policies with the random numbers, and add
+     * its result to stats.
+     */
+    Result play(Policy &hero, Policy &haggis, Random &random,
+                Stats &stats) const;
+
+    /**
+     * Play the games, shared out between the worker threads, and return
+     * their results.
+     */
+    Stats run(int games, int threads) const;
+
+    /**
+     * Returns the number of processors, which is the number of threads that
+     * makes the best use of the machine.
+     */
+    static int getProcessorCount();
+
+    /**
+     * Returns a new hero policy of the type. It is the caller's
+     * responsibility to delete it.
+     */
+    static Policy *makeHero(HeroType type);
+
+    /**
+     * Returns a new haggis policy of the type. It is the caller's
+     * responsibility to delete it.
+     */
+    static Policy *makeHaggis(HaggisType type);
+
+private:
+    /**
+     * The state every game starts from.
+     */
+    GameState start;
+
+    /**
+     * The hero policy to play against.
+     */
+    HeroType hero;
+
+    /**
+     * The haggis AI to play with.
+     */
+    HaggisType haggis;
+
+    /**
+     * The number of moves after which a game is a draw.
+     */
+    int maxMoves;
+
+    /**
+     * The seed of the random numbers of the first game.
+     */
+    uint32_t seed;
+};
+
+#endif //SIMULATOR_H
@@ -0,0 +1,65 @@
+/************************************************************************
+ *
+ * thread.cpp
+ * Thread class implementation
+ *
+ ************************************************************************/
+
+#include "thread.h"
+
+#include <unistd.h>
+
+/**
+ * Constructor. The thread is not started.
+ */
+Thread::Thread()
+    : function(0), data(0), result(0), running(false)
+{
+}
+
+/**
+ * Start running the function with the data on the thread. If the thread
+ * cannot be created, the function is run before this returns, so that the
+ * work is still done, only not in parallel.
+ */
+void Thread::start(Function function, void *data)
+{
+    this->function = function;
+    this->data = data;
+    running = (pthread_create(&handle, NULL, run, this) == 0);
+    if (!running) {
+        run(this);
+    }
+}
+
+/**
+ * Wait for the function to return, and return its result.
+ */
+int Thread::join()
+{
+    if (running) {
+        pthread_join(handle, NULL);
+        running = false;
+    }
+    return result;
+}
+
+/**
+ * Returns the number of processors, which is the number of threads that
+ * makes the best use of the machine.
+ */
+int Thread::getProcessorCount()
+{
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return (n > 0) ? n : 1;
+}
+
+/**
+ * The entry point of the thread, which calls the function.
+ */
+void *Thread::run(void *thread)
+{
+    Thread *t = (Thread *) thread;
+    t->result = t->function(t->data);
+    return NULL;
+}
@@ -0,0 +1,77 @@
+/************************************************************************
+ *
+ * thread.h
+ * Thread class
+ *
+ ************************************************************************/
+
+#ifndef THREAD_H
+#define THREAD_H
+
+#include <pthread.h>
+
+/**
+ * A Thread runs a function on a thread of its own. It is a thin wrapper
+ * around POSIX threads, so that the simulator and the AI's search can run
+ * in parallel without the game's libraries. A thread is started once and
+ * must be joined before it is destroyed.
+ */
+class Thread
+{
+public:
+    /**
+     * The function a thread runs. Its result is returned by join().
+     */
+    typedef int (*Function)(void *data);
+
+    /**
+     * Constructor. The thread is not started.
+     */
+    Thread();
+
+    /**
+     * Start running the function with the data on the thread. If the
+     * thread cannot be created, the function is run before this returns.
+     */
+    void start(Function function, void *data);
+
+    /**
+     * Wait for the function to return, and return its result.
+     */
+    int join();
+
+    /**
+     * Returns the number of processors, which is the number of threads that
+     * makes the best use of the machine.
+     */
+    static int getProcessorCount();
+
+private:
+    /**
+     * The entry point of the thread, which calls the function.
+     */
+    static void *run(void *thread);
+
+    /**
+     * The POSIX thread.
+     */
+    pthread_t handle;
+
+    /**
+     * The function to run and its data.
+     */
+    Function function;
+    void *data;
+
+    /**
+     * The result of the function.
+     */
+    int result;
+
+    /**
+     * True if the POSIX thread was created and has not been joined.
+     */
+    bool running;
+};
+
+#endif //THREAD_H
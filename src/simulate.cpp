@@ -0,0 +1,76 @@
+/************************************************************************
+ *
+ * simulate.cpp
+ * Simulator program
+ *
+ ************************************************************************/
+
+#include "simulator.h"
+#include "apperror.h"
+
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <cstdlib>
+using namespace std;
+
+const char *getOption(int argc, char *argv[], const char *option,
+                      const char *def)
+{
+    for (int i=1; i+1<argc; i++) {
+        if (strcmp(argv[i], option) == 0) {
+            return argv[i+1];
+        }
+    }
+    return def;
+}
+
+int runSimulation(int argc, char *argv[])
+{
+    const char *fn = getOption(argc, argv, "--maze", "level1.hag");
+    int games = atoi(getOption(argc, argv, "--games", "10000"));
+    int threads = atoi(getOption(argc, argv, "--threads", "0"));
+    uint32_t seed = strtoul(getOption(argc, argv, "--seed", "1"), NULL, 10);
+    bool mcts = strcmp(getOption(argc, argv, "--haggis", "scripted"),
+                       "mcts") == 0;
+    if (threads < 1) {
+        threads = Simulator::getProcessorCount();
+    }
+    if (games < 1) {
+        games = 1;
+    }
+
+    GameState start;
+    try {
+        ifstream in(fn);
+        Random random(seed);
+        start.load(in, fn, random);
+    } catch (app_error &e) {
+        cout << e.what() << endl;
+        return 1;
+    }
+
+    const char *names[] = {"random", "chase"};
+    Simulator::HeroType heroes[] = {Simulator::RANDOM_HERO,
+                                    Simulator::CHASE_HERO};
+    cout << games << " games on " << threads << " threads" << endl;
+    for (int k=0; k<2; k++) {
+        Simulator sim(start, heroes[k], 1000, seed);
+        if (mcts) {
+            sim.setHaggis(Simulator::MCTS_HAGGIS);
+        }
+        Simulator::Stats s = sim.run(games, threads);
+        cout << "haggis vs " << names[k] << " hero: "
+             << s.heroWins << " hero wins, "
+             << s.haggisWins << " haggis wins, "
+             << s.draws << " draws, "
+             << double(s.moves) / s.games << " moves a game, "
+             << s.getGamesPerSecond() << " games/s" << endl;
+    }
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    return runSimulation(argc, argv);
+}
@@ -18,4 +18,26 @@ void registerAll()
     register_grenadeaction();
     register_walkaction();
     register_waitaction();
+    register_pool();
+    register_item();
+    register_uibatch();
+    register_textureatlas();
+    register_renderstate();
+    register_terrain();
+    register_levelofdetail();
+    register_resolutionscaler();
+    register_hitindex();
+    register_cellset();
+    register_hexcoord();
+    register_grid();
+    register_celllayout();
+    register_bitplane();
+    register_gamestate();
+    register_gamerules();
+    register_simulator();
+    register_random();
+    register_mctspolicy();
+    register_thinker();
+    register_zobrist();
+    register_thread();
 }
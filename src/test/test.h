@@ -20,3 +20,25 @@ void register_jumpaction();
 void register_grenadeaction();
 void register_walkaction();
 void register_waitaction();
+void register_pool();
+void register_item();
+void register_uibatch();
+void register_textureatlas();
+void register_renderstate();
+void register_terrain();
+void register_levelofdetail();
+void register_resolutionscaler();
+void register_hitindex();
+void register_cellset();
+void register_hexcoord();
+void register_grid();
+void register_celllayout();
+void register_bitplane();
+void register_gamestate();
+void register_gamerules();
+void register_simulator();
+void register_random();
+void register_mctspolicy();
+void register_thinker();
+void register_zobrist();
+void register_thread();
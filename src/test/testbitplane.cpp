@@ -0,0 +1,155 @@
+/************************************************************************
+ *
+ * testbitplane.cpp
+ * BitPlane class tests
+ *
+ ************************************************************************/
+
+#include "bitplane.h"
+#include "grid.h"
+
+#include "test.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * Lets the search through the cells that are set in a plane.
+ */
+struct InPlane
+{
+    const BitPlane *plane;
+
+    InPlane(const BitPlane *plane)
+        : plane(plane)
+    {
+    }
+
+    bool operator()(int i, int j) const
+    {
+        return plane->get(i, j);
+    }
+};
+
+/**
+ * This test suite contains one test case:
+ *
+ * Code: CT-BPl
+ * Name: BitPlane class unit tests
+ * Configuration: Unit testing context
+ * Tools: Cppunit
+ * Description: Class tests for the BitPlane class
+ */
+class testbitplane : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(testbitplane);
+    CPPUNIT_TEST(testBits);
+    CPPUNIT_TEST(testSetOperations);
+    CPPUNIT_TEST(testExpand);
+    CPPUNIT_TEST(testFloodFill);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void testBits()
+    {
+        // the planes are wider than a word
+        BitPlane p(130, 3);
+        CPPUNIT_ASSERT(p.isEmpty());
+        CPPUNIT_ASSERT(p.getWordsPerRow() == 3);
+
+        p.set(2, 129);
+        p.set(1, 64);
+        CPPUNIT_ASSERT(p.get(2, 129) && p.get(1, 64) && !p.get(1, 63));
+        CPPUNIT_ASSERT(p.count() == 2);
+
+        int i, j;
+        CPPUNIT_ASSERT(p.findFirst(i, j));
+        CPPUNIT_ASSERT((i == 1) && (j == 64));
+        CPPUNIT_ASSERT(p.findNth(1, i, j));
+        CPPUNIT_ASSERT((i == 2) && (j == 129));
+        CPPUNIT_ASSERT(!p.findNth(2, i, j));
+
+        p.set(1, 64, false);
+        p.fill();
+        CPPUNIT_ASSERT(p.count() == 390);
+    }
+
+    void testSetOperations()
+    {
+        BitPlane a(10, 10), b(10, 10);
+        a.set(1, 1);
+        a.set(2, 2);
+        b.set(2, 2);
+        b.set(3, 3);
+
+        BitPlane c = a;
+        c &= b;
+        CPPUNIT_ASSERT((c.count() == 1) && c.get(2, 2));
+
+        c = a;
+        c |= b;
+        CPPUNIT_ASSERT(c.count() == 3);
+
+        c.subtract(a);
+        CPPUNIT_ASSERT((c.count() == 1) && c.get(3, 3));
+        CPPUNIT_ASSERT(c != a);
+    }
+
+    void testExpand()
+    {
+        // each cell grows into exactly its grid neighbours, including
+        // across the words of a row
+        MazeGrid grid(130, 6);
+        int cols[] = {0, 5, 63, 64, 127, 129};
+        for (int i=0; i<6; i++) {
+            for (int c=0; c<6; c++) {
+                BitPlane p(130, 6), q;
+                p.set(i, cols[c]);
+                p.expand(q);
+
+                BitPlane expected(130, 6);
+                expected.set(i, cols[c]);
+                for (int k=0; k<MazeGrid::getNeighbourCount(); k++) {
+                    int ni, nj;
+                    if (grid.getNeighbour(i, cols[c], k, ni, nj)) {
+                        expected.set(ni, nj);
+                    }
+                }
+                CPPUNIT_ASSERT(q == expected);
+            }
+        }
+    }
+
+    void testFloodFill()
+    {
+        // a wall down column 70 with a gap in row 3
+        BitPlane open(100, 8);
+        open.fill();
+        for (int i=0; i<8; i++) {
+            if (i != 3) {
+                open.set(i, 70, false);
+            }
+        }
+
+        BitPlane p(100, 8);
+        p.set(0, 0);
+        p.floodFill(open);
+        CPPUNIT_ASSERT(p == open);
+
+        // the fill reaches the same cells as a search
+        open.set(3, 70, false);
+        p.clear();
+        p.set(0, 0);
+        p.floodFill(open);
+
+        std::vector<int> order, parents;
+        MazeGrid grid(100, 8);
+        grid.search(0, 0, InPlane(&open), order, parents);
+        CPPUNIT_ASSERT(p.count() == (int) order.size() + 1);
+        CPPUNIT_ASSERT(!p.get(0, 71));
+    }
+};
+
+void register_bitplane()
+{
+    CPPUNIT_TEST_SUITE_REGISTRATION(testbitplane);
+}
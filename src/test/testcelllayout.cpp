@@ -0,0 +1,110 @@
+/************************************************************************
+ *
+ * testcelllayout.cpp
+ * CellLayout class tests
+ *
+ ************************************************************************/
+
+#include "celllayout.h"
+#include "maze.h"
+
+#include "test.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <vector>
+
+/**
+ * This test suite contains one test case:
+ *
+ * Code: CT-CLa
+ * Name: CellLayout class unit tests
+ * Configuration: Unit testing context
+ * Tools: Cppunit
+ * Description: Class tests for the CellLayout class
+ */
+class testcelllayout : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(testcelllayout);
+    CPPUNIT_TEST(testRowMajor);
+    CPPUNIT_TEST(testTiled);
+    CPPUNIT_TEST(testMaze);
+    CPPUNIT_TEST_SUITE_END();
+
+    /**
+     * Returns true if every cell of a width by height maze has its own
+     * place in the array.
+     */
+    bool isOneToOne(CellLayout &layout, int width, int height)
+    {
+        std::vector<bool> used(layout.getSize(), false);
+        for (int i=0; i<height; i++) {
+            for (int j=0; j<width; j++) {
+                int n = layout.getIndex(i, j);
+                if ((n < 0) || (n >= layout.getSize()) || used[n]) {
+                    return false;
+                }
+                used[n] = true;
+            }
+        }
+        return true;
+    }
+
+public:
+    void testRowMajor()
+    {
+        CellLayout layout;
+        layout.resize(11, 7);
+        CPPUNIT_ASSERT(layout.getSize() == 77);
+        CPPUNIT_ASSERT(layout.getIndex(2, 3) == 25);
+        CPPUNIT_ASSERT(isOneToOne(layout, 11, 7));
+    }
+
+    void testTiled()
+    {
+        // the array is padded to whole tiles
+        CellLayout layout(CellLayout::TILED);
+        layout.resize(11, 7);
+        CPPUNIT_ASSERT(layout.getSize() == 2*1*64);
+        CPPUNIT_ASSERT(isOneToOne(layout, 11, 7));
+
+        // the cells of a tile are in Z-order
+        CPPUNIT_ASSERT(layout.getIndex(0, 0) == 0);
+        CPPUNIT_ASSERT(layout.getIndex(0, 1) == 1);
+        CPPUNIT_ASSERT(layout.getIndex(1, 0) == 2);
+        CPPUNIT_ASSERT(layout.getIndex(1, 1) == 3);
+        CPPUNIT_ASSERT(layout.getIndex(7, 7) == 63);
+        CPPUNIT_ASSERT(layout.getIndex(0, 8) == 64);
+
+        // the cells below each other are close together
+        layout.resize(1000, 1000);
+        CPPUNIT_ASSERT(isOneToOne(layout, 1000, 1000));
+        CPPUNIT_ASSERT(layout.getIndex(501, 500) - layout.getIndex(500, 500)
+                       < 64);
+    }
+
+    void testMaze()
+    {
+        // the maze is the same whichever way it is stored
+        Maze a, b;
+        b.setLayout(CellLayout::TILED);
+        a.load("test/testmaze.hag");
+        b.load("test/testmaze.hag");
+        CPPUNIT_ASSERT(b.getLayout() == CellLayout::TILED);
+        for (int i=0; i<a.getHeight(); i++) {
+            for (int j=0; j<a.getWidth(); j++) {
+                int bi, bj;
+                b.getCell(i, j)->getMazePosition(bi, bj);
+                CPPUNIT_ASSERT((bi == i) && (bj == j));
+                CPPUNIT_ASSERT(a.getCell(i, j)->getWall() ==
+                               b.getCell(i, j)->getWall());
+            }
+        }
+        CPPUNIT_ASSERT(b.getTerrain()->getChunkCount() == 4);
+    }
+};
+
+void register_celllayout()
+{
+    CPPUNIT_TEST_SUITE_REGISTRATION(testcelllayout);
+}
@@ -0,0 +1,105 @@
+/************************************************************************
+ *
+ * testcellset.cpp
+ * CellSet class tests
+ *
+ ************************************************************************/
+
+#include "cellset.h"
+#include "cell.h"
+
+#include "test.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * This test suite contains one test case:
+ *
+ * Code: CT-CSe
+ * Name: CellSet class unit tests
+ * Configuration: Unit testing context
+ * Tools: Cppunit
+ * Description: Class tests for the CellSet class
+ */
+class testcellset : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(testcellset);
+    CPPUNIT_TEST(testAddRemove);
+    CPPUNIT_TEST(testClear);
+    CPPUNIT_TEST(testCellState);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    CellSet selectable, highlighted;
+    Cell a, b, c;
+
+public:
+    void setUp()
+    {
+        a.setSelectionSets(&selectable, &highlighted);
+        b.setSelectionSets(&selectable, &highlighted);
+        c.setSelectionSets(&selectable, &highlighted);
+    }
+
+    void tearDown()
+    {
+        selectable.clear();
+        highlighted.clear();
+    }
+
+    void testAddRemove()
+    {
+        selectable.add(&a);
+        selectable.add(&b);
+        selectable.add(&a);
+        CPPUNIT_ASSERT(selectable.size() == 2);
+        CPPUNIT_ASSERT(selectable.contains(&a));
+        CPPUNIT_ASSERT(!selectable.contains(&c));
+
+        // the cells are kept in the order they were added
+        CPPUNIT_ASSERT(*selectable.begin() == &a);
+
+        selectable.remove(&a);
+        selectable.remove(&c);
+        CPPUNIT_ASSERT(selectable.size() == 1);
+        CPPUNIT_ASSERT(*selectable.begin() == &b);
+    }
+
+    void testClear()
+    {
+        selectable.add(&a);
+        selectable.add(&b);
+        CPPUNIT_ASSERT(a.getColor() == vector4(0, 0.5, 0));
+
+        // the cells are recoloured as they leave the set
+        selectable.clear();
+        CPPUNIT_ASSERT(selectable.size() == 0);
+        CPPUNIT_ASSERT(a.getColor() == vector4(1, 1, 1));
+        CPPUNIT_ASSERT(b.getColor() == vector4(1, 1, 1));
+    }
+
+    void testCellState()
+    {
+        // the cells ask the sets for their state
+        c.setSelectable(true);
+        c.setHighlighted(true);
+        CPPUNIT_ASSERT(selectable.contains(&c));
+        CPPUNIT_ASSERT(highlighted.contains(&c));
+        CPPUNIT_ASSERT(c.getColor() == vector4(0, 1, 0));
+        CPPUNIT_ASSERT(!a.isSelectable());
+
+        highlighted.clear();
+        CPPUNIT_ASSERT(!c.isHighlighted());
+        CPPUNIT_ASSERT(c.getColor() == vector4(0, 0.5, 0));
+
+        // a cell outside a maze is never selectable
+        Cell d;
+        d.setSelectable(true);
+        CPPUNIT_ASSERT(!d.isSelectable());
+    }
+};
+
+void register_cellset()
+{
+    CPPUNIT_TEST_SUITE_REGISTRATION(testcellset);
+}
@@ -0,0 +1,155 @@
+/************************************************************************
+ *
+ * testgamerules.cpp
+ * GameRules class tests
+ *
+ ************************************************************************/
+
+#include "gamerules.h"
+#include "item.h"
+
+#include "test.h"
+
+#include <algorithm>
+#include <fstream>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * This test suite contains one test case:
+ *
+ * Code: CT-GRu
+ * Name: GameRules class unit tests
+ * Configuration: Unit testing context
+ * Tools: Cppunit
+ * Description: Class tests for the GameRules class
+ */
+class testgamerules : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(testgamerules);
+    CPPUNIT_TEST(testLoad);
+    CPPUNIT_TEST(testMoves);
+    CPPUNIT_TEST(testWalk);
+    CPPUNIT_TEST(testJump);
+    CPPUNIT_TEST(testGrenade);
+    CPPUNIT_TEST(testPsychic);
+    CPPUNIT_TEST(testGameOver);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    GameState s;
+    std::vector<Move> moves;
+
+    bool hasMove(const Move &m)
+    {
+        return std::find(moves.begin(), moves.end(), m) != moves.end();
+    }
+
+public:
+    void setUp()
+    {
+        std::ifstream in("test/testmaze.hag");
+        Random random;
+        s.load(in, "test/testmaze.hag", random);
+    }
+
+    void testLoad()
+    {
+        CPPUNIT_ASSERT(s.getWidth() == 11);
+        CPPUNIT_ASSERT((s.hero.i == 1) && (s.hero.j == 1));
+        CPPUNIT_ASSERT((s.haggis.i == 1) && (s.haggis.j == 2));
+        CPPUNIT_ASSERT(s.hero.energy == MAX_STAT);
+        CPPUNIT_ASSERT(s.getItem(1, 5) == Item::GRENADE);
+        CPPUNIT_ASSERT(s.getWallHeight(0, 0) > 0);
+        CPPUNIT_ASSERT(s.getWallHeight(1, 6) == 0);
+        CPPUNIT_ASSERT(s.heroTurn);
+    }
+
+    void testMoves()
+    {
+        // the hero is walled in next to the haggis, but can jump out
+        GameRules::getMoves(s, moves);
+        CPPUNIT_ASSERT(moves[0] == Move(Move::WAIT));
+        CPPUNIT_ASSERT(!hasMove(Move(Move::WALK, 1, 2)));
+        CPPUNIT_ASSERT(hasMove(Move(Move::JUMP, 1, 3)));
+        CPPUNIT_ASSERT(hasMove(Move(Move::JUMP, 1, 4)));
+        CPPUNIT_ASSERT(!hasMove(Move(Move::JUMP, 1, 5)));
+        CPPUNIT_ASSERT(hasMove(Move(Move::GRENADE, 1, 2)));
+        CPPUNIT_ASSERT(hasMove(Move(Move::GRENADE, 0, 0)));
+
+        // nothing but waiting is left without energy or ammo
+        s.hero.energy = 0;
+        s.hero.ammo = 0;
+        GameRules::getMoves(s, moves);
+        CPPUNIT_ASSERT(moves.size() == 1);
+    }
+
+    void testWalk()
+    {
+        // the haggis walks onto the health item
+        s.heroTurn = false;
+        s.haggis.health = 10;
+        GameRules::getMoves(s, moves);
+        CPPUNIT_ASSERT(hasMove(Move(Move::WALK, 1, 3)));
+
+        GameRules::play(s, Move(Move::WALK, 1, 3));
+        CPPUNIT_ASSERT((s.haggis.i == 1) && (s.haggis.j == 3));
+        CPPUNIT_ASSERT(s.haggis.energy == MAX_STAT - 1);
+        CPPUNIT_ASSERT(s.haggis.health == 14);
+        CPPUNIT_ASSERT(s.getItem(1, 3) == -1);
+        CPPUNIT_ASSERT(s.heroTurn);
+    }
+
+    void testJump()
+    {
+        // the energy is taken before the energy item is picked up
+        GameRules::play(s, Move(Move::JUMP, 1, 4));
+        CPPUNIT_ASSERT((s.hero.i == 1) && (s.hero.j == 4));
+        CPPUNIT_ASSERT(s.hero.energy == MAX_STAT - 5 + 4);
+        CPPUNIT_ASSERT(!s.heroTurn);
+    }
+
+    void testGrenade()
+    {
+        GameRules::play(s, Move(Move::GRENADE, 1, 2));
+        CPPUNIT_ASSERT(s.hero.ammo == MAX_STAT - 1);
+        CPPUNIT_ASSERT(s.haggis.health == MAX_STAT - 4);
+
+        // a grenade that hits a wall makes it lower
+        int h = s.getWallHeight(0, 0);
+        GameRules::play(s, Move(Move::GRENADE, 0, 0));
+        CPPUNIT_ASSERT(s.getWallHeight(0, 0) == h - 1);
+        CPPUNIT_ASSERT(s.haggis.ammo == MAX_STAT - 1);
+    }
+
+    void testPsychic()
+    {
+        s.heroTurn = false;
+        GameRules::getMoves(s, moves);
+        CPPUNIT_ASSERT(hasMove(Move(Move::PSYCHIC, 1, 3)));
+
+        GameRules::play(s, Move(Move::PSYCHIC, 1, 3));
+        CPPUNIT_ASSERT(s.get(GameState::REVEALED, 1, 3));
+        CPPUNIT_ASSERT(s.haggis.energy == MAX_STAT);
+    }
+
+    void testGameOver()
+    {
+        CPPUNIT_ASSERT(!GameRules::isOver(s));
+
+        GameState t = s;
+        t.haggis.energy = 0;
+        CPPUNIT_ASSERT(GameRules::isOver(t));
+        CPPUNIT_ASSERT(GameRules::heroWon(t));
+
+        t = s;
+        t.hero.health = 0;
+        CPPUNIT_ASSERT(GameRules::isOver(t));
+        CPPUNIT_ASSERT(!GameRules::heroWon(t));
+    }
+};
+
+void register_gamerules()
+{
+    CPPUNIT_TEST_SUITE_REGISTRATION(testgamerules);
+}
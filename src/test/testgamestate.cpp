@@ -0,0 +1,207 @@
+/************************************************************************
+ *
+ * testgamestate.cpp
+ * GameState class tests
+ *
+ ************************************************************************/
+
+#include "gamestate.h"
+#include "statebridge.h"
+#include "maze.h"
+#include "hero.h"
+#include "haggis.h"
+#include "level.h"
+#include "item.h"
+#include "action.h"
+
+#include "test.h"
+
+#include <algorithm>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * A Level that uses a maze it does not own, with the hero and the haggis
+ * on their starting cells. Actions started by items are ignored.
+ */
+class StateTestLevel : public Level
+{
+public:
+    StateTestLevel(Maze *m)
+    {
+        maze = m;
+        hero = new Hero();
+        haggis = new Haggis(m, hero);
+    }
+
+    ~StateTestLevel()
+    {
+        hero->setCell(NULL, true);
+        haggis->setCell(NULL, true);
+        delete hero;
+        delete haggis;
+    }
+
+    virtual void notifyGeneralAction(Action *a)
+    {
+        delete a;
+    }
+};
+
+/**
+ * This test suite contains one test case:
+ *
+ * Code: CT-GSt
+ * Name: GameState class unit tests
+ * Configuration: Unit testing context
+ * Tools: Cppunit
+ * Description: Class tests for the GameState class
+ */
+class testgamestate : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(testgamestate);
+    CPPUNIT_TEST(testExtract);
+    CPPUNIT_TEST(testApply);
+    CPPUNIT_TEST(testCopy);
+    CPPUNIT_TEST(testSwap);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    Maze m;
+    StateTestLevel *level;
+
+public:
+    void setUp()
+    {
+        m.setLevel(level = new StateTestLevel(&m));
+        m.load("test/testmaze.hag");
+        level->getHero()->setCell(m.getHeroCell(), true);
+        level->getHaggis()->setCell(m.getHaggisCell(), true);
+        level->setCurrentTurn(Level::HERO_TURN);
+    }
+
+    void tearDown()
+    {
+        delete level;
+    }
+
+    void testExtract()
+    {
+        GameState s;
+        StateBridge::extract(s, level);
+        CPPUNIT_ASSERT(s.getWidth() == 11);
+        CPPUNIT_ASSERT(s.getHeight() == 11);
+
+        for (int i=0; i<11; i++) {
+            for (int j=0; j<11; j++) {
+                Cell *c = m.getCell(i, j);
+                CPPUNIT_ASSERT(s.get(GameState::VISIBLE, i, j) ==
+                               c->isVisible());
+                CPPUNIT_ASSERT(s.getWallHeight(i, j) == c->getWallHeight());
+            }
+        }
+
+        CPPUNIT_ASSERT(s.getItem(1, 3) == Item::HEALTH);
+        CPPUNIT_ASSERT(s.getItem(1, 4) == Item::ENERGY);
+        CPPUNIT_ASSERT(s.getItem(1, 5) == Item::GRENADE);
+        CPPUNIT_ASSERT(s.getItem(1, 6) == -1);
+
+        CPPUNIT_ASSERT((s.hero.i == 1) && (s.hero.j == 1));
+        CPPUNIT_ASSERT((s.haggis.i == 1) && (s.haggis.j == 2));
+        CPPUNIT_ASSERT(s.hero.health == level->getHero()->getHealth());
+        CPPUNIT_ASSERT(s.heroTurn);
+    }
+
+    void testApply()
+    {
+        GameState s;
+        StateBridge::extract(s, level);
+
+        // play a few moves by hand
+        Hero *h = level->getHero();
+        m.getCell(0, 0)->hitWall();
+        h->setCell(m.getCell(1, 3), true);
+        h->setHealth(3);
+        level->setCurrentTurn(Level::HAGGIS_TURN);
+
+        GameState t;
+        StateBridge::extract(t, level);
+        CPPUNIT_ASSERT(t != s);
+        CPPUNIT_ASSERT(t.hash() != s.hash());
+        CPPUNIT_ASSERT(t.getItem(1, 3) == -1);
+        CPPUNIT_ASSERT(!t.heroTurn);
+
+        // putting the first state back undoes them
+        StateBridge::apply(s, level);
+        CPPUNIT_ASSERT(h->getCell() == m.getCell(1, 1));
+        CPPUNIT_ASSERT(m.getCell(1, 1)->hasPlayer());
+        CPPUNIT_ASSERT(!m.getCell(1, 3)->hasPlayer());
+        CPPUNIT_ASSERT(h->getHealth() == s.hero.health);
+        CPPUNIT_ASSERT(level->getCurrentTurn() == Level::HERO_TURN);
+        CPPUNIT_ASSERT(level->getNextTurn() == Level::HERO_TURN);
+
+        GameState u;
+        StateBridge::extract(u, level);
+        CPPUNIT_ASSERT(u == s);
+        CPPUNIT_ASSERT(u.hash() == s.hash());
+
+        // and the second state can be put back too
+        StateBridge::apply(t, level);
+        StateBridge::extract(u, level);
+        CPPUNIT_ASSERT(u == t);
+    }
+
+    void testCopy()
+    {
+        GameState s;
+        StateBridge::extract(s, level);
+
+        GameState c = s;
+        CPPUNIT_ASSERT(c == s);
+        CPPUNIT_ASSERT(c.hash() == s.hash());
+
+        c.setWallHeight(1, 6, 2);
+        CPPUNIT_ASSERT(c.getWallHeight(1, 6) == 2);
+        CPPUNIT_ASSERT(c != s);
+        CPPUNIT_ASSERT(s.getWallHeight(1, 6) == 0);
+
+        // the planes can be used with the bitboard operations
+        BitPlane visible;
+        s.getPlane(GameState::VISIBLE, visible);
+        CPPUNIT_ASSERT(visible.getWidth() == 11);
+        CPPUNIT_ASSERT(visible.count() == 121);
+
+        // and the walkable cells are the visible ones that are not walls,
+        // of which the enterable ones have no player on them
+        BitPlane walkable;
+        s.getWalkable(walkable);
+        for (int i=0; i<s.getHeight(); i++) {
+            for (int j=0; j<s.getWidth(); j++) {
+                bool walk = s.get(GameState::VISIBLE, i, j) &&
+                    !s.getWallHeight(i, j);
+                CPPUNIT_ASSERT(walkable.get(i, j) == walk);
+                CPPUNIT_ASSERT((((s.getEnterable(i) >> j) & 1) != 0) ==
+                               (walk && !s.hasPlayer(i, j)));
+            }
+        }
+    }
+
+    void testSwap()
+    {
+        // the players swap cells, and both cells still have a player
+        GameState s;
+        StateBridge::extract(s, level);
+        std::swap(s.hero.j, s.haggis.j);
+        StateBridge::apply(s, level);
+
+        CPPUNIT_ASSERT(level->getHero()->getCell() == m.getCell(1, 2));
+        CPPUNIT_ASSERT(level->getHaggis()->getCell() == m.getCell(1, 1));
+        CPPUNIT_ASSERT(m.getCell(1, 1)->hasPlayer());
+        CPPUNIT_ASSERT(m.getCell(1, 2)->hasPlayer());
+    }
+};
+
+void register_gamestate()
+{
+    CPPUNIT_TEST_SUITE_REGISTRATION(testgamestate);
+}
@@ -0,0 +1,139 @@
+/************************************************************************
+ *
+ * testgrid.cpp
+ * Grid template tests
+ *
+ ************************************************************************/
+
+#include "grid.h"
+#include "hexcoord.h"
+
+#include "test.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * Lets the search through every cell except those in column 2.
+ */
+struct NotColumn2
+{
+    bool operator()(int, int j) const
+    {
+        return j != 2;
+    }
+};
+
+/**
+ * Lets the search through every cell.
+ */
+struct Open
+{
+    bool operator()(int, int) const
+    {
+        return true;
+    }
+};
+
+/**
+ * This test suite contains one test case:
+ *
+ * Code: CT-Grd
+ * Name: Grid template unit tests
+ * Configuration: Unit testing context
+ * Tools: Cppunit
+ * Description: Class tests for the Grid template
+ */
+class testgrid : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(testgrid);
+    CPPUNIT_TEST(testHexNeighbours);
+    CPPUNIT_TEST(testSquareNeighbours);
+    CPPUNIT_TEST(testEdges);
+    CPPUNIT_TEST(testSearch);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void testHexNeighbours()
+    {
+        // every neighbour is one step away
+        MazeGrid g(10, 10);
+        for (int i=4; i<6; i++) {
+            HexCoord c = HexCoord::fromMaze(i, 4);
+            for (int k=0; k<MazeGrid::getNeighbourCount(); k++) {
+                int ni, nj;
+                CPPUNIT_ASSERT(g.getNeighbour(i, 4, k, ni, nj));
+                CPPUNIT_ASSERT(c.distance(HexCoord::fromMaze(ni, nj)) == 1);
+            }
+        }
+    }
+
+    void testSquareNeighbours()
+    {
+        Grid<Square4Topology> g4(10, 10);
+        Grid<Square8Topology> g8(10, 10);
+        CPPUNIT_ASSERT(g4.getNeighbourCount() == 4);
+        CPPUNIT_ASSERT(g8.getNeighbourCount() == 8);
+
+        int ni, nj, diagonal = 0;
+        for (int k=0; k<8; k++) {
+            g8.getNeighbour(5, 5, k, ni, nj);
+            if ((ni != 5) && (nj != 5)) {
+                diagonal++;
+            }
+        }
+        CPPUNIT_ASSERT(diagonal == 4);
+
+        for (int k=0; k<4; k++) {
+            g4.getNeighbour(5, 5, k, ni, nj);
+            CPPUNIT_ASSERT((ni == 5) || (nj == 5));
+        }
+    }
+
+    void testEdges()
+    {
+        // a corner cell has fewer neighbours in the grid
+        Grid<Square8Topology> g(10, 10);
+        int count = 0;
+        for (int k=0; k<8; k++) {
+            int ni, nj;
+            if (g.getNeighbour(0, 0, k, ni, nj)) {
+                count++;
+            }
+        }
+        CPPUNIT_ASSERT(count == 3);
+    }
+
+    void testSearch()
+    {
+        std::vector<int> order, parents;
+
+        // an open 5x5 square grid is searched in order of distance
+        Grid<Square4Topology> g(5, 5);
+        g.search(0, 0, Open(), order, parents);
+        CPPUNIT_ASSERT(order.size() == 24);
+        CPPUNIT_ASSERT(order.back() == g.getIndex(4, 4));
+        CPPUNIT_ASSERT(parents[g.getIndex(0, 0)] == g.getIndex(0, 0));
+
+        // the path back to the start is eight steps
+        int steps = 0;
+        for (int n=g.getIndex(4, 4); n != g.getIndex(0, 0); n = parents[n]) {
+            steps++;
+        }
+        CPPUNIT_ASSERT(steps == 8);
+
+        // a wall down column 2 cuts the grid in half
+        g.search(0, 0, NotColumn2(), order, parents);
+        CPPUNIT_ASSERT(order.size() == 9);
+        CPPUNIT_ASSERT(parents[g.getIndex(0, 3)] == -1);
+
+        // the same search works on the maze layout
+        MazeGrid h(5, 5);
+        h.search(0, 0, Open(), order, parents);
+        CPPUNIT_ASSERT(order.size() == 24);
+    }
+};
+
+void register_grid()
+{
+    CPPUNIT_TEST_SUITE_REGISTRATION(testgrid);
+}
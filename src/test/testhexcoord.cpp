@@ -0,0 +1,111 @@
+/************************************************************************
+ *
+ * testhexcoord.cpp
+ * HexCoord class tests
+ *
+ ************************************************************************/
+
+#include "hexcoord.h"
+#include "maze.h"
+
+#include "test.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <set>
+#include <utility>
+
+/**
+ * This test suite contains one test case:
+ *
+ * Code: CT-Hex
+ * Name: HexCoord class unit tests
+ * Configuration: Unit testing context
+ * Tools: Cppunit
+ * Description: Class tests for the HexCoord class
+ */
+class testhexcoord : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(testhexcoord);
+    CPPUNIT_TEST(testConversion);
+    CPPUNIT_TEST(testDistance);
+    CPPUNIT_TEST(testOffsets);
+    CPPUNIT_TEST(testNeighbours);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void testConversion()
+    {
+        for (int i=-5; i<6; i++) {
+            for (int j=-5; j<6; j++) {
+                int ti, tj;
+                HexCoord::fromMaze(i, j).toMaze(ti, tj);
+                CPPUNIT_ASSERT((ti == i) && (tj == j));
+            }
+        }
+    }
+
+    void testDistance()
+    {
+        HexCoord a = HexCoord::fromMaze(4, 4);
+        CPPUNIT_ASSERT(a.distance(a) == 0);
+        CPPUNIT_ASSERT(a.distance(HexCoord::fromMaze(4, 7)) == 3);
+        CPPUNIT_ASSERT(a.distance(HexCoord::fromMaze(7, 4)) == 3);
+        CPPUNIT_ASSERT(HexCoord::fromMaze(7, 4).distance(a) == 3);
+
+        // odd rows are shifted towards higher columns
+        CPPUNIT_ASSERT(a.distance(HexCoord::fromMaze(5, 4)) == 1);
+        CPPUNIT_ASSERT(a.distance(HexCoord::fromMaze(5, 3)) == 1);
+        CPPUNIT_ASSERT(a.distance(HexCoord::fromMaze(5, 5)) == 2);
+    }
+
+    void testOffsets()
+    {
+        CPPUNIT_ASSERT(HexCoord::getDiscSize(0) == 1);
+        CPPUNIT_ASSERT(HexCoord::getDiscSize(3) == 37);
+
+        // every offset is listed once, in order of distance
+        for (int row=4; row<6; row++) {
+            const GridOffset *offsets = HexCoord::getOffsets(row);
+            HexCoord centre = HexCoord::fromMaze(row, 4);
+            std::set<std::pair<int, int> > seen;
+            int ring = 0;
+            for (int k=0; k<HexCoord::getDiscSize(HEX_MAX_RADIUS); k++) {
+                if (k == HexCoord::getDiscSize(ring)) {
+                    ring++;
+                }
+                int i = row + offsets[k].di;
+                int j = 4 + offsets[k].dj;
+                CPPUNIT_ASSERT(centre.distance(HexCoord::fromMaze(i, j)) ==
+                               ring);
+                seen.insert(std::make_pair(i, j));
+            }
+            CPPUNIT_ASSERT(seen.size() == 61);
+        }
+    }
+
+    void testNeighbours()
+    {
+        Maze m;
+        m.load("test/testmaze.hag");
+
+        // the offsets one step away are the neighbours the maze found
+        for (int i=1; i<3; i++) {
+            Cell *c = m.getCell(i, 5);
+            const GridOffset *offsets = HexCoord::getOffsets(i);
+            for (int k=1; k<HexCoord::getDiscSize(1); k++) {
+                Cell *n = m.getCell(i + offsets[k].di, 5 + offsets[k].dj);
+                bool found = false;
+                for (int l=0; l<MazeGrid::getNeighbourCount(); l++) {
+                    found = found || (m.getNeighbour(c, l) == n);
+                }
+                CPPUNIT_ASSERT(found);
+            }
+        }
+    }
+};
+
+void register_hexcoord()
+{
+    CPPUNIT_TEST_SUITE_REGISTRATION(testhexcoord);
+}
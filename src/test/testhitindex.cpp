@@ -0,0 +1,104 @@
+/************************************************************************
+ *
+ * testhitindex.cpp
+ * HitIndex class tests
+ *
+ ************************************************************************/
+
+#include "hitindex.h"
+#include "window.h"
+
+#include "test.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * This test suite contains one test case:
+ *
+ * Code: CT-Hit
+ * Name: HitIndex class unit tests
+ * Configuration: Unit testing context
+ * Tools: Cppunit
+ * Description: Class tests for the HitIndex class
+ */
+class testhitindex : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(testhitindex);
+    CPPUNIT_TEST(testEmpty);
+    CPPUNIT_TEST(testFind);
+    CPPUNIT_TEST(testOrder);
+    CPPUNIT_TEST(testClear);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    HitIndex index;
+    Window a, b, c;
+
+public:
+    void setUp()
+    {
+        index.clear(vector4(10, 10));
+    }
+
+    void testEmpty()
+    {
+        HitIndex empty;
+        std::vector<HitEntry> hits;
+        empty.find(vector4(1, 1), hits);
+        CPPUNIT_ASSERT(hits.empty());
+    }
+
+    void testFind()
+    {
+        index.add(&a, vector4(1, 1), vector4(1, 1), vector4(3, 3));
+        index.add(&b, vector4(5, 5), vector4(5, 5), vector4(9, 6));
+        CPPUNIT_ASSERT(index.getEntryCount() == 2);
+
+        std::vector<HitEntry> hits;
+        index.find(vector4(2, 2), hits);
+        CPPUNIT_ASSERT(hits.size() == 1);
+        CPPUNIT_ASSERT(hits[0].win == &a);
+        CPPUNIT_ASSERT(hits[0].offset == vector4(1, 1));
+
+        // the far edges are outside
+        hits.clear();
+        index.find(vector4(3, 2), hits);
+        CPPUNIT_ASSERT(hits.empty());
+
+        hits.clear();
+        index.find(vector4(8.5, 5.5), hits);
+        CPPUNIT_ASSERT(hits.size() == 1);
+        CPPUNIT_ASSERT(hits[0].win == &b);
+    }
+
+    void testOrder()
+    {
+        // overlapping windows are found in the order they were added
+        index.add(&c, vector4(4, 4), vector4(4, 4), vector4(5, 5));
+        index.add(&b, vector4(2, 2), vector4(2, 2), vector4(6, 6));
+        index.add(&a, vector4(0, 0), vector4(0, 0), vector4(10, 10));
+
+        std::vector<HitEntry> hits;
+        index.find(vector4(4.5, 4.5), hits);
+        CPPUNIT_ASSERT(hits.size() == 3);
+        CPPUNIT_ASSERT(hits[0].win == &c);
+        CPPUNIT_ASSERT(hits[1].win == &b);
+        CPPUNIT_ASSERT(hits[2].win == &a);
+    }
+
+    void testClear()
+    {
+        index.add(&a, vector4(0, 0), vector4(0, 0), vector4(10, 10));
+        index.clear(vector4(10, 10));
+        CPPUNIT_ASSERT(index.getEntryCount() == 0);
+
+        std::vector<HitEntry> hits;
+        index.find(vector4(5, 5), hits);
+        CPPUNIT_ASSERT(hits.empty());
+    }
+};
+
+void register_hitindex()
+{
+    CPPUNIT_TEST_SUITE_REGISTRATION(testhitindex);
+}
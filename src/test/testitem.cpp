@@ -0,0 +1,158 @@
+/************************************************************************
+ *
+ * testitem.cpp
+ * Item class tests
+ *
+ ************************************************************************/
+
+#include "item.h"
+#include "maze.h"
+#include "hero.h"
+#include "haggis.h"
+#include "level.h"
+#include "action.h"
+
+#include "test.h"
+
+#include <iostream>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * An extended version of Level for observing the general actions generated
+ * by items. When it receives an Action, it stores it in the lastact member
+ * and increments nacts.
+ */
+class ItemTestLevel : public Level
+{
+public:
+    Action *lastact;
+    int nacts;
+
+    ItemTestLevel(Maze *m)
+    {
+        lastact = NULL;
+        nacts = 0;
+        hero = new Hero();
+        haggis = new Haggis(m, hero);
+    }
+
+    ~ItemTestLevel()
+    {
+        if (lastact) {
+            delete lastact;
+        }
+        delete hero;
+        delete haggis;
+    }
+
+    virtual void notifyGeneralAction(Action *a)
+    {
+        if (lastact) {
+            delete lastact;
+        }
+
+        lastact = a;
+        nacts++;
+    }
+};
+
+/**
+ * This test suite contains one test case:
+ *
+ * Code: CT-Ite
+ * Name: Item class unit tests
+ * Configuration: Unit testing context
+ * Tools: Cppunit
+ * Description: Class tests for the Item class and cell enter notifications
+ */
+class testitem : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(testitem);
+    CPPUNIT_TEST(testHeroPickup);
+    CPPUNIT_TEST(testHaggisPickup);
+    CPPUNIT_TEST(testOtherEntity);
+    CPPUNIT_TEST(testOnlyOnce);
+    CPPUNIT_TEST(testNoRender);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    Maze m;
+    ItemTestLevel *level;
+
+public:
+
+    void setUp()
+    {
+        m.setLevel(level = new ItemTestLevel(&m));
+        m.load("test/testmaze.hag");
+    }
+
+    void tearDown()
+    {
+        // take the players off the maze before the level deletes them
+        level->getHero()->setCell(NULL);
+        level->getHaggis()->setCell(NULL);
+        delete level;
+    }
+
+    /**
+     * Test that the hero stepping onto an item's cell activates it.
+     */
+    void testHeroPickup()
+    {
+        level->getHero()->setCell(m.getCell(1, 3), true);
+        CPPUNIT_ASSERT(level->nacts == 1);
+    }
+
+    /**
+     * Test that the haggis stepping onto an item's cell activates it.
+     */
+    void testHaggisPickup()
+    {
+        level->getHaggis()->setCell(m.getCell(1, 4), true);
+        CPPUNIT_ASSERT(level->nacts == 1);
+    }
+
+    /**
+     * Test that entities that are not players don't activate items.
+     */
+    void testOtherEntity()
+    {
+        Entity e;
+        e.setCell(m.getCell(1, 3));
+        e.setCell(NULL);
+        CPPUNIT_ASSERT(level->nacts == 0);
+    }
+
+    /**
+     * Test that an item is only activated once.
+     */
+    void testOnlyOnce()
+    {
+        Hero *h = level->getHero();
+        h->setCell(m.getCell(1, 5), true);
+        h->setCell(m.getCell(1, 6), true);
+        h->setCell(m.getCell(1, 5), true);
+        CPPUNIT_ASSERT(level->nacts == 1);
+    }
+
+    /**
+     * Test that items are activated without the maze being rendered, and
+     * that moving between empty cells does nothing.
+     */
+    void testNoRender()
+    {
+        Hero *h = level->getHero();
+        h->setCell(m.getCell(1, 6), true);
+        h->setCell(m.getCell(1, 7), true);
+        CPPUNIT_ASSERT(level->nacts == 0);
+        h->setCell(m.getCell(1, 3), true);
+        CPPUNIT_ASSERT(level->nacts == 1);
+    }
+};
+
+void register_item()
+{
+    CPPUNIT_TEST_SUITE_REGISTRATION(testitem);
+}
@@ -0,0 +1,135 @@
+/************************************************************************
+ *
+ * testlevelofdetail.cpp
+ * LevelOfDetail class tests
+ *
+ ************************************************************************/
+
+#include "levelofdetail.h"
+#include "terrain.h"
+#include "maze.h"
+
+#include "test.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * This test suite contains one test case:
+ *
+ * Code: CT-LOD
+ * Name: LevelOfDetail class unit tests
+ * Configuration: Unit testing context
+ * Tools: Cppunit
+ * Description: Class tests for the LevelOfDetail class
+ */
+class testlevelofdetail : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(testlevelofdetail);
+    CPPUNIT_TEST(testTerrainLevel);
+    CPPUNIT_TEST(testEntityLevel);
+    CPPUNIT_TEST(testFrames);
+    CPPUNIT_TEST(testTerrain);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    LevelOfDetail lod;
+
+public:
+    void tearDown()
+    {
+        // the shared settings are used by the other tests
+        LevelOfDetail &shared = LevelOfDetail::getInstance();
+        shared = LevelOfDetail();
+    }
+
+    void testTerrainLevel()
+    {
+        lod.setOutlineDistance(10);
+        lod.setFlatDistance(20);
+        vector4 min(0, 0, 0), max(4, 1, 4);
+
+        // the distance is measured to the nearest point of the box
+        lod.setEye(vector4(2, 5, 2));
+        CPPUNIT_ASSERT(lod.getTerrainLevel(min, max) == LOD_TERRAIN_FULL);
+        lod.setEye(vector4(2, 5, 17));
+        CPPUNIT_ASSERT(lod.getTerrainLevel(min, max) ==
+                       LOD_TERRAIN_NO_OUTLINES);
+        lod.setEye(vector4(-25, 0, 2));
+        CPPUNIT_ASSERT(lod.getTerrainLevel(min, max) == LOD_TERRAIN_FLAT);
+    }
+
+    void testEntityLevel()
+    {
+        lod.setImpostorDistance(10);
+        lod.setEye(vector4(0, 0, 0));
+        CPPUNIT_ASSERT(lod.getEntityLevel(vector4(6, 0, 6)) ==
+                       LOD_ENTITY_MESH);
+        CPPUNIT_ASSERT(lod.getEntityLevel(vector4(6, 0, 9)) ==
+                       LOD_ENTITY_IMPOSTOR);
+    }
+
+    void testFrames()
+    {
+        lod.addTriangles(LOD_TERRAIN_FULL, 10);
+        lod.addTriangles(LOD_TERRAIN_FULL, 5);
+        lod.addTriangles(LOD_ENTITY_IMPOSTOR, 2);
+        CPPUNIT_ASSERT(lod.getFrameTriangles(LOD_TERRAIN_FULL) == 15);
+
+        lod.startFrame();
+        CPPUNIT_ASSERT(lod.getLastFrameTriangles(LOD_TERRAIN_FULL) == 15);
+        CPPUNIT_ASSERT(lod.getLastFrameTriangles(LOD_ENTITY_IMPOSTOR) == 2);
+        CPPUNIT_ASSERT(lod.getFrameTriangles(LOD_TERRAIN_FULL) == 0);
+    }
+
+    void testTerrain()
+    {
+        Maze m;
+        m.load("test/testmaze.hag");
+        Terrain *t = m.getTerrain();
+        LevelOfDetail &shared = LevelOfDetail::getInstance();
+
+        // near the maze everything is drawn
+        shared.setEye(vector4(0, 20, 0));
+        shared.startFrame();
+        t->render();
+        CPPUNIT_ASSERT(t->getDrawCalls() == 8);
+        CPPUNIT_ASSERT(shared.getFrameTriangles(LOD_TERRAIN_FULL) ==
+                       t->getTriangleCount());
+
+        // further away, the outlines are left out
+        shared.setEye(vector4(0, shared.getOutlineDistance() + 20, 0));
+        shared.startFrame();
+        t->render();
+        CPPUNIT_ASSERT(t->getDrawCalls() == 4);
+        CPPUNIT_ASSERT(shared.getFrameTriangles(LOD_TERRAIN_NO_OUTLINES) ==
+                       t->getTriangleCount());
+
+        // far away, only the four triangles of each top are drawn
+        shared.setEye(vector4(0, shared.getFlatDistance() + 20, 0));
+        shared.startFrame();
+        t->render();
+        CPPUNIT_ASSERT(t->getDrawCalls() == 4);
+        CPPUNIT_ASSERT(shared.getFrameTriangles(LOD_TERRAIN_FLAT) ==
+                       countCells(m) * 4);
+    }
+
+private:
+    /**
+     * Returns the number of visible cells in the 11x11 test maze.
+     */
+    int countCells(Maze &m)
+    {
+        int n = 0;
+        for (int i=0; i<11; i++) {
+            for (int j=0; j<11; j++) {
+                n += m.getCell(i, j)->isVisible() ? 1 : 0;
+            }
+        }
+        return n;
+    }
+};
+
+void register_levelofdetail()
+{
+    CPPUNIT_TEST_SUITE_REGISTRATION(testlevelofdetail);
+}
@@ -6,9 +6,11 @@
  ************************************************************************/
 
 #include "maze.h"
+#include "gamestate.h"
 #include "test.h"
 
 #include <iostream>
+#include <fstream>
 
 #include <cppunit/extensions/HelperMacros.h>
 
@@ -27,6 +29,8 @@ class testmaze : public CppUnit::TestFixture
     CPPUNIT_TEST_SUITE(testmaze);
     CPPUNIT_TEST(testConstructor);
     CPPUNIT_TEST(testLoadMaze);
+    CPPUNIT_TEST(testPickCell);
+    CPPUNIT_TEST(testSeed);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -107,15 +111,79 @@ public:
 	{
 	    for(int j = 0; j < 11; j++)
 	    {
-		for(unsigned k = 0; k < m.getCell(i, j)->neighbours.size(); k++)
+		for(int k = 0; k < MazeGrid::getNeighbourCount(); k++)
 		{
-		    vector4 diff = m.getCell(i, j)->neighbours[k]->getPosition() - m.getCell(i,j)->getPosition();
+		    Cell *n = m.getNeighbour(m.getCell(i, j), k);
+		    if (!n)
+			continue;
+		    vector4 diff = n->getPosition() - m.getCell(i,j)->getPosition();
 		    diff.y = 0;
 		    CPPUNIT_ASSERT(diff.length() < 1.8);
 		}
 	    }
 	}
     }
+
+    /**
+     * Test that the same seed gives the same random walls, whether the maze
+     * or the game state is loaded.
+     */
+    void testSeed()
+    {
+	Maze a, b;
+	a.setSeed(5);
+	b.setSeed(5);
+	a.load("test/testmaze.hag");
+	b.load("test/testmaze.hag");
+
+	//the state loaded from the file with the same seed matches too
+	GameState s;
+	Random random(5);
+	std::ifstream in("test/testmaze.hag");
+	s.load(in, "test/testmaze.hag", random);
+
+	//the same seed gives the same walls
+	for(int i = 0; i < 11; i++)
+	{
+	    for(int j = 0; j < 11; j++)
+	    {
+		int h = a.getCell(i, j)->getWallHeight();
+		CPPUNIT_ASSERT(b.getCell(i, j)->getWallHeight() == h);
+		CPPUNIT_ASSERT(s.getWallHeight(i, j) == h);
+	    }
+	}
+    }
+
+    /**
+     * Test that only selectable cells are picked.
+     */
+    void testPickCell()
+    {
+	Maze m;
+	m.load("test/testmaze.hag");
+
+	//a ray straight down onto each cell
+	Cell *a = m.getCell(1, 6);
+	Cell *b = m.getCell(2, 6);
+	vector4 down(0, -1, 0);
+	vector4 above = a->getPosition() + vector4(0, 50, 0);
+
+	CPPUNIT_ASSERT(m.pickCell(down, above) == NULL);
+
+	m.setSelectable(a);
+	m.setSelectable(b);
+	CPPUNIT_ASSERT(a->isSelectable());
+	CPPUNIT_ASSERT(m.pickCell(down, above) == a);
+	above = b->getPosition() + vector4(0, 50, 0);
+	CPPUNIT_ASSERT(m.pickCell(down, above) == b);
+
+	//the selectable cells are forgotten when selection is disabled
+	m.setCellSelectionEnable(true);
+	m.setCellSelectionEnable(false);
+	CPPUNIT_ASSERT(m.pickCell(down, above) == NULL);
+	CPPUNIT_ASSERT(!a->isSelectable());
+	CPPUNIT_ASSERT(a->getColor() == vector4(1, 1, 1));
+    }
 };
 
 void register_maze()
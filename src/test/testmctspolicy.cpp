@@ -0,0 +1,139 @@
+/************************************************************************
+ *
+ * testmctspolicy.cpp
+ * MctsPolicy class tests
+ *
+ ************************************************************************/
+
+#include "mctspolicy.h"
+#include "mctstree.h"
+#include "grenadeaction.h"
+
+#include "test.h"
+
+#include <fstream>
+#include <algorithm>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * This test suite contains one test case:
+ *
+ * Code: CT-Mcts
+ * Name: MctsPolicy class unit tests
+ * Configuration: Unit testing context
+ * Tools: Cppunit
+ * Description: Class tests for the MctsPolicy class and its MctsTree
+ */
+class testmctspolicy : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(testmctspolicy);
+    CPPUNIT_TEST(testEvaluate);
+    CPPUNIT_TEST(testTree);
+    CPPUNIT_TEST(testLegal);
+    CPPUNIT_TEST(testKill);
+    CPPUNIT_TEST(testThreads);
+    CPPUNIT_TEST(testSeed);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    GameState s;
+    Random random;
+
+public:
+    void setUp()
+    {
+        std::ifstream in("test/testmaze.hag");
+        s.load(in, "test/testmaze.hag", random);
+        s.heroTurn = false;
+    }
+
+    void testEvaluate()
+    {
+        // a game that is not over is scored by health and energy
+        s.hero.health = s.haggis.health;
+        s.hero.energy = s.haggis.energy;
+        CPPUNIT_ASSERT(MctsTree::evaluate(s) == 0.5);
+        s.hero.health--;
+        CPPUNIT_ASSERT(MctsTree::evaluate(s) > 0.5);
+        CPPUNIT_ASSERT(MctsTree::evaluate(s) <= 0.75);
+
+        // a game that is over is won or lost
+        s.hero.health = 0;
+        CPPUNIT_ASSERT(MctsTree::evaluate(s) == 1);
+        s.haggis.energy = 0;
+        CPPUNIT_ASSERT(MctsTree::evaluate(s) == 0);
+    }
+
+    void testTree()
+    {
+        MctsTree tree(s, 3);
+        std::vector<Move> moves;
+        GameRules::getMoves(s, moves);
+        CPPUNIT_ASSERT(tree.getRootMoves().size() == moves.size());
+
+        // every iteration tries one first move, and adds at most one
+        // position, fewer when it reaches one it has seen before
+        tree.search(0, 300);
+        CPPUNIT_ASSERT(tree.getIterations() == 300);
+        int visits = 0;
+        for (unsigned int k=0; k<moves.size(); k++) {
+            CPPUNIT_ASSERT(tree.getRootVisits(k) > 0);
+            visits += tree.getRootVisits(k);
+        }
+        CPPUNIT_ASSERT(visits == 300);
+        CPPUNIT_ASSERT(tree.getNodeCount() > 1);
+        CPPUNIT_ASSERT(tree.getNodeCount() <= 301);
+    }
+
+    void testLegal()
+    {
+        MctsPolicy policy(1, 0, 200);
+        std::vector<Move> moves;
+        GameRules::getMoves(s, moves);
+        Move m = policy.choose(s, random);
+        CPPUNIT_ASSERT(std::find(moves.begin(), moves.end(), m) != moves.end());
+        CPPUNIT_ASSERT(policy.getIterations() == 200);
+
+        // without energy the haggis can only wait, so there is no search
+        s.haggis.energy = 0;
+        s.haggis.ammo = 0;
+        CPPUNIT_ASSERT(policy.choose(s, random).type == Move::WAIT);
+    }
+
+    void testKill()
+    {
+        // the hero is next to the haggis, and one grenade would kill it
+        s.hero.health = GRENADE_DAMAGE;
+        MctsPolicy policy(1, 0, 500);
+        CPPUNIT_ASSERT(policy.choose(s, random) == Move(Move::GRENADE, 1, 1));
+    }
+
+    void testThreads()
+    {
+        // each thread runs its own search
+        MctsPolicy policy(3, 0, 100);
+        policy.choose(s, random);
+        CPPUNIT_ASSERT(policy.getIterations() == 300);
+
+        // a time budget ends the search
+        MctsPolicy timed(2, 50);
+        timed.choose(s, random);
+        CPPUNIT_ASSERT(timed.getIterations() > 0);
+    }
+
+    void testSeed()
+    {
+        // with an iteration limit, the same seed gives the same move
+        MctsPolicy policy(2, 0, 200);
+        for (int k=0; k<5; k++) {
+            Random a(k), b(k);
+            CPPUNIT_ASSERT(policy.choose(s, a) == policy.choose(s, b));
+        }
+    }
+};
+
+void register_mctspolicy()
+{
+    CPPUNIT_TEST_SUITE_REGISTRATION(testmctspolicy);
+}
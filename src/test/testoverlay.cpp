@@ -98,6 +98,21 @@ public:
     {
 	handleCellSelection();
     }
+
+    void callUpdate()
+    {
+        update();
+    }
+
+    Button *getActionButton(int n)
+    {
+        return (Button*) getChildren()[n];
+    }
+
+    bool callRendersChildren()
+    {
+        return rendersChildren();
+    }
 };
 
 /**
@@ -120,6 +135,8 @@ class testoverlay : public CppUnit::TestFixture
     CPPUNIT_TEST_SUITE(testoverlay);
     CPPUNIT_TEST(testConstructor);
     CPPUNIT_TEST(testActions);
+    CPPUNIT_TEST(testStatEvents);
+    CPPUNIT_TEST(testRendersChildren);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -174,6 +191,43 @@ public:
 	}
     }
 
+    /**
+     * This tests that the action buttons follow the hero's attributes when
+     * the overlay listens to the hero.
+     */
+    void testStatEvents()
+    {
+        OverlayTest ove;
+        LevelTest level;
+
+        ove.setLevel(&level);
+        level.getHero()->addListener(&ove);
+        level.callSetTurn(Level::HERO_TURN);
+
+        ove.callUpdate();
+        CPPUNIT_ASSERT(ove.getActionButton(3)->getEnabled());
+
+        level.getHero()->setAmmo(0);
+        ove.callUpdate();
+        CPPUNIT_ASSERT(!ove.getActionButton(3)->getEnabled());
+
+        level.getHero()->setAmmo(1);
+        ove.callUpdate();
+        CPPUNIT_ASSERT(ove.getActionButton(3)->getEnabled());
+
+        level.getHero()->removeListener(&ove);
+    }
+
+
+    /**
+     * Tests that the overlay, which overrides render(), says that it
+     * renders its own children, so that its parent calls its render().
+     */
+    void testRendersChildren()
+    {
+        OverlayTest ove;
+        CPPUNIT_ASSERT(ove.callRendersChildren());
+    }
 };
 
 void register_overlay()
@@ -0,0 +1,188 @@
+/************************************************************************
+ *
+ * testpool.cpp
+ * Pool class tests
+ *
+ ************************************************************************/
+
+#include "pool.h"
+#include "maze.h"
+#include "player.h"
+#include "billboard.h"
+#include "waitaction.h"
+#include "walkaction.h"
+#include "grenadeaction.h"
+
+#include "test.h"
+
+#include <iostream>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * A subclass of a pooled class. It is bigger than its base class, so it
+ * cannot be allocated from the base class's pool.
+ */
+class BigBillBoard : public BillBoard
+{
+public:
+    double extra[8];
+
+    BigBillBoard()
+        : BillBoard(NULL)
+    {
+    }
+};
+
+/**
+ * This test suite contains one test case:
+ *
+ * Code: CT-Poo
+ * Name: Pool class unit tests
+ * Configuration: Unit testing context
+ * Tools: Cppunit
+ * Description: Class tests for the Pool class and the pooled actions
+ */
+class testpool : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(testpool);
+    CPPUNIT_TEST(testReuse);
+    CPPUNIT_TEST(testLiveCount);
+    CPPUNIT_TEST(testSubclass);
+    CPPUNIT_TEST(testTurnCounters);
+    CPPUNIT_TEST(testSteadyState);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    Maze m;
+    Player p;
+    Player o;
+
+    // Update the action until it returns false for a maximum of twenty
+    // updates.
+    void cycleAction(Action *a)
+    {
+        int n = 0;
+        while (a->update(1.0) != false) {
+            n++;
+            CPPUNIT_ASSERT(n <= 20);
+        }
+    }
+
+public:
+
+    void setUp()
+    {
+        m.load("test/testgrenadeaction.hag");
+        p.setCell(m.getCell(0, 0), true);
+        o.setCell(m.getCell(2, 2), true);
+    }
+
+    void tearDown()
+    {
+    }
+
+    /**
+     * Test that a freed object's memory is used for the next object.
+     */
+    void testReuse()
+    {
+        Action *a = new WaitAction(&p);
+        void *first = a;
+        delete a;
+
+        a = new WaitAction(&p);
+        CPPUNIT_ASSERT((void*) a == first);
+        delete a;
+    }
+
+    /**
+     * Test that the pool keeps count of the objects in use.
+     */
+    void testLiveCount()
+    {
+        Pool<WaitAction> &pool = Pool<WaitAction>::getInstance();
+        int live = pool.getLiveCount();
+
+        Action *a = new WaitAction(&p);
+        Action *b = new WaitAction(&p);
+        CPPUNIT_ASSERT(pool.getLiveCount() == live+2);
+        CPPUNIT_ASSERT(pool.getCapacity() >= pool.getLiveCount());
+
+        delete a;
+        delete b;
+        CPPUNIT_ASSERT(pool.getLiveCount() == live);
+    }
+
+    /**
+     * Test that subclasses of pooled classes are allocated from the heap
+     * and don't disturb the pool.
+     */
+    void testSubclass()
+    {
+        Pool<BillBoard> &pool = Pool<BillBoard>::getInstance();
+        int live = pool.getLiveCount();
+
+        BillBoard *bb = new BigBillBoard();
+        CPPUNIT_ASSERT(pool.getLiveCount() == live);
+        delete bb;
+
+        bb = new BillBoard(NULL);
+        CPPUNIT_ASSERT(pool.getLiveCount() == live+1);
+        delete bb;
+        CPPUNIT_ASSERT(pool.getLiveCount() == live);
+    }
+
+    /**
+     * Test that startTurn moves the counts into the last turn counters.
+     */
+    void testTurnCounters()
+    {
+        PoolBase::startTurn();
+        CPPUNIT_ASSERT(PoolBase::getTurnAllocations() == 0);
+
+        delete new WaitAction(&p);
+        delete new WaitAction(&p);
+        CPPUNIT_ASSERT(PoolBase::getTurnAllocations() == 2);
+
+        PoolBase::startTurn();
+        CPPUNIT_ASSERT(PoolBase::getLastTurnAllocations() == 2);
+        CPPUNIT_ASSERT(PoolBase::getTurnAllocations() == 0);
+    }
+
+    /**
+     * Test that once the pools have warmed up, playing turns doesn't need
+     * the heap. Each turn walks the player back and forth and throws a
+     * grenade at the opponent.
+     */
+    void testSteadyState()
+    {
+        Cell *a = m.getCell(0, 0);
+        Cell *b = m.getCell(0, 1);
+
+        for (int turn=0; turn<10; turn++) {
+            PoolBase::startTurn();
+
+            p.setEnergy(p.getMaxStat());
+            p.setAmmo(p.getMaxStat());
+            o.setHealth(o.getMaxStat());
+
+            Action *act = new WalkAction(&p, (p.getCell() == a) ? b : a);
+            cycleAction(act);
+            delete act;
+
+            act = new GrenadeAction(&p, &o, p.getCell(), o.getCell());
+            cycleAction(act);
+            delete act;
+        }
+
+        PoolBase::startTurn();
+        CPPUNIT_ASSERT(PoolBase::getLastTurnAllocations() > 0);
+        CPPUNIT_ASSERT(PoolBase::getLastTurnHeapAllocations() == 0);
+    }
+};
+
+void register_pool()
+{
+    CPPUNIT_TEST_SUITE_REGISTRATION(testpool);
+}
@@ -0,0 +1,72 @@
+/************************************************************************
+ *
+ * testrandom.cpp
+ * Random class tests
+ *
+ ************************************************************************/
+
+#include "random.h"
+
+#include "test.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * This test suite contains one test case:
+ *
+ * Code: CT-Ran
+ * Name: Random class unit tests
+ * Configuration: Unit testing context
+ * Tools: Cppunit
+ * Description: Class tests for the Random class
+ */
+class testrandom : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(testrandom);
+    CPPUNIT_TEST(testSeed);
+    CPPUNIT_TEST(testRange);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void testSeed()
+    {
+        // the same seed gives the same numbers
+        Random a(42), b(42);
+        for (int k=0; k<100; k++) {
+            CPPUNIT_ASSERT(a.next() == b.next());
+        }
+
+        // seeding again starts the stream again
+        Random c(42);
+        uint32_t first = c.next();
+        c.next();
+        c.setSeed(42);
+        CPPUNIT_ASSERT(c.next() == first);
+
+        // neighbouring seeds give different numbers, and so does seed 0
+        Random d(43), e(0);
+        c.setSeed(42);
+        CPPUNIT_ASSERT(c.next() != d.next());
+        CPPUNIT_ASSERT(e.next() != e.next());
+    }
+
+    void testRange()
+    {
+        // the numbers are in range, and every value comes up about as often
+        Random r(1);
+        int counts[6] = {0, 0, 0, 0, 0, 0};
+        for (int k=0; k<6000; k++) {
+            int n = r.nextInt(6);
+            CPPUNIT_ASSERT((n >= 0) && (n < 6));
+            counts[n]++;
+        }
+        for (int n=0; n<6; n++) {
+            CPPUNIT_ASSERT((counts[n] > 800) && (counts[n] < 1200));
+        }
+    }
+};
+
+void register_random()
+{
+    CPPUNIT_TEST_SUITE_REGISTRATION(testrandom);
+}
@@ -0,0 +1,115 @@
+/************************************************************************
+ *
+ * testrenderstate.cpp
+ * RenderState class tests
+ *
+ ************************************************************************/
+
+#include "renderstate.h"
+
+#include "test.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * This test suite contains one test case:
+ *
+ * Code: CT-RSt
+ * Name: RenderState class unit tests
+ * Configuration: Unit testing context
+ * Tools: Cppunit
+ * Description: Class tests for the RenderState class
+ */
+class testrenderstate : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(testrenderstate);
+    CPPUNIT_TEST(testCaps);
+    CPPUNIT_TEST(testTexture);
+    CPPUNIT_TEST(testColor);
+    CPPUNIT_TEST(testInvalidate);
+    CPPUNIT_TEST(testFrames);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    RenderState state;
+
+public:
+    void testCaps()
+    {
+        state.enable(GL_TEXTURE_2D);
+        state.enable(GL_TEXTURE_2D);
+        state.enable(GL_LIGHTING);
+        CPPUNIT_ASSERT(state.getFrameChanges() == 2);
+        CPPUNIT_ASSERT(state.getFrameSkipped() == 1);
+
+        state.disable(GL_TEXTURE_2D);
+        state.disable(GL_TEXTURE_2D);
+        CPPUNIT_ASSERT(state.getFrameChanges() == 3);
+        CPPUNIT_ASSERT(state.getFrameSkipped() == 2);
+    }
+
+    void testTexture()
+    {
+        state.bindTexture(1);
+        state.bindTexture(1);
+        state.bindTexture(2);
+        CPPUNIT_ASSERT(state.getFrameChanges() == 2);
+        CPPUNIT_ASSERT(state.getFrameSkipped() == 1);
+
+        // deleting another texture does not affect the binding
+        state.forgetTexture(1);
+        state.bindTexture(2);
+        CPPUNIT_ASSERT(state.getFrameChanges() == 2);
+
+        // but deleting the bound one does
+        state.forgetTexture(2);
+        state.bindTexture(2);
+        CPPUNIT_ASSERT(state.getFrameChanges() == 3);
+    }
+
+    void testColor()
+    {
+        state.color(1, 0, 0);
+        state.color(1, 0, 0, 1);
+        state.color(1, 0, 0, 0.5);
+        CPPUNIT_ASSERT(state.getFrameChanges() == 2);
+        CPPUNIT_ASSERT(state.getFrameSkipped() == 1);
+
+        state.forgetColor();
+        state.color(1, 0, 0, 0.5);
+        CPPUNIT_ASSERT(state.getFrameChanges() == 3);
+    }
+
+    void testInvalidate()
+    {
+        state.enable(GL_BLEND);
+        state.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        state.alphaFunc(GL_GREATER, 0);
+        state.invalidate();
+        state.enable(GL_BLEND);
+        state.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        state.alphaFunc(GL_GREATER, 0);
+        CPPUNIT_ASSERT(state.getFrameChanges() == 6);
+        CPPUNIT_ASSERT(state.getFrameSkipped() == 0);
+    }
+
+    void testFrames()
+    {
+        state.enable(GL_BLEND);
+        state.enable(GL_BLEND);
+        state.startFrame();
+        CPPUNIT_ASSERT(state.getLastFrameChanges() == 1);
+        CPPUNIT_ASSERT(state.getLastFrameSkipped() == 1);
+        CPPUNIT_ASSERT(state.getFrameChanges() == 0);
+        CPPUNIT_ASSERT(state.getFrameSkipped() == 0);
+
+        // the state is remembered between frames
+        state.enable(GL_BLEND);
+        CPPUNIT_ASSERT(state.getFrameSkipped() == 1);
+    }
+};
+
+void register_renderstate()
+{
+    CPPUNIT_TEST_SUITE_REGISTRATION(testrenderstate);
+}
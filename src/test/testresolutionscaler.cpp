@@ -0,0 +1,114 @@
+/************************************************************************
+ *
+ * testresolutionscaler.cpp
+ * ResolutionScaler class tests
+ *
+ ************************************************************************/
+
+#include "resolutionscaler.h"
+
+#include "test.h"
+
+#include <cmath>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * This test suite contains one test case:
+ *
+ * Code: CT-RSc
+ * Name: ResolutionScaler class unit tests
+ * Configuration: Unit testing context
+ * Tools: Cppunit
+ * Description: Class tests for the ResolutionScaler class
+ */
+class testresolutionscaler : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(testresolutionscaler);
+    CPPUNIT_TEST(testDisabled);
+    CPPUNIT_TEST(testSlowFrames);
+    CPPUNIT_TEST(testFastFrames);
+    CPPUNIT_TEST(testLimits);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    ResolutionScaler *s;
+
+public:
+    void setUp()
+    {
+        s = new ResolutionScaler();
+        s->setScreenSize(800, 600);
+    }
+
+    void tearDown()
+    {
+        delete s;
+    }
+
+    void testDisabled()
+    {
+        // without a target, slow frames do not change the resolution
+        s->update(1.0);
+        CPPUNIT_ASSERT(s->getScale() == 1);
+        CPPUNIT_ASSERT(s->getRenderWidth() == 800);
+        CPPUNIT_ASSERT(s->getRenderHeight() == 600);
+    }
+
+    void testSlowFrames()
+    {
+        s->setTargetFrameTime(0.02);
+
+        // frames that take too long lower the resolution gradually
+        s->update(0.03);
+        float first = s->getScale();
+        CPPUNIT_ASSERT(first < 1);
+        s->update(0.03);
+        CPPUNIT_ASSERT(s->getScale() < first);
+        CPPUNIT_ASSERT(s->getRenderWidth() < 800);
+        CPPUNIT_ASSERT(s->getRenderHeight() < 600);
+
+        // and it settles where the frames take the target time
+        for (int i=0; i<100; i++) {
+            float t = 0.03 * s->getScale() * s->getScale();
+            s->update(t);
+        }
+        float expected = sqrt(0.02 / 0.03);
+        CPPUNIT_ASSERT(fabs(s->getScale() - expected) < 0.01);
+    }
+
+    void testFastFrames()
+    {
+        s->setTargetFrameTime(0.02);
+        s->update(0.04);
+        float low = s->getScale();
+
+        // fast frames raise it again
+        s->update(0.01);
+        CPPUNIT_ASSERT(s->getScale() > low);
+
+        // turning scaling off restores the full resolution
+        s->setTargetFrameTime(0);
+        CPPUNIT_ASSERT(s->getScale() == 1);
+    }
+
+    void testLimits()
+    {
+        s->setTargetFrameTime(0.02);
+        for (int i=0; i<100; i++) {
+            s->update(1.0);
+        }
+        CPPUNIT_ASSERT(s->getScale() == 0.5);
+        CPPUNIT_ASSERT(s->getRenderWidth() == 400);
+
+        for (int i=0; i<100; i++) {
+            s->update(0.001);
+        }
+        CPPUNIT_ASSERT(s->getScale() == 1);
+    }
+};
+
+void register_resolutionscaler()
+{
+    CPPUNIT_TEST_SUITE_REGISTRATION(testresolutionscaler);
+}
@@ -0,0 +1,159 @@
+/************************************************************************
+ *
+ * testsimulator.cpp
+ * Simulator class tests
+ *
+ ************************************************************************/
+
+#include "simulator.h"
+#include "haggispolicy.h"
+#include "randompolicy.h"
+#include "chasepolicy.h"
+#include "hexcoord.h"
+
+#include "test.h"
+
+#include <fstream>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * This test suite contains one test case:
+ *
+ * Code: CT-Sim
+ * Name: Simulator class unit tests
+ * Configuration: Unit testing context
+ * Tools: Cppunit
+ * Description: Class tests for the Simulator class and the policies it
+ *              plays with
+ */
+class testsimulator : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(testsimulator);
+    CPPUNIT_TEST(testPlay);
+    CPPUNIT_TEST(testRun);
+    CPPUNIT_TEST(testSeed);
+    CPPUNIT_TEST(testHaggisPolicy);
+    CPPUNIT_TEST(testChasePolicy);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    GameState s;
+    Random random;
+
+public:
+    void setUp()
+    {
+        std::ifstream in("test/testmaze.hag");
+        s.load(in, "test/testmaze.hag", random);
+    }
+
+    void testPlay()
+    {
+        Simulator sim(s, Simulator::RANDOM_HERO, 200);
+        RandomPolicy hero;
+        HaggisPolicy haggis;
+        Simulator::Stats stats;
+
+        Simulator::Result r = sim.play(hero, haggis, random, stats);
+        CPPUNIT_ASSERT(stats.games == 1);
+        CPPUNIT_ASSERT(stats.moves > 0);
+        CPPUNIT_ASSERT(stats.moves <= 200);
+        CPPUNIT_ASSERT((r != Simulator::HERO_WON) || (stats.heroWins == 1));
+        CPPUNIT_ASSERT((r != Simulator::HAGGIS_WON) || (stats.haggisWins == 1));
+        CPPUNIT_ASSERT((r != Simulator::DRAW) || (stats.draws == 1));
+    }
+
+    void testRun()
+    {
+        // the games are shared out between the workers
+        Simulator sim(s, Simulator::CHASE_HERO, 200);
+        Simulator::Stats stats = sim.run(21, 4);
+        CPPUNIT_ASSERT(stats.games == 21);
+        CPPUNIT_ASSERT(stats.heroWins + stats.haggisWins + stats.draws == 21);
+        CPPUNIT_ASSERT(Simulator::getProcessorCount() >= 1);
+    }
+
+    void testSeed()
+    {
+        // a game played again with the same seed is the same game
+        Simulator sim(s, Simulator::RANDOM_HERO, 200);
+        RandomPolicy hero;
+        HaggisPolicy haggis;
+        Simulator::Stats first, second;
+        Random r(7);
+        Simulator::Result a = sim.play(hero, haggis, r, first);
+        r.setSeed(7);
+        hero.reset();
+        haggis.reset();
+        Simulator::Result b = sim.play(hero, haggis, r, second);
+        CPPUNIT_ASSERT(a == b);
+        CPPUNIT_ASSERT(first.moves == second.moves);
+
+        // and the results don't depend on the number of threads
+        Simulator::Stats one = sim.run(12, 1);
+        Simulator::Stats three = sim.run(12, 3);
+        CPPUNIT_ASSERT(one.heroWins == three.heroWins);
+        CPPUNIT_ASSERT(one.haggisWins == three.haggisWins);
+        CPPUNIT_ASSERT(one.moves == three.moves);
+    }
+
+    void testHaggisPolicy()
+    {
+        HaggisPolicy haggis;
+        s.heroTurn = false;
+
+        // without ammo the haggis never throws a grenade
+        s.haggis.ammo = 0;
+        for (int k=0; k<20; k++) {
+            CPPUNIT_ASSERT(haggis.choose(s, random).type != Move::GRENADE);
+        }
+
+        // the haggis walks one step at a time along its path, onto cells
+        // it can enter
+        haggis.reset();
+        GameState t = s;
+        int walks = 0;
+        for (int k=0; k<20; k++) {
+            t.haggis.energy = s.haggis.energy;
+            Move m = haggis.choose(t, random);
+            if (m.type == Move::WALK) {
+                HexCoord here = HexCoord::fromMaze(t.haggis.i, t.haggis.j);
+                CPPUNIT_ASSERT(here.distance(HexCoord::fromMaze(m.i, m.j)) == 1);
+                CPPUNIT_ASSERT(GameRules::canEnter(t, m.i, m.j));
+                walks++;
+            }
+            GameRules::play(t, m);
+            t.heroTurn = false;
+        }
+        CPPUNIT_ASSERT(walks > 0);
+
+        // without energy the haggis can only wait
+        s.haggis.energy = 0;
+        CPPUNIT_ASSERT(haggis.choose(s, random).type == Move::WAIT);
+    }
+
+    void testChasePolicy()
+    {
+        // the haggis is next to the hero, so the hero throws at it
+        ChasePolicy hero;
+        CPPUNIT_ASSERT(hero.choose(s, random) == Move(Move::GRENADE, 1, 2));
+
+        // and has to wait when it has nothing to throw
+        s.hero.ammo = 0;
+        CPPUNIT_ASSERT(hero.choose(s, random).type == Move::WAIT);
+
+        // the haggis walks along the corridor towards the hero
+        s.heroTurn = false;
+        s.haggis.ammo = 0;
+        s.haggis.i = 3;
+        s.haggis.j = 9;
+        ChasePolicy haggis;
+        CPPUNIT_ASSERT(haggis.choose(s, random) == Move(Move::WALK, 2, 9));
+    }
+};
+
+void register_simulator()
+{
+    CPPUNIT_TEST_SUITE_REGISTRATION(testsimulator);
+}
@@ -0,0 +1,157 @@
+/************************************************************************
+ *
+ * testterrain.cpp
+ * Terrain class tests
+ *
+ ************************************************************************/
+
+#include "terrain.h"
+#include "maze.h"
+
+#include "test.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * This test suite contains one test case:
+ *
+ * Code: CT-Ter
+ * Name: Terrain class unit tests
+ * Configuration: Unit testing context
+ * Tools: Cppunit
+ * Description: Class tests for the Terrain class
+ */
+class testterrain : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(testterrain);
+    CPPUNIT_TEST(testChunks);
+    CPPUNIT_TEST(testDirtyChunk);
+    CPPUNIT_TEST(testColor);
+    CPPUNIT_TEST(testHiddenSides);
+    CPPUNIT_TEST(testLights);
+    CPPUNIT_TEST(testUnload);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    Maze *m;
+    Terrain *t;
+
+public:
+    void setUp()
+    {
+        m = new Maze();
+        m->load("test/testmaze.hag");
+        t = m->getTerrain();
+    }
+
+    void tearDown()
+    {
+        delete m;
+    }
+
+    void testChunks()
+    {
+        // the 11x11 maze is split into 2x2 chunks
+        CPPUNIT_ASSERT(t->getChunkCount() == 4);
+
+        // nothing is built until the terrain is rendered
+        CPPUNIT_ASSERT(t->getRebuildCount() == 0);
+        t->render();
+        CPPUNIT_ASSERT(t->getRebuildCount() == 4);
+        CPPUNIT_ASSERT(t->getChunksDrawn() == 4);
+
+        // without textures, each chunk is one call for the cells and one
+        // for the outlines
+        CPPUNIT_ASSERT(t->getDrawCalls() == 8);
+
+        // nothing is rebuilt if nothing changed
+        t->render();
+        CPPUNIT_ASSERT(t->getRebuildCount() == 4);
+    }
+
+    void testDirtyChunk()
+    {
+        t->render();
+
+        // lowering a wall only rebuilds the chunk it is in
+        Cell *c = m->getCell(0, 0);
+        CPPUNIT_ASSERT(c->getWall());
+        c->hitWall();
+        t->render();
+        CPPUNIT_ASSERT(t->getRebuildCount() == 5);
+
+        m->getCell(10, 10)->hitWall();
+        m->getCell(10, 9)->hitWall();
+        t->render();
+        CPPUNIT_ASSERT(t->getRebuildCount() == 6);
+    }
+
+    void testColor()
+    {
+        t->render();
+
+        // colour changes do not rebuild the geometry
+        Cell *c = m->getCell(1, 6);
+        c->setHighlighted(true);
+        CPPUNIT_ASSERT(c->getColor() == vector4(0.5, 0, 0));
+        c->setSelectable(true);
+        CPPUNIT_ASSERT(c->getColor() == vector4(0, 1, 0));
+        t->render();
+        CPPUNIT_ASSERT(t->getRebuildCount() == 4);
+    }
+
+    void testHiddenSides()
+    {
+        // on flat ground only the sides on the edge of the maze are built
+        for (int i=0; i<11; i++) {
+            for (int j=0; j<11; j++) {
+                vector4 p = m->getCell(i, j)->getPosition();
+                m->getCell(i, j)->setPosition(vector4(p.x, 0, p.z));
+            }
+        }
+        t->render();
+        int flat = t->getTriangleCount();
+        CPPUNIT_ASSERT(flat < 121*16/2);
+
+        // raising a cell inside the maze adds its six sides and nothing else
+        Cell *c = m->getCell(5, 5);
+        vector4 p = c->getPosition();
+        c->setPosition(vector4(p.x, 1, p.z));
+        c->setTexture(NULL);
+        t->render();
+        CPPUNIT_ASSERT(t->getTriangleCount() == flat + 12);
+    }
+
+    void testLights()
+    {
+        // without dynamic lights, the baked lighting is all that is drawn
+        t->render();
+        CPPUNIT_ASSERT(t->getLitChunks() == 0);
+
+        // a light only reaches the chunks near it, which are drawn again
+        t->addLight(GL_LIGHT2, m->getCell(0, 0)->getPosition());
+        t->render();
+        CPPUNIT_ASSERT(t->getLitChunks() == 1);
+        CPPUNIT_ASSERT(t->getDrawCalls() == 9);
+
+        t->addLight(GL_LIGHT3, vector4(0, 100, 0));
+        t->render();
+        CPPUNIT_ASSERT(t->getLitChunks() == 1);
+
+        t->clearLights();
+        t->render();
+        CPPUNIT_ASSERT(t->getLitChunks() == 0);
+    }
+
+    void testUnload()
+    {
+        // cells are detached from the terrain when the maze is unloaded
+        m->unload();
+        CPPUNIT_ASSERT(t->getChunkCount() == 0);
+    }
+};
+
+void register_terrain()
+{
+    CPPUNIT_TEST_SUITE_REGISTRATION(testterrain);
+}
@@ -0,0 +1,119 @@
+/************************************************************************
+ *
+ * testtextureatlas.cpp
+ * TextureAtlas class tests
+ *
+ ************************************************************************/
+
+#include "textureatlas.h"
+
+#include "test.h"
+
+#include <vector>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * This test suite contains one test case:
+ *
+ * Code: CT-Atl
+ * Name: TextureAtlas class unit tests
+ * Configuration: Unit testing context
+ * Tools: Cppunit
+ * Description: Class tests for the TextureAtlas packing
+ */
+class testtextureatlas : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(testtextureatlas);
+    CPPUNIT_TEST(testTooBig);
+    CPPUNIT_TEST(testNoOverlap);
+    CPPUNIT_TEST(testPages);
+    CPPUNIT_TEST(testLoad);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    /**
+     * A rectangle that was allocated.
+     */
+    struct Rect
+    {
+        int page, x, y, w, h;
+    };
+
+    /**
+     * Returns true if the rectangles are on the same page and overlap.
+     */
+    bool overlaps(Rect &a, Rect &b)
+    {
+        return (a.page == b.page) &&
+            (a.x < b.x + b.w) && (b.x < a.x + a.w) &&
+            (a.y < b.y + b.h) && (b.y < a.y + a.h);
+    }
+
+public:
+    void testTooBig()
+    {
+        TextureAtlas atlas;
+        int page, x, y;
+        CPPUNIT_ASSERT(!atlas.allocate(ATLAS_PAGE_SIZE+1, 10, page, x, y));
+        CPPUNIT_ASSERT(atlas.getPageCount() == 0);
+        CPPUNIT_ASSERT(atlas.allocate(ATLAS_PAGE_SIZE, ATLAS_PAGE_SIZE,
+                                      page, x, y));
+        CPPUNIT_ASSERT(atlas.getPageCount() == 1);
+    }
+
+    void testNoOverlap()
+    {
+        TextureAtlas atlas;
+        std::vector<Rect> rects;
+
+        // a mix of sizes like the overlay images
+        for (int i=0; i<60; i++) {
+            Rect r;
+            r.w = 64 + (i*37) % 200;
+            r.h = 32 + (i*53) % 100;
+            CPPUNIT_ASSERT(atlas.allocate(r.w, r.h, r.page, r.x, r.y));
+            CPPUNIT_ASSERT((r.x >= 0) && (r.x + r.w <= ATLAS_PAGE_SIZE));
+            CPPUNIT_ASSERT((r.y >= 0) && (r.y + r.h <= ATLAS_PAGE_SIZE));
+            rects.push_back(r);
+        }
+
+        for (unsigned i=0; i<rects.size(); i++) {
+            for (unsigned j=0; j<i; j++) {
+                CPPUNIT_ASSERT(!overlaps(rects[i], rects[j]));
+            }
+        }
+    }
+
+    void testPages()
+    {
+        TextureAtlas atlas;
+        int page, x, y;
+
+        // four quarter-page images fill one page, so the fifth goes on a
+        // new page
+        int size = ATLAS_PAGE_SIZE/2 - ATLAS_PADDING;
+        for (int i=0; i<4; i++) {
+            CPPUNIT_ASSERT(atlas.allocate(size, size, page, x, y));
+            CPPUNIT_ASSERT(page == 0);
+        }
+        CPPUNIT_ASSERT((x == size + ATLAS_PADDING) &&
+                       (y == size + ATLAS_PADDING));
+        CPPUNIT_ASSERT(atlas.allocate(size, size, page, x, y));
+        CPPUNIT_ASSERT(page == 1);
+        CPPUNIT_ASSERT((x == 0) && (y == 0));
+        CPPUNIT_ASSERT(atlas.getPageCount() == 2);
+    }
+
+    void testLoad()
+    {
+        // nothing can be loaded without SDL
+        CPPUNIT_ASSERT(Texture::loadPacked("images/overlay/health.png")
+                       == NULL);
+    }
+};
+
+void register_textureatlas()
+{
+    CPPUNIT_TEST_SUITE_REGISTRATION(testtextureatlas);
+}
@@ -0,0 +1,139 @@
+/************************************************************************
+ *
+ * testthinker.cpp
+ * Thinker class tests
+ *
+ ************************************************************************/
+
+#include "thinker.h"
+#include "mctspolicy.h"
+
+#include "test.h"
+
+#include <fstream>
+#include <algorithm>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * This test suite contains one test case:
+ *
+ * Code: CT-Thi
+ * Name: Thinker class unit tests
+ * Configuration: Unit testing context
+ * Tools: Cppunit
+ * Description: Class tests for the Thinker class
+ */
+class testthinker : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(testthinker);
+    CPPUNIT_TEST(testThink);
+    CPPUNIT_TEST(testPonder);
+    CPPUNIT_TEST(testChangeOfMind);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    GameState s;
+    Random random;
+    MctsPolicy *policy;
+    Thinker *thinker;
+
+    /**
+     * Wait until the thinker has nothing left to think about, for at most
+     * ten seconds. Returns true if it finished.
+     */
+    bool waitForIdle()
+    {
+        for (int k=0; k<1000; k++) {
+            if (thinker->isIdle()) {
+                return true;
+            }
+            SDL_Delay(10);
+        }
+        return false;
+    }
+
+public:
+    void setUp()
+    {
+        std::ifstream in("test/testmaze.hag");
+        s.load(in, "test/testmaze.hag", random);
+        policy = new MctsPolicy(1, 0, 50);
+        thinker = new Thinker(policy, 5);
+    }
+
+    void tearDown()
+    {
+        delete thinker;
+        delete policy;
+    }
+
+    void testThink()
+    {
+        // nothing has been chosen before the thinker is asked
+        s.heroTurn = false;
+        Move m;
+        CPPUNIT_ASSERT(!thinker->getMove(s, m));
+
+        // the move is handed over once it has been chosen
+        thinker->think(s);
+        CPPUNIT_ASSERT(waitForIdle());
+        CPPUNIT_ASSERT(thinker->getMove(s, m));
+        std::vector<Move> moves;
+        GameRules::getMoves(s, moves);
+        CPPUNIT_ASSERT(std::find(moves.begin(), moves.end(), m) != moves.end());
+
+        // and asking again doesn't choose it again
+        thinker->think(s);
+        CPPUNIT_ASSERT(thinker->isIdle());
+    }
+
+    void testPonder()
+    {
+        // the replies to the likely move and a few others are ready when
+        // pondering is done, and no more are thought about
+        thinker->ponder(s);
+        CPPUNIT_ASSERT(waitForIdle());
+
+        std::vector<Move> moves;
+        GameRules::getMoves(s, moves);
+        CPPUNIT_ASSERT(moves.size() > PONDER_REPLIES + 1);
+        unsigned int ready = 0;
+        for (unsigned int k=0; k<moves.size(); k++) {
+            GameState t = s;
+            GameRules::play(t, moves[k]);
+            Move m;
+            if (thinker->getMove(t, m)) {
+                ready++;
+            }
+        }
+        CPPUNIT_ASSERT(ready == PONDER_REPLIES + 1);
+    }
+
+    void testChangeOfMind()
+    {
+        // once the hero has moved, the other replies are not thought about;
+        // the searches are made longer so the hero moves while the thinker
+        // is still working out what the hero is likely to do
+        delete thinker;
+        delete policy;
+        policy = new MctsPolicy(1, 0, 2000);
+        thinker = new Thinker(policy, 5);
+        thinker->ponder(s);
+        GameState t = s;
+        GameRules::play(t, Move(Move::WAIT));
+        thinker->think(t);
+        CPPUNIT_ASSERT(waitForIdle());
+
+        Move m;
+        CPPUNIT_ASSERT(thinker->getMove(t, m));
+        GameState u = s;
+        GameRules::play(u, Move(Move::GRENADE, 1, 2));
+        CPPUNIT_ASSERT(!thinker->getMove(u, m));
+    }
+};
+
+void register_thinker()
+{
+    CPPUNIT_TEST_SUITE_REGISTRATION(testthinker);
+}
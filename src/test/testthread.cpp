@@ -0,0 +1,84 @@
+/************************************************************************
+ *
+ * testthread.cpp
+ * Thread and Clock class tests
+ *
+ ************************************************************************/
+
+#include "thread.h"
+#include "clock.h"
+
+#include "test.h"
+
+#include <vector>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * Add up the numbers from 1 to *data, and return the last digit.
+ */
+static int sumTo(void *data)
+{
+    int *n = (int *) data;
+    int sum = 0;
+    for (int k=1; k<=*n; k++) {
+        sum += k;
+    }
+    *n = sum;
+    return sum % 10;
+}
+
+/**
+ * This test suite contains one test case:
+ *
+ * Code: CT-Thr
+ * Name: Thread and Clock class unit tests
+ * Configuration: Unit testing context
+ * Tools: Cppunit
+ * Description: Class tests for the Thread and Clock classes
+ */
+class testthread : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(testthread);
+    CPPUNIT_TEST(testJoin);
+    CPPUNIT_TEST(testClock);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void testJoin()
+    {
+        // every thread runs its function on its own data, and join gives
+        // back the function's result
+        std::vector<int> data(4);
+        std::vector<Thread> threads(4);
+        for (int k=0; k<4; k++) {
+            data[k] = 10 * (k+1);
+            threads[k].start(sumTo, &data[k]);
+        }
+        for (int k=0; k<4; k++) {
+            int n = 10 * (k+1);
+            CPPUNIT_ASSERT(threads[k].join() == (n*(n+1)/2) % 10);
+            CPPUNIT_ASSERT(data[k] == n*(n+1)/2);
+        }
+
+        CPPUNIT_ASSERT(Thread::getProcessorCount() >= 1);
+    }
+
+    void testClock()
+    {
+        // the clock never goes back, and moves on while it is read
+        uint32_t start = Clock::getTicks();
+        uint32_t last = start;
+        while ((int32_t) (last - start) < 20) {
+            uint32_t now = Clock::getTicks();
+            CPPUNIT_ASSERT((int32_t) (now - last) >= 0);
+            last = now;
+        }
+        CPPUNIT_ASSERT((int32_t) (last - start) < 1000);
+    }
+};
+
+void register_thread()
+{
+    CPPUNIT_TEST_SUITE_REGISTRATION(testthread);
+}
@@ -0,0 +1,123 @@
+/************************************************************************
+ *
+ * testuibatch.cpp
+ * UIBatch class tests
+ *
+ ************************************************************************/
+
+#include "uibatch.h"
+#include "window.h"
+#include "progressbar.h"
+
+#include "test.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * This test suite contains one test case:
+ *
+ * Code: CT-UIB
+ * Name: UIBatch class unit tests
+ * Configuration: Unit testing context
+ * Tools: Cppunit
+ * Description: Class tests for the UIBatch class
+ */
+class testuibatch : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(testuibatch);
+    CPPUNIT_TEST(testEmpty);
+    CPPUNIT_TEST(testGrouping);
+    CPPUNIT_TEST(testOverlap);
+    CPPUNIT_TEST(testOrigin);
+    CPPUNIT_TEST(testWindowTree);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    UIBatch batch;
+
+public:
+    void testEmpty()
+    {
+        batch.flush();
+        CPPUNIT_ASSERT(batch.getQuadCount() == 0);
+        CPPUNIT_ASSERT(batch.getDrawCalls() == 0);
+    }
+
+    void testGrouping()
+    {
+        // fills and outlines that don't overlap are drawn in two groups no
+        // matter what order they were added in
+        for (int i=0; i<3; i++) {
+            batch.addQuad(NULL, vector4(2*i, 0), vector4(1, 1), 1, 1, 1);
+            batch.addOutline(vector4(2*i, 2), vector4(1, 1), 0, 0, 0);
+        }
+        batch.flush();
+        CPPUNIT_ASSERT(batch.getQuadCount() == 6);
+        CPPUNIT_ASSERT(batch.getDrawCalls() == 2);
+
+        // the batch is empty after a flush
+        batch.flush();
+        CPPUNIT_ASSERT(batch.getQuadCount() == 0);
+    }
+
+    void testOverlap()
+    {
+        // a fill on top of an outline on top of a fill cannot be merged
+        batch.addQuad(NULL, vector4(0, 0), vector4(1, 1), 1, 1, 1);
+        batch.addOutline(vector4(0, 0), vector4(1, 1), 0, 0, 0);
+        batch.addQuad(NULL, vector4(0.5, 0.5), vector4(1, 1), 1, 1, 1);
+        batch.flush();
+        CPPUNIT_ASSERT(batch.getQuadCount() == 3);
+        CPPUNIT_ASSERT(batch.getDrawCalls() == 3);
+
+        // quads that only touch do not overlap
+        batch.addQuad(NULL, vector4(0, 0), vector4(1, 1), 1, 1, 1);
+        batch.addOutline(vector4(1, 0), vector4(1, 1), 0, 0, 0);
+        batch.addQuad(NULL, vector4(2, 0), vector4(1, 1), 1, 1, 1);
+        batch.flush();
+        CPPUNIT_ASSERT(batch.getDrawCalls() == 2);
+    }
+
+    void testOrigin()
+    {
+        // the outline only overlaps the fills if the origin is applied
+        batch.pushOrigin(vector4(2, 0));
+        batch.addQuad(NULL, vector4(0, 0), vector4(1, 1), 1, 1, 1);
+        batch.popOrigin();
+        batch.addOutline(vector4(2, 0), vector4(1, 1), 0, 0, 0);
+        batch.pushOrigin(vector4(1, 0));
+        batch.pushOrigin(vector4(1, 0));
+        batch.addQuad(NULL, vector4(0, 0), vector4(1, 1), 1, 1, 1);
+        batch.popOrigin();
+        batch.popOrigin();
+        batch.flush();
+        CPPUNIT_ASSERT(batch.getDrawCalls() == 3);
+    }
+
+    void testWindowTree()
+    {
+        // the root window flushes the shared batch at the end of the pass
+        Window root;
+        root.setSize(vector4(1.33, 1));
+
+        ProgressBar *bar = new ProgressBar();
+        bar->setPosition(vector4(0.1, 0.1));
+        bar->setSize(vector4(0.5, 0.1));
+        bar->setProgress(0.5);
+        root.addChild(bar);
+
+        root.render(RENDER_PASS_1, 0);
+
+        UIBatch &shared = UIBatch::getInstance();
+        CPPUNIT_ASSERT(shared.getQuadCount() == 2);
+        CPPUNIT_ASSERT(shared.getDrawCalls() == 2);
+
+        root.removeChild(bar);
+        delete bar;
+    }
+};
+
+void register_uibatch()
+{
+    CPPUNIT_TEST_SUITE_REGISTRATION(testuibatch);
+}
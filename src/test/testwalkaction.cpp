@@ -122,9 +122,6 @@ public:
     {
         WalkAction::markSelectable(&p, &m);
 
-        m.findCellNeighbours(p.getCell());
-        std::vector<Cell*> neigh = p.getCell()->neighbours;
-
         for (int i=0; i<m.getHeight(); i++) {
             for (int j=0; j<m.getWidth(); j++) {
 
@@ -136,9 +133,8 @@ public:
                 // for each cell that is selectable, check if it is adjacent
 
                 bool found = false;
-                std::vector<Cell*>::iterator i;
-                for (i=neigh.begin(); i != neigh.end(); i++) {
-                    if (*i == c) {
+                for (int k=0; k<MazeGrid::getNeighbourCount(); k++) {
+                    if (m.getNeighbour(p.getCell(), k) == c) {
                         found = true;
                         break;
                     }
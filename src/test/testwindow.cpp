@@ -16,7 +16,9 @@
  * An extended version of Window for testing the event methods.
  * When it receives an event, it increments the corresponding counter and
  * returns the chosen response. It also keeps a count of the number of time
- * render() and draw() are called.
+ * render() and draw() are called. If ownRender is set, the window renders
+ * its own children instead of being compiled into its parent's render
+ * lists.
  */
 class TestWindow : public Window
 {
@@ -26,12 +28,14 @@ private:
 public:
     int mouseEvent, buttonEvent, keyEvent; // event counters
     int renders, draws; // render counters
+    bool ownRender;
 
     TestWindow()
     {
         mouseEvent = buttonEvent = keyEvent = 0;
         renders = draws = 0;
         response = false;
+        ownRender = false;
     }
 
     void setResponse(bool r)
@@ -68,6 +72,11 @@ protected:
     {
         draws++;
     }
+
+    virtual bool rendersChildren()
+    {
+        return ownRender;
+    }
 };
 
 /**
@@ -104,6 +113,7 @@ class testwindow : public CppUnit::TestFixture
     CPPUNIT_TEST(testMouseEvent_All);
     CPPUNIT_TEST(testMouseEvent_Priority);
     CPPUNIT_TEST(testMouseEvent_Second);
+    CPPUNIT_TEST(testMouseEvent_Moved);
     CPPUNIT_TEST(testButtonEvent_All);
     CPPUNIT_TEST(testButtonEvent_Priority);
     CPPUNIT_TEST(testButtonEvent_Second);
@@ -113,6 +123,9 @@ class testwindow : public CppUnit::TestFixture
     CPPUNIT_TEST(testRender_Pass1);
     CPPUNIT_TEST(testRender_Pass2);
     CPPUNIT_TEST(testRender_Pass3);
+    CPPUNIT_TEST(testRender_Invalidate);
+    CPPUNIT_TEST(testRender_Own);
+    CPPUNIT_TEST(testRender_Contract);
     CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -449,6 +462,40 @@ public:
         CPPUNIT_ASSERT(d.mouseEvent == 1);
     }
 
+    /**
+     * Tests that events follow windows that are moved, resized or disabled
+     * after an event has been handled.
+     */
+    void testMouseEvent_Moved()
+    {
+        a.handleMouseEvent(MouseEvent(vector4(1, 1), vector4()));
+        CPPUNIT_ASSERT(d.mouseEvent == 1);
+
+        // move d away from the point
+        d.setPosition(vector4(5, 5));
+        a.handleMouseEvent(MouseEvent(vector4(1, 1), vector4()));
+        CPPUNIT_ASSERT(d.mouseEvent == 1);
+        CPPUNIT_ASSERT(b.mouseEvent == 2);
+
+        // d only receives events in the part of it inside b
+        d.setResponse(true);
+        a.handleMouseEvent(MouseEvent(vector4(6, 6), vector4()));
+        CPPUNIT_ASSERT(d.mouseEvent == 2);
+        bool r = a.handleMouseEvent(MouseEvent(vector4(11, 11), vector4()));
+        CPPUNIT_ASSERT(r == false);
+        CPPUNIT_ASSERT(d.mouseEvent == 2);
+
+        // shrinking b hides d completely
+        b.setSize(vector4(4, 4));
+        a.handleMouseEvent(MouseEvent(vector4(6, 6), vector4()));
+        CPPUNIT_ASSERT(d.mouseEvent == 2);
+
+        // and disabling c stops its events
+        c.setEnabled(false);
+        a.handleMouseEvent(MouseEvent(vector4(1, 1), vector4()));
+        CPPUNIT_ASSERT(c.mouseEvent == 3);
+    }
+
     /**
      * Tests that button events are passed to every child if none of them
      * accept the event.
@@ -539,11 +586,12 @@ public:
     {
         a.render(RENDER_PASS_1 | RENDER_PASS_2 | RENDER_PASS_3, 0);
 
-        // check that everything was rendered and drawn
+        // check that everything was drawn from a's render list, without
+        // rendering the children separately
         CPPUNIT_ASSERT(a.renders == 1);
-        CPPUNIT_ASSERT(b.renders == 1);
-        CPPUNIT_ASSERT(c.renders == 1);
-        CPPUNIT_ASSERT(d.renders == 1);
+        CPPUNIT_ASSERT(b.renders == 0);
+        CPPUNIT_ASSERT(c.renders == 0);
+        CPPUNIT_ASSERT(d.renders == 0);
 
         CPPUNIT_ASSERT(a.draws == 1);
         CPPUNIT_ASSERT(b.draws == 1);
@@ -562,8 +610,8 @@ public:
 
         // check the number of renders
         CPPUNIT_ASSERT(a.renders == 1);
-        CPPUNIT_ASSERT(b.renders == 1);
-        CPPUNIT_ASSERT(c.renders == 1);
+        CPPUNIT_ASSERT(b.renders == 0);
+        CPPUNIT_ASSERT(c.renders == 0);
         CPPUNIT_ASSERT(d.renders == 0);
 
         // check the number of draws
@@ -611,6 +659,75 @@ public:
         CPPUNIT_ASSERT(c.draws == 1);
         CPPUNIT_ASSERT(d.draws == 0);
     }
+
+    /**
+     * Tests that changes to the tree are seen after the render lists have
+     * been compiled.
+     */
+    void testRender_Invalidate()
+    {
+        int all = RENDER_PASS_1 | RENDER_PASS_2 | RENDER_PASS_3;
+        a.render(all, 0);
+
+        // disabling a window deep in the tree
+        d.setEnabled(false);
+        a.render(all, 0);
+        CPPUNIT_ASSERT(b.draws == 2);
+        CPPUNIT_ASSERT(d.draws == 1);
+
+        // adding and removing children
+        TestWindow e;
+        d.setEnabled(true);
+        d.addChild(&e);
+        a.render(all, 0);
+        CPPUNIT_ASSERT(d.draws == 2);
+        CPPUNIT_ASSERT(e.draws == 1);
+
+        b.removeChild(&d);
+        a.render(all, 0);
+        CPPUNIT_ASSERT(d.draws == 2);
+        CPPUNIT_ASSERT(e.draws == 1);
+
+        // changing the render passes
+        a.render(RENDER_PASS_3, 0);
+        CPPUNIT_ASSERT(c.draws == 5);
+        c.setRenderPasses(RENDER_PASS_1);
+        a.render(RENDER_PASS_3, 0);
+        CPPUNIT_ASSERT(c.draws == 5);
+    }
+
+    /**
+     * Tests that a window that renders its own children has its render()
+     * called.
+     */
+    void testRender_Own()
+    {
+        b.ownRender = true;
+        b.removeChild(&d);
+        b.addChild(&d);
+        a.render(RENDER_PASS_1 | RENDER_PASS_2 | RENDER_PASS_3, 0);
+
+        CPPUNIT_ASSERT(b.renders == 1);
+        CPPUNIT_ASSERT(b.draws == 1);
+        CPPUNIT_ASSERT(d.draws == 1);
+    }
+
+    /**
+     * Tests that a window with a parent that overrides render() without
+     * overriding rendersChildren() is only drawn, and its render() is never
+     * called, while the root's render() always is.
+     */
+    void testRender_Contract()
+    {
+        a.render(RENDER_PASS_1 | RENDER_PASS_2 | RENDER_PASS_3, 0);
+        a.render(RENDER_PASS_1 | RENDER_PASS_2 | RENDER_PASS_3, 0);
+
+        CPPUNIT_ASSERT(a.renders == 2);
+        CPPUNIT_ASSERT(b.renders == 0);
+        CPPUNIT_ASSERT(b.draws == 2);
+        CPPUNIT_ASSERT(c.renders == 0);
+        CPPUNIT_ASSERT(c.draws == 2);
+    }
 };
 
 void register_window()
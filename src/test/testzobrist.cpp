@@ -0,0 +1,172 @@
+/************************************************************************
+ *
+ * testzobrist.cpp
+ * Zobrist class tests
+ *
+ ************************************************************************/
+
+#include "zobrist.h"
+#include "maze.h"
+#include "hero.h"
+#include "item.h"
+
+#include "test.h"
+
+#include <cppunit/extensions/HelperMacros.h>
+
+/**
+ * This test suite contains one test case:
+ *
+ * Code: CT-Zob
+ * Name: Zobrist class unit tests
+ * Configuration: Unit testing context
+ * Tools: Cppunit
+ * Description: Class tests for the Zobrist class, and the hash the cells
+ *              and entities of a maze keep with it
+ */
+class testzobrist : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(testzobrist);
+    CPPUNIT_TEST(testKeys);
+    CPPUNIT_TEST(testLoad);
+    CPPUNIT_TEST(testWalls);
+    CPPUNIT_TEST(testPlayers);
+    CPPUNIT_TEST(testItems);
+    CPPUNIT_TEST_SUITE_END();
+
+private:
+    Maze m;
+
+    /**
+     * Returns the item on the cell at (i, j), or NULL if there is none.
+     */
+    Item *getItem(int i, int j)
+    {
+        Cell::EntityList entities = m.getCell(i, j)->getEntities();
+        for (Cell::EntityList::iterator e = entities.begin();
+             e != entities.end(); e++) {
+            Item *item = dynamic_cast<Item*>(*e);
+            if (item) {
+                return item;
+            }
+        }
+        return NULL;
+    }
+
+public:
+    void setUp()
+    {
+        m.load("test/testmaze.hag");
+    }
+
+    void testKeys()
+    {
+        // features that are not there have no key
+        CPPUNIT_ASSERT(Zobrist::wallKey(3, 4, 0) == 0);
+        CPPUNIT_ASSERT(Zobrist::turnKey(0) == 0);
+
+        // and different features have different keys
+        CPPUNIT_ASSERT(Zobrist::wallKey(3, 4, 1) != Zobrist::wallKey(3, 4, 2));
+        CPPUNIT_ASSERT(Zobrist::wallKey(3, 4, 1) != Zobrist::wallKey(4, 3, 1));
+        CPPUNIT_ASSERT(Zobrist::playerKey(Zobrist::HERO, 1, 1) !=
+                       Zobrist::playerKey(Zobrist::HAGGIS, 1, 1));
+        CPPUNIT_ASSERT(Zobrist::statKey(Zobrist::HERO, Zobrist::HEALTH, 5) !=
+                       Zobrist::statKey(Zobrist::HERO, Zobrist::ENERGY, 5));
+        CPPUNIT_ASSERT(Zobrist::itemKey(1, 3, 0) != Zobrist::itemKey(1, 3, 1));
+        CPPUNIT_ASSERT(Zobrist::turnKey(1) != 0);
+
+        // toggling a key twice leaves the hash as it was
+        Zobrist z;
+        z.toggle(Zobrist::itemKey(1, 3, 0));
+        CPPUNIT_ASSERT(z.getHash() != 0);
+        z.toggle(Zobrist::itemKey(1, 3, 0));
+        CPPUNIT_ASSERT(z.getHash() == 0);
+    }
+
+    void testLoad()
+    {
+        // the hash kept while loading is the hash of what was loaded
+        CPPUNIT_ASSERT(m.getHash() != 0);
+        CPPUNIT_ASSERT(m.getHash() == m.computeHash());
+
+        // and the same maze always has the same hash
+        Maze other;
+        other.load("test/testmaze.hag");
+        CPPUNIT_ASSERT(other.getHash() == m.getHash());
+    }
+
+    void testWalls()
+    {
+        uint64_t start = m.getHash();
+        Cell *c = m.getCell(0, 0);
+        int h = c->getWallHeight();
+
+        c->hitWall();
+        CPPUNIT_ASSERT(m.getHash() != start);
+        CPPUNIT_ASSERT(m.getHash() == m.computeHash());
+
+        c->setWallHeight(0);
+        CPPUNIT_ASSERT(m.getHash() == m.computeHash());
+
+        c->setWallHeight(h);
+        CPPUNIT_ASSERT(m.getHash() == start);
+    }
+
+    void testPlayers()
+    {
+        uint64_t start = m.getHash();
+        {
+            Hero hero;
+            hero.setCell(m.getHeroCell(), true);
+            uint64_t placed = m.getHash();
+            CPPUNIT_ASSERT(placed != start);
+            CPPUNIT_ASSERT(placed == m.computeHash());
+
+            // the statistics are part of the hash
+            hero.setHealth(3);
+            CPPUNIT_ASSERT(m.getHash() != placed);
+            CPPUNIT_ASSERT(m.getHash() == m.computeHash());
+            hero.setAmmo(0);
+            hero.setEnergy(7);
+            CPPUNIT_ASSERT(m.getHash() == m.computeHash());
+            hero.setHealth(hero.getMaxStat());
+            hero.setAmmo(hero.getMaxStat());
+            hero.setEnergy(hero.getMaxStat());
+            CPPUNIT_ASSERT(m.getHash() == placed);
+
+            // and so is the cell the player is on
+            hero.setCell(m.getCell(1, 6), true);
+            CPPUNIT_ASSERT(m.getHash() != placed);
+            CPPUNIT_ASSERT(m.getHash() == m.computeHash());
+            hero.setCell(m.getHeroCell(), true);
+            CPPUNIT_ASSERT(m.getHash() == placed);
+        }
+
+        // a player that is gone leaves the hash as it was
+        CPPUNIT_ASSERT(m.getHash() == start);
+    }
+
+    void testItems()
+    {
+        uint64_t start = m.getHash();
+        Item *item = getItem(1, 3);
+        CPPUNIT_ASSERT(item != NULL);
+
+        // a spent item is not in the hash
+        item->setSpent(true);
+        CPPUNIT_ASSERT(m.getHash() != start);
+        CPPUNIT_ASSERT(m.getHash() == m.computeHash());
+        item->setSpent(false);
+        CPPUNIT_ASSERT(m.getHash() == start);
+
+        // and the type of item is
+        item->setType(Item::TRAP);
+        CPPUNIT_ASSERT(m.getHash() != start);
+        CPPUNIT_ASSERT(m.getHash() == m.computeHash());
+    }
+};
+
+void register_zobrist()
+{
+    CPPUNIT_TEST_SUITE_REGISTRATION(testzobrist);
+}